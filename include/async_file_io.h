@@ -0,0 +1,204 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+/**
+ * @brief File I/O backend used by async_file_reader / async_file_writer
+ */
+enum class io_backend {
+    BLOCKING,  // pread/pwrite on the calling thread
+    IO_URING   // asynchronous requests through an io_uring instance
+};
+
+class io_uring_queue;
+
+/**
+ * @brief Check whether the kernel lets this process create an io_uring
+ * @return bool True if io_uring can be used
+ */
+[[nodiscard]] bool io_uring_available() noexcept;
+
+/**
+ * @brief Sequential file reader that keeps several block reads in flight
+ * With io_uring, up to queue_depth reads ahead of the consumer are queued so
+ * the device stays busy while the caller parses. Without io_uring (old
+ * kernel, seccomp, io_uring_disabled) it falls back to blocking pread.
+ */
+class async_file_reader {
+public:
+    static constexpr size_t DEFAULT_BLOCK_BYTES = 1 << 20;
+    static constexpr unsigned DEFAULT_QUEUE_DEPTH = 8;
+
+    async_file_reader() noexcept;
+    ~async_file_reader();
+
+    async_file_reader(const async_file_reader&) = delete;
+    async_file_reader& operator=(const async_file_reader&) = delete;
+
+    /**
+     * @brief Open a file and queue the first reads
+     * @param path File to read
+     * @param queue_depth Reads kept in flight (io_uring only)
+     * @param block_bytes Size of each read
+     * @param backend Preferred backend; IO_URING falls back to BLOCKING if unavailable
+     * @return bool True if the file could be opened
+     */
+    [[nodiscard]] bool open(const std::string& path, unsigned queue_depth = DEFAULT_QUEUE_DEPTH,
+                            size_t block_bytes = DEFAULT_BLOCK_BYTES,
+                            io_backend backend = io_backend::IO_URING);
+
+    /**
+     * @brief Get the next block in file order
+     * The previous contents of block are recycled as a read buffer.
+     * @param block Receives the block contents
+     * @return bool False at end of file or after an error
+     */
+    bool next_block(std::string& block);
+
+    /**
+     * @brief Check for read errors (meaningful after next_block() returned false)
+     * @return bool True if the whole file was read
+     */
+    [[nodiscard]] bool ok() const noexcept { return !m_failed; }
+
+    /**
+     * @brief Get the backend actually in use
+     * @return io_backend Active backend
+     */
+    [[nodiscard]] io_backend get_backend() const noexcept { return m_backend; }
+
+    /**
+     * @brief Wait for outstanding reads and close the file
+     */
+    void close() noexcept;
+
+private:
+    void submit_reads();
+
+    int m_fd = -1;
+    io_backend m_backend = io_backend::BLOCKING;
+    std::unique_ptr<io_uring_queue> m_queue;
+    size_t m_block_bytes = DEFAULT_BLOCK_BYTES;
+    size_t m_file_size = 0;
+    size_t m_next_submit = 0;   // next block index to request
+    size_t m_next_deliver = 0;  // next block index to hand out
+    std::vector<std::string> m_slots;
+    std::vector<long long> m_results;  // bytes read per slot, -1 while pending
+    bool m_failed = false;
+};
+
+/**
+ * @brief Sequential file writer sending full blocks as asynchronous writes
+ * Data is gathered into block buffers; every full block is submitted and the
+ * caller continues while it is written. At most queue_depth blocks are in
+ * flight. Falls back to blocking pwrite without io_uring.
+ */
+class async_file_writer {
+public:
+    static constexpr size_t DEFAULT_BLOCK_BYTES = 1 << 20;
+    static constexpr unsigned DEFAULT_QUEUE_DEPTH = 8;
+
+    async_file_writer() noexcept;
+    ~async_file_writer();
+
+    async_file_writer(const async_file_writer&) = delete;
+    async_file_writer& operator=(const async_file_writer&) = delete;
+
+    /**
+     * @brief Create (or truncate) a file for writing
+     * @param path File to write
+     * @param queue_depth Writes kept in flight (io_uring only)
+     * @param block_bytes Size of each write
+     * @param backend Preferred backend; IO_URING falls back to BLOCKING if unavailable
+     * @return bool True if the file could be created
+     */
+    [[nodiscard]] bool open(const std::string& path, unsigned queue_depth = DEFAULT_QUEUE_DEPTH,
+                            size_t block_bytes = DEFAULT_BLOCK_BYTES,
+                            io_backend backend = io_backend::IO_URING);
+
+    /**
+     * @brief Append bytes to the file
+     * @param data Bytes to write
+     * @param size Number of bytes
+     * @return bool False if an earlier write failed
+     */
+    bool write(const char* data, size_t size);
+
+    /**
+     * @brief Write the partial block, wait for all writes and close the file
+     * @return bool True if every byte was written
+     */
+    bool close() noexcept;
+
+    /**
+     * @brief Check whether a file is open
+     * @return bool True if open
+     */
+    [[nodiscard]] bool is_open() const noexcept { return m_fd >= 0; }
+
+    /**
+     * @brief Get the backend actually in use
+     * @return io_backend Active backend
+     */
+    [[nodiscard]] io_backend get_backend() const noexcept { return m_backend; }
+
+private:
+    void submit_current();
+    void reap(bool wait);
+    bool write_blocking(const char* data, size_t size, size_t offset) noexcept;
+
+    int m_fd = -1;
+    io_backend m_backend = io_backend::BLOCKING;
+    std::unique_ptr<io_uring_queue> m_queue;
+    size_t m_block_bytes = DEFAULT_BLOCK_BYTES;
+    size_t m_offset = 0;           // file offset of the current block
+    size_t m_current = 0;          // slot being filled
+    std::vector<std::string> m_slots;
+    std::vector<size_t> m_slot_offsets;
+    std::vector<char> m_in_flight;
+    size_t m_pending = 0;
+    bool m_failed = false;
+};
+
+/**
+ * @brief std::ostream adapter over async_file_writer
+ */
+class async_ofstream : public std::ostream {
+public:
+    /**
+     * @brief Open an output file
+     * @param path File to write
+     * @param queue_depth Writes kept in flight
+     * @param backend Preferred backend
+     */
+    explicit async_ofstream(const std::string& path,
+                            unsigned queue_depth = async_file_writer::DEFAULT_QUEUE_DEPTH,
+                            io_backend backend = io_backend::IO_URING);
+
+    /**
+     * @brief Wait for all writes and close the file
+     */
+    void close();
+
+    /**
+     * @brief Get the writer (e.g. to query the backend)
+     * @return const async_file_writer& Underlying writer
+     */
+    [[nodiscard]] const async_file_writer& writer() const noexcept { return m_buffer.writer; }
+
+private:
+    struct writer_streambuf : public std::streambuf {
+        async_file_writer writer;
+
+    protected:
+        int_type overflow(int_type ch) override;
+        std::streamsize xsputn(const char* data, std::streamsize count) override;
+    };
+
+    writer_streambuf m_buffer;
+};
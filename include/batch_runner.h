@@ -0,0 +1,167 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "pack_planner.h"
+
+/**
+ * @brief One input file of a batch and where its packs are written
+ */
+struct batch_job {
+    std::string input_path;
+    std::string output_path;
+    size_t input_bytes = 0;
+};
+
+/**
+ * @brief Outcome and timing of one batch job
+ */
+struct batch_job_result {
+    bool ok = false;
+    std::string error;               // why the job failed, or why pieces were left out
+    size_t items = 0;
+    size_t packs = 0;
+    std::int64_t unplaced_items = 0;  // input pieces the written plan does not hold
+    double start_time = 0.0;  // milliseconds after the batch started
+    double run_time = 0.0;    // milliseconds spent loading, planning and writing
+    unsigned int worker = 0;
+
+    /**
+     * @brief Get the time from batch start until this job finished
+     * @return double Completion latency in milliseconds
+     */
+    [[nodiscard]] double latency() const noexcept { return start_time + run_time; }
+};
+
+/**
+ * @brief Aggregate figures for a finished batch
+ */
+struct batch_summary {
+    size_t jobs = 0;
+    size_t failed = 0;
+    size_t items = 0;
+    size_t packs = 0;
+    std::int64_t unplaced_items = 0;
+    size_t input_bytes = 0;
+    double wall_time = 0.0;     // milliseconds
+    double run_time_p50 = 0.0;  // per-job run time percentiles, milliseconds
+    double run_time_p95 = 0.0;
+    double run_time_max = 0.0;
+    double latency_max = 0.0;   // completion time of the last job (the tail)
+
+    /**
+     * @brief Get aggregate job throughput
+     * @return double Jobs per second (0 if the batch took no measurable time)
+     */
+    [[nodiscard]] double jobs_per_second() const noexcept {
+        return wall_time > 0.0 ? jobs / (wall_time / 1000.0) : 0.0;
+    }
+
+    /**
+     * @brief Get aggregate input throughput
+     * @return double Input megabytes per second
+     */
+    [[nodiscard]] double megabytes_per_second() const noexcept {
+        return wall_time > 0.0 ? (input_bytes / (1024.0 * 1024.0)) / (wall_time / 1000.0) : 0.0;
+    }
+};
+
+/**
+ * @brief Plans many independent input files in one process
+ * Jobs are handed out largest input first (longest-processing-time order)
+ * from a shared counter to a fixed pool of workers, so big files start
+ * early and the batch does not end waiting on one late straggler. Each
+ * job is loaded, planned and written on its worker exactly like a single
+ * -i/-o run; inputs may be CSV, gzip-compressed CSV or binary item files.
+ */
+class batch_runner {
+public:
+    /**
+     * @brief Construct a new batch runner
+     * @param worker_count Number of concurrent jobs (0 = hardware concurrency)
+     */
+    explicit batch_runner(unsigned int worker_count = 0) noexcept;
+
+    /**
+     * @brief Build the job list from a directory or a list file
+     * A directory contributes every regular, non-hidden file in name order;
+     * any other path is read as a list with one input path per line (blank
+     * lines and lines starting with '#' are skipped). Each output is
+     * output_dir/<input file name>.txt, de-duplicated when names repeat.
+     * @param source Directory or list file
+     * @param output_dir Directory receiving the outputs (created if missing)
+     * @param jobs Output job list, cleared first
+     * @return bool False if the source could not be read or output_dir created
+     */
+    static bool collect_jobs(const std::string& source, const std::string& output_dir,
+                             std::vector<batch_job>& jobs);
+
+    /**
+     * @brief Order job indices largest input first (ties keep list order)
+     * @param jobs Jobs to schedule
+     * @return std::vector<size_t> Indices into jobs in dispatch order
+     */
+    [[nodiscard]] static std::vector<size_t> schedule(const std::vector<batch_job>& jobs);
+
+    /**
+     * @brief Run every job on the worker pool
+     * @param jobs Jobs to run
+     * @param config Planning configuration used for every job
+     * @return std::vector<batch_job_result> One result per job, in list order
+     */
+    std::vector<batch_job_result> run(const std::vector<batch_job>& jobs,
+                                      const pack_planner_config& config);
+
+    /**
+     * @brief Run a single job on the calling thread
+     * @param job Job to run
+     * @param config Planning configuration
+     * @return batch_job_result Outcome (start_time and worker are left at 0)
+     */
+    static batch_job_result run_job(const batch_job& job, const pack_planner_config& config);
+
+    /**
+     * @brief Aggregate the results of the last run
+     * @return batch_summary Counts, run-time percentiles and throughput
+     */
+    [[nodiscard]] batch_summary summarize(const std::vector<batch_job>& jobs,
+                                          const std::vector<batch_job_result>& results) const;
+
+    /**
+     * @brief Print a human-readable summary, listing failed jobs and jobs with unplaced pieces
+     * @param jobs Jobs of the last run
+     * @param results Results of the last run
+     * @param output Stream receiving the summary
+     */
+    void print_summary(const std::vector<batch_job>& jobs,
+                       const std::vector<batch_job_result>& results, std::ostream& output) const;
+
+    /**
+     * @brief Write one CSV row per job (input, output, bytes, items, packs, unplaced pieces,
+     * timings, status)
+     * @param jobs Jobs of the last run
+     * @param results Results of the last run
+     * @param output Stream receiving the report
+     */
+    static void write_report(const std::vector<batch_job>& jobs,
+                             const std::vector<batch_job_result>& results, std::ostream& output);
+
+    /**
+     * @brief Get wall time of the last run call in milliseconds
+     * @return double Elapsed time for the whole batch
+     */
+    [[nodiscard]] double get_total_time() const noexcept { return m_total_time; }
+
+    /**
+     * @brief Get the number of workers used by the last run call
+     * @return unsigned int Worker count (never more than the job count)
+     */
+    [[nodiscard]] unsigned int get_workers_used() const noexcept { return m_workers_used; }
+
+private:
+    unsigned int m_worker_count;
+    unsigned int m_workers_used = 0;
+    double m_total_time = 0.0;
+};
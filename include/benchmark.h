@@ -45,6 +45,43 @@ public:
     static void benchmark_single_threaded_sorts();
     static void benchmark_multi_threaded_sorts();
 
+    /**
+     * @brief Benchmark CSV item parsers (istringstream, from_chars, structural scanner)
+     * @param line_count Number of item lines to generate
+     */
+    static void benchmark_parsers(int line_count = 5000000);
+
+    /**
+     * @brief Benchmark plan construction and teardown: global allocator vs. pmr arena
+     * Allocations are counted with a forwarding std::pmr::memory_resource.
+     * @param item_count Number of items to plan
+     * @param repetitions Plans built and freed per variant
+     */
+    static void benchmark_plan_allocations(int item_count = 1000000, int repetitions = 5);
+
+    /**
+     * @brief Benchmark the sequential first-fit loop into each plan type
+     * Times pack_sequential alone (no sorting or result statistics), so
+     * changes to per-row or per-placement work show up directly.
+     * @param item_count Number of items to pack
+     * @param repetitions Runs per plan type
+     */
+    static void benchmark_packing_loop(int item_count = 1000000, int repetitions = 10);
+
+#ifndef __EMSCRIPTEN__
+    /**
+     * @brief Benchmark startup cost: CSV ingest vs. mapped binary item file
+     * @param item_count Number of items to generate (defaults to the largest BENCHMARK_SIZES entry)
+     */
+    static void benchmark_item_load(int item_count = 20000000);
+
+    /**
+     * @brief Benchmark sequential file reads/writes: streams, blocking pread/pwrite, io_uring
+     * @param megabytes Size of the test file
+     */
+    static void benchmark_file_io(int megabytes = 1024);
+#endif
+
 private:
     pack_planner m_planner;
     timer m_total_timer;
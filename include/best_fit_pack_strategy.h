@@ -0,0 +1,140 @@
+#pragma once
+
+#include <memory_resource>
+#include <set>
+#include <utility>
+#include <vector>
+#include "pack_strategy.h"
+
+/**
+ * @brief Best-fit pack strategy
+ * Every run of pieces goes into the pack with the least remaining weight
+ * that still takes at least one piece (ties go to the lower pack number);
+ * the run is split across packs exactly as pack::add_partial_item splits
+ * it. Packs that can still take something are kept in an ordered index
+ * keyed by remaining weight, so each placement is one O(log P) lookup.
+ * Only vector plans are filled directly, as for first-fit.
+ */
+class best_fit_pack_strategy : public pack_strategy {
+public:
+    using pack_strategy::pack_items;
+
+    /**
+     * @brief Pack items best-fit
+     * @param items Items to pack, stored column-wise
+     * @param max_items Maximum items per pack
+     * @param max_weight Maximum weight per pack
+     * @return std::vector<pack> Vector of packs
+     */
+    std::vector<pack> pack_items(const item_column_view& items,
+                                 int max_items,
+                                 double max_weight) override {
+        std::vector<pack> packs;
+        with_weight_policy([&](auto weights) {
+            pack_best_fit(items, max_items, max_weight, packs, weights, get_memory_resource());
+        });
+        return packs;
+    }
+
+    std::string get_name() const override {
+        return "Best-Fit";
+    }
+
+    /**
+     * @brief The best-fit packing loop
+     * @param items Items to pack, stored column-wise
+     * @param max_items Maximum items per pack
+     * @param max_weight Maximum weight per pack
+     * @param packs Receives the packs
+     * @param weights Weight policy tag (floating_weights or fixed_weights)
+     * @param resource Memory resource for the packs' item lists
+     */
+    template <typename Weights = floating_weights>
+    static void pack_best_fit(const item_column_view& items,
+                              int max_items,
+                              double max_weight,
+                              std::vector<pack>& packs,
+                              Weights = {},
+                              std::pmr::memory_resource* resource = std::pmr::get_default_resource()) {
+        using capacity = typename Weights::value_type;
+
+        // SAFETY: Validate constraints to prevent infinite loops
+        max_items = std::max(1, max_items);
+        max_weight = std::max(0.1, max_weight);
+        const auto weight_limit = Weights::convert(max_weight);
+
+        // A pack with less room than the lightest piece can never take another
+        // one, so it leaves the index for good
+        capacity lightest = weight_limit;
+        for (size_t i = 0; i < items.size(); ++i) {
+            const size_t row = items.row(i);
+            const auto weight = Weights::convert(items.weights[row]);
+            if (items.quantities[row] > 0 && !(weight > weight_limit)) {
+                lightest = std::min(lightest, std::max<capacity>(0, weight));
+            }
+        }
+
+        // (remaining weight, pack index); the tree nodes come from a local pool
+        std::pmr::unsynchronized_pool_resource pool;
+        std::pmr::set<std::pair<capacity, size_t>> open(&pool);
+        auto track = [&](size_t k) {
+            const capacity room = Weights::remaining_weight(packs[k], weight_limit);
+            if (packs[k].get_total_items() < max_items && room >= lightest) {
+                open.emplace(room, k);
+            }
+        };
+
+        std::int64_t pack_number = 1;
+        start_pack(packs, pack_number, resource);
+        track(0);
+        auto open_next = [&] {
+            start_pack(packs, ++pack_number, resource);
+        };
+
+        for (size_t i = 0; i < items.size(); ++i) {
+            const size_t row = items.row(i);
+
+            // SAFETY: Skip items with non-positive quantities, and pieces no pack can hold
+            if (items.quantities[row] <= 0) continue;
+            const auto weight = Weights::convert(items.weights[row]);
+            if (weight > weight_limit) continue;
+
+            // Packs clamp negative (and NaN) weights to zero; look up with the same value
+            const capacity needed = std::max<capacity>(0, weight);
+            std::int64_t remaining_quantity = items.quantities[row];
+
+            while (remaining_quantity > 0) {
+                size_t slot;
+                const auto tightest = open.lower_bound({needed, 0});
+                if (tightest == open.end()) {
+                    open_next();
+                    slot = packs.size() - 1;
+
+                    // A run spanning several new packs fills them in one step
+                    const std::int64_t placed = place_full_packs<Weights>(packs, open_next,
+                        items.ids[row], items.lengths[row], remaining_quantity,
+                        weight, max_items, weight_limit);
+                    if (placed > 0) {
+                        for (size_t k = slot; k < packs.size(); ++k) {
+                            track(k);
+                        }
+                        remaining_quantity -= placed;
+                        continue;
+                    }
+                } else {
+                    slot = tightest->second;
+                    open.erase(tightest);
+                }
+
+                const std::int64_t added = Weights::add_partial_item(packs[slot],
+                    items.ids[row], items.lengths[row], remaining_quantity,
+                    weight, max_items, weight_limit);
+                track(slot);
+
+                // An empty pack that rejects the item (e.g. NaN weight) would loop forever
+                if (added <= 0) break;
+                remaining_quantity -= added;
+            }
+        }
+    }
+};
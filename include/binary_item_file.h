@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "item.h"
+#include "item_column_view.h"
+#include "mapped_file.h"
+
+/**
+ * @brief On-disk header of a binary item file (64 bytes)
+ * Layout: header, then the id, length, quantity and weight columns, each
+ * starting on a 64-byte boundary. Quantities are 64-bit; all values are
+ * in native byte order.
+ */
+struct binary_item_header {
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+    uint64_t count;
+    uint64_t id_offset;
+    uint64_t length_offset;
+    uint64_t quantity_offset;
+    uint64_t weight_offset;
+    uint64_t checksum;  // over all column bytes, 0 unless FLAG_CHECKSUM is set
+};
+
+static_assert(sizeof(binary_item_header) == 64, "binary item header must stay 64 bytes");
+
+/**
+ * @brief Columnar binary item container with zero-copy memory-mapped loading
+ * Converting a CSV once with write() lets later runs open() the file and
+ * hand its columns to the planner without parsing or per-row allocation.
+ */
+class binary_item_file {
+public:
+    static constexpr char MAGIC[8] = {'P', 'P', 'I', 'T', 'E', 'M', 'S', '\0'};
+    static constexpr uint32_t VERSION = 1;
+    static constexpr uint32_t FLAG_CHECKSUM = 1u << 0;
+    static constexpr size_t COLUMN_ALIGNMENT = 64;
+
+    binary_item_file() noexcept = default;
+
+    /**
+     * @brief Write items to a binary item file
+     * @param path File to create (truncated if it exists)
+     * @param items Items to store, in order
+     * @param with_checksum Store a checksum over the column data
+     * @return bool True if the file was written
+     */
+    static bool write(const std::string& path, const std::vector<item>& items,
+                      bool with_checksum = true);
+
+    /**
+     * @brief Map a binary item file and validate its header
+     * @param path File to open
+     * @param verify_checksum Also verify the stored checksum (reads every page)
+     * @return bool True if the file is a valid binary item file
+     */
+    [[nodiscard]] bool open(const std::string& path, bool verify_checksum = false);
+
+    /**
+     * @brief Unmap the file; views obtained from columns() become invalid
+     */
+    void close() noexcept;
+
+    /**
+     * @brief Get the mapped columns
+     * @return item_column_view View valid until close() or destruction
+     */
+    [[nodiscard]] item_column_view columns() const noexcept { return m_columns; }
+
+    /**
+     * @brief Get the number of stored items
+     * @return size_t Item count
+     */
+    [[nodiscard]] size_t size() const noexcept { return m_columns.count; }
+
+    /**
+     * @brief Check whether the file carries a checksum
+     * @return bool True if FLAG_CHECKSUM is set
+     */
+    [[nodiscard]] bool has_checksum() const noexcept { return m_has_checksum; }
+
+    /**
+     * @brief Check whether a file starts with the binary item magic
+     * @param path File to inspect
+     * @return bool True if the first bytes match MAGIC
+     */
+    [[nodiscard]] static bool is_binary_item_file(const std::string& path);
+
+    /**
+     * @brief FNV-1a style checksum over 64-bit words (tail bytes folded in singly)
+     * @param data Start of the data
+     * @param size Size in bytes
+     * @return uint64_t Checksum
+     */
+    [[nodiscard]] static uint64_t checksum(const void* data, size_t size) noexcept;
+
+    /**
+     * @brief Compute the column layout for a given item count
+     * @param count Number of items
+     * @param header Header whose offset fields are filled in
+     * @return size_t Total file size in bytes
+     */
+    static size_t layout(uint64_t count, binary_item_header& header) noexcept;
+
+private:
+    mapped_file m_file;
+    item_column_view m_columns;
+    bool m_has_checksum = false;
+};
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+#include "mapped_file.h"
+#include "pack.h"
+#include "pack_planner.h"
+#include "plan_arena.h"
+
+/**
+ * @brief On-disk header of a binary plan file (64 bytes)
+ * Layout: header, pack table (pack_count records), placement table
+ * (placement_count records). Each table starts on a 64-byte boundary and
+ * all values are in native byte order.
+ */
+struct binary_plan_header {
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+    uint64_t pack_count;
+    uint64_t placement_count;
+    uint64_t pack_offset;
+    uint64_t placement_offset;
+    uint64_t total_items;
+    uint64_t reserved;
+};
+
+/**
+ * @brief One pack; its placements are [first_placement, first_placement + placement_count)
+ */
+struct plan_pack_record {
+    int64_t pack_number;
+    int64_t total_items;
+    double total_weight;  // exact, not rounded like the text output
+    int64_t max_length;
+    uint64_t first_placement;
+    uint64_t placement_count;
+};
+
+/**
+ * @brief One item (or part of an item) placed into a pack
+ */
+struct plan_placement_record {
+    int64_t item_id;
+    int64_t quantity;
+};
+
+static_assert(sizeof(binary_plan_header) == 64, "binary plan header must stay 64 bytes");
+static_assert(sizeof(plan_pack_record) == 48, "plan pack record layout changed");
+static_assert(sizeof(plan_placement_record) == 16, "plan placement record layout changed");
+
+/**
+ * @brief Binary pack-plan container for downstream systems
+ * Written next to (or instead of) the text output; readers map the file and
+ * index the two tables directly, with no parsing and no rounding loss.
+ */
+class binary_plan_file {
+public:
+    static constexpr char MAGIC[8] = {'P', 'P', 'P', 'L', 'A', 'N', '\0', '\0'};
+    static constexpr uint32_t VERSION = 1;
+    static constexpr size_t TABLE_ALIGNMENT = 64;
+
+    binary_plan_file() noexcept = default;
+
+    /**
+     * @brief Write the non-empty packs of a plan
+     * @param path File to create (truncated if it exists)
+     * @param packs Packs to store, in order
+     * @return bool True if the file was written
+     */
+    static bool write(const std::string& path, const std::vector<pack>& packs);
+
+    /**
+     * @brief Write the non-empty packs of a plan held in an arena
+     * @param path File to create (truncated if it exists)
+     * @param packs Packs to store, in order
+     * @return bool True if the file was written
+     */
+    static bool write(const std::string& path, const plan_arena& packs);
+
+    /**
+     * @brief Write the packs of a planning result
+     * @param path File to create (truncated if it exists)
+     * @param result Planning result
+     * @return bool True if the file was written
+     */
+    static bool write(const std::string& path, const pack_planner_result& result) {
+        return write(path, result.packs);
+    }
+
+    /**
+     * @brief Map a binary plan file and validate its header
+     * @param path File to open
+     * @return bool True if the file is a valid binary plan file
+     */
+    [[nodiscard]] bool open(const std::string& path);
+
+    /**
+     * @brief Unmap the file; spans obtained from the reader become invalid
+     */
+    void close() noexcept;
+
+    /**
+     * @brief Get the pack table
+     * @return std::span<const plan_pack_record> All packs in plan order
+     */
+    [[nodiscard]] std::span<const plan_pack_record> packs() const noexcept {
+        return {m_packs, m_pack_count};
+    }
+
+    /**
+     * @brief Get the whole placement table
+     * @return std::span<const plan_placement_record> All placements in plan order
+     */
+    [[nodiscard]] std::span<const plan_placement_record> placements() const noexcept {
+        return {m_placements, m_placement_count};
+    }
+
+    /**
+     * @brief Get the placements of one pack
+     * @param pack_index Index into packs() (must be < packs().size())
+     * @return std::span<const plan_placement_record> Placements of that pack
+     */
+    [[nodiscard]] std::span<const plan_placement_record> placements_of(size_t pack_index) const noexcept {
+        const plan_pack_record& record = m_packs[pack_index];
+        return {m_placements + record.first_placement, static_cast<size_t>(record.placement_count)};
+    }
+
+    /**
+     * @brief Get the total number of pieces across all packs
+     * @return uint64_t Total pieces
+     */
+    [[nodiscard]] uint64_t get_total_items() const noexcept { return m_total_items; }
+
+    /**
+     * @brief Compute the table layout for given record counts
+     * @param pack_count Number of pack records
+     * @param placement_count Number of placement records
+     * @param header Header whose offset fields are filled in
+     * @return size_t Total file size in bytes
+     */
+    static size_t layout(uint64_t pack_count, uint64_t placement_count,
+                         binary_plan_header& header) noexcept;
+
+private:
+    mapped_file m_file;
+    const plan_pack_record* m_packs = nullptr;
+    const plan_placement_record* m_placements = nullptr;
+    size_t m_pack_count = 0;
+    size_t m_placement_count = 0;
+    uint64_t m_total_items = 0;
+};
@@ -4,54 +4,107 @@
 
 class next_fit_pack_strategy : public pack_strategy {
 public:
-    std::vector<pack> pack_items(const std::vector<item>& items,
+    using pack_strategy::pack_items;
+
+    std::vector<pack> pack_items(const item_column_view& items,
                                  int max_items,
                                  double max_weight) override {
+        std::vector<pack> packs;
+        with_weight_policy([&](auto weights) {
+            pack_next_fit(items, max_items, max_weight, packs, weights, get_memory_resource());
+        });
+        return packs;
+    }
+
+    void pack_items(const item_column_view& items,
+                    int max_items,
+                    double max_weight,
+                    plan_arena& out) override {
+        with_weight_policy([&](auto weights) {
+            pack_next_fit(items, max_items, max_weight, out, weights, get_memory_resource());
+        });
+    }
+
+    bool pack_items(const item_column_view& items,
+                    int max_items,
+                    double max_weight,
+                    range_plan& out) override {
+        out.set_weight_limit(max_weight, get_weight_mode());
+        with_weight_policy([&](auto weights) {
+            pack_next_fit(items, max_items, max_weight, out, weights, get_memory_resource());
+        });
+        return true;
+    }
+
+    std::string get_name() const override {
+        return "Next-Fit";
+    }
+
+private:
+    // Plan is std::vector<pack>, plan_arena or range_plan;
+    // Weights is floating_weights or fixed_weights
+    template <typename Plan, typename Weights>
+    static void pack_next_fit(const item_column_view& items,
+                              int max_items,
+                              double max_weight,
+                              Plan& packs,
+                              Weights,
+                              std::pmr::memory_resource* resource) {
         // Validate constraints
         max_items = std::max(1, max_items);
         max_weight = std::max(0.1, max_weight);
+        const auto weight_limit = Weights::convert(max_weight);
 
-        std::vector<pack> packs;
-        const size_t max_safe_reserve = std::min<size_t>(100000, items.size() / 10 + 1000);
-        packs.reserve(max_safe_reserve);
-        int pack_number = 1;
-        packs.emplace_back(pack_number);
+        reserve_plan(packs, items, 0, items.size(), max_items, max_weight);
+
+        std::int64_t pack_number = 1;
+        start_pack(packs, pack_number, resource);
+        auto open_next = [&] {
+            start_pack(packs, ++pack_number, resource);
+        };
 
-        for (const auto& item : items) {
-            if (item.get_quantity() <= 0) continue;
+        for (size_t i = 0; i < items.size(); ++i) {
+            const size_t row = items.row(i);
+            if (items.quantities[row] <= 0) continue;
+            visit_row(packs, i, items.quantities[row]);
 
-            int remaining_quantity = item.get_quantity();
+            const auto weight = Weights::convert(items.weights[row]);
+            std::int64_t remaining_quantity = items.quantities[row];
 
             while (remaining_quantity > 0) {
                 // Only check the current (last) pack
-                pack& current_pack = packs.back();
+                auto&& current_pack = packs.back();
+                if (current_pack.is_empty()) {
+                    // A run spanning several packs fills them in one step
+                    const std::int64_t placed = place_full_packs<Weights>(packs, open_next,
+                        items.ids[row], items.lengths[row], remaining_quantity,
+                        weight, max_items, weight_limit);
+                    if (placed > 0) {
+                        remaining_quantity -= placed;
+                        continue;
+                    }
+                }
 
-                int added = current_pack.add_partial_item(
-                    item.get_id(), item.get_length(), remaining_quantity,
-                    item.get_weight(), max_items, max_weight);
+                std::int64_t added = Weights::add_partial_item(current_pack,
+                    items.ids[row], items.lengths[row], remaining_quantity,
+                    weight, max_items, weight_limit);
 
                 if (added > 0) {
                     remaining_quantity -= added;
                 } else {
                     // Current pack is full, create new one
-                    if (item.get_weight() > max_weight) {
+                    if (weight > weight_limit) {
                         // Item too heavy
                         break;
                     }
 
-                    if (packs.size() >= max_safe_reserve) {
+                    // An empty pack that rejects the item (e.g. NaN weight) would loop forever
+                    if (current_pack.is_empty()) {
                         break;
                     }
-
-                    packs.emplace_back(++pack_number);
+                    open_next();
                 }
             }
         }
-
-        return packs;
-    }
-
-    std::string get_name() const override {
-        return "Next-Fit";
     }
 };
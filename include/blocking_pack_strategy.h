@@ -8,81 +8,137 @@
  */
 class blocking_pack_strategy : public pack_strategy {
 public:
+    using pack_strategy::pack_items;
+
     /**
      * @brief Pack items into packs sequentially
-     * @param items Items to pack
+     * @param items Items to pack, stored column-wise
      * @param max_items Maximum items per pack
      * @param max_weight Maximum weight per pack
      * @return std::vector<pack> Vector of packs
      */
-    std::vector<pack> pack_items(const std::vector<item>& items,
+    std::vector<pack> pack_items(const item_column_view& items,
                             int max_items,
                             double max_weight) override {
+        std::vector<pack> packs;
+        with_weight_policy([&](auto weights) {
+            pack_sequential(items, max_items, max_weight, packs, weights, get_memory_resource());
+        });
+        return packs;
+    }
+
+    /**
+     * @brief Pack items sequentially, appending the packs to a plan arena
+     * @param items Items to pack, stored column-wise
+     * @param max_items Maximum items per pack
+     * @param max_weight Maximum weight per pack
+     * @param out Arena receiving the packs
+     */
+    void pack_items(const item_column_view& items,
+                    int max_items,
+                    double max_weight,
+                    plan_arena& out) override {
+        with_weight_policy([&](auto weights) {
+            pack_sequential(items, max_items, max_weight, out, weights, get_memory_resource());
+        });
+    }
+
+    /**
+     * @brief Pack items sequentially into a range plan
+     * @param items Items to pack, stored column-wise
+     * @param max_items Maximum items per pack
+     * @param max_weight Maximum weight per pack
+     * @param out Range plan receiving the packs
+     * @return bool Always true
+     */
+    bool pack_items(const item_column_view& items,
+                    int max_items,
+                    double max_weight,
+                    range_plan& out) override {
+        out.set_weight_limit(max_weight, get_weight_mode());
+        with_weight_policy([&](auto weights) {
+            pack_sequential(items, max_items, max_weight, out, weights, get_memory_resource());
+        });
+        return true;
+    }
+
+    std::string get_name() const override {
+        return "Blocking";
+    }
+
+    /**
+     * @brief The sequential packing loop, shared with the parallel strategies
+     * Plan is std::vector<pack>, plan_arena or range_plan; only the last
+     * pack is filled. The plan is reserved up front from an O(n) estimate
+     * (see reserve_plan). There is no limit on packs or pieces.
+     * @param items Items to pack, stored column-wise
+     * @param max_items Maximum items per pack
+     * @param max_weight Maximum weight per pack
+     * @param packs Receives the packs
+     * @param weights Weight policy tag (floating_weights or fixed_weights)
+     * @param resource Memory resource for the item lists of vector plans
+     */
+    template <typename Plan, typename Weights = floating_weights>
+    static void pack_sequential(const item_column_view& items,
+                                int max_items,
+                                double max_weight,
+                                Plan& packs,
+                                Weights = {},
+                                std::pmr::memory_resource* resource = std::pmr::get_default_resource()) {
         // SAFETY: Validate constraints to prevent infinite loops
         max_items = std::max(1, max_items);
         max_weight = std::max(0.1, max_weight);
+        const auto weight_limit = Weights::convert(max_weight);
 
-        std::vector<pack> packs;
-        // Pre-allocate based on empirical ratio to avoid reallocations
-        // SAFETY: Limit initial allocation to prevent OOM with extreme values
-        const size_t max_safe_reserve = std::min<size_t>(100000, items.size() / 10 + 1000);
-        packs.reserve(std::min(max_safe_reserve,
-                    std::max<size_t>(64, static_cast<size_t>(items.size() * 0.00222) + 16)));
-        int pack_number = 1;
-        packs.emplace_back(pack_number);
+        reserve_plan(packs, items, 0, items.size(), max_items, max_weight);
 
-        // SAFETY: Add a safety counter to prevent infinite loops
-        const int max_iterations = 1000000; // Reasonable upper limit
-        int safety_counter = 0;
+        std::int64_t pack_number = 1;
+        start_pack(packs, pack_number, resource);
+        auto open_next = [&] {
+            start_pack(packs, ++pack_number, resource);
+        };
+
+        for (size_t i = 0; i < items.size(); ++i) {
+            const size_t row = items.row(i);
 
-        for (const auto& item : items) {
             // SAFETY: Skip items with non-positive quantities
-            if (item.get_quantity() <= 0) continue;
+            if (items.quantities[row] <= 0) continue;
+            visit_row(packs, i, items.quantities[row]);
 
-            int remaining_quantity = item.get_quantity();
+            const auto weight = Weights::convert(items.weights[row]);
+            std::int64_t remaining_quantity = items.quantities[row];
 
             while (remaining_quantity > 0) {
-                // SAFETY: Check for potential infinite loop
-                if (++safety_counter > max_iterations) {
-                    // Force exit the loop if we've exceeded reasonable iterations
-                    break;
+                auto&& current_pack = packs.back();
+                if (current_pack.is_empty()) {
+                    // A run spanning several packs fills them in one step
+                    const std::int64_t placed = place_full_packs<Weights>(packs, open_next,
+                        items.ids[row], items.lengths[row], remaining_quantity,
+                        weight, max_items, weight_limit);
+                    if (placed > 0) {
+                        remaining_quantity -= placed;
+                        continue;
+                    }
                 }
-
-                pack& current_pack = packs.back();
-                int added_quantity = current_pack.add_partial_item(
-                    item.get_id(), item.get_length(), remaining_quantity,
-                    item.get_weight(), max_items, max_weight);
+                std::int64_t added_quantity = Weights::add_partial_item(current_pack,
+                    items.ids[row], items.lengths[row], remaining_quantity,
+                    weight, max_items, weight_limit);
 
                 if (added_quantity > 0) {
                     remaining_quantity -= added_quantity;
                 } else {
                     // Check if this item can never fit (weight exceeds max_weight)
-                    if (item.get_weight() > max_weight) {
+                    if (weight > weight_limit) {
                         // Item is too heavy to fit in any pack, skip it
-                        remaining_quantity = 0;
                         break;
                     }
                     // Fallback: If pack is empty but item should fit, something else is wrong
                     if (current_pack.is_empty()) {
-                        remaining_quantity = 0;
-                        break;
-                    }
-                    
-                    // SAFETY: Limit maximum number of packs to prevent OOM
-                    if (packs.size() >= max_safe_reserve) {
-                        // Force exit if we've created too many packs
-                        remaining_quantity = 0;
                         break;
                     }
-                    packs.emplace_back(++pack_number);
+                    open_next();
                 }
             }
         }
-
-        return packs;
-    }
-
-    std::string get_name() const override {
-        return "Blocking";
     }
 };
@@ -0,0 +1,201 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "pack_strategy.h"
+
+/**
+ * @brief Best-fit over at most K open packs (bounded space)
+ * Only K packs stay open. Each run of pieces goes into the open pack with
+ * the least remaining weight that still takes one piece; when none does,
+ * the fullest open pack is closed for good and a new one takes its lane.
+ * The remaining weights live in one aligned array, so the choice is a
+ * single compare/min pass over all K lanes (four per step on AVX2 CPUs) and
+ * the cost per placement does not grow with the number of packs. Ties go
+ * to the lower lane. Only vector plans are filled directly.
+ */
+class bounded_best_fit_pack_strategy : public pack_strategy {
+public:
+    using pack_strategy::pack_items;
+
+    static constexpr int DEFAULT_OPEN_PACKS = 16;
+    static constexpr int MAX_OPEN_PACKS = 64;
+
+    /**
+     * @brief Constructor
+     * @param open_packs Number of packs kept open (clamped to [1, MAX_OPEN_PACKS])
+     */
+    explicit bounded_best_fit_pack_strategy(int open_packs = DEFAULT_OPEN_PACKS) noexcept
+        : m_open_packs(std::clamp(open_packs, 1, MAX_OPEN_PACKS)) {}
+
+    /**
+     * @brief Pack items best-fit over the open packs
+     * @param items Items to pack, stored column-wise
+     * @param max_items Maximum items per pack
+     * @param max_weight Maximum weight per pack
+     * @return std::vector<pack> Vector of packs
+     */
+    std::vector<pack> pack_items(const item_column_view& items,
+                                 int max_items,
+                                 double max_weight) override {
+        std::vector<pack> packs;
+        with_weight_policy([&](auto weights) {
+            pack_bounded_best_fit(items, max_items, max_weight, m_open_packs, packs, weights,
+                                  get_memory_resource());
+        });
+        return packs;
+    }
+
+    std::string get_name() const override {
+        return "Bounded Best-Fit";
+    }
+
+    /**
+     * @brief Get the number of packs kept open
+     * @return int K
+     */
+    [[nodiscard]] int get_open_packs() const noexcept { return m_open_packs; }
+
+    /**
+     * @brief Find the lane with the least room that is at least needed
+     * Runs the AVX2 scan on CPUs that have it, the scalar scan otherwise.
+     * @param room Remaining room per lane; 32-byte aligned, lanes a multiple of 4
+     * @param lanes Number of lanes to scan
+     * @param needed Room required
+     * @return int Lane index, or -1 if no lane has room
+     */
+    [[nodiscard]] static int find_best(const double* room, size_t lanes, double needed) noexcept;
+    [[nodiscard]] static int find_best(const std::int64_t* room, size_t lanes, std::int64_t needed) noexcept;
+
+    /**
+     * @brief Portable lane scan
+     */
+    template <typename T>
+    [[nodiscard]] static int find_best_scalar(const T* room, size_t lanes, T needed) noexcept {
+        int best = -1;
+        for (size_t lane = 0; lane < lanes; ++lane) {
+            if (room[lane] >= needed && (best < 0 || room[lane] < room[best])) {
+                best = static_cast<int>(lane);
+            }
+        }
+        return best;
+    }
+
+    /**
+     * @brief AVX2 lane scan: masked min, then the first lane equal to it
+     * Call only when cpu_has_avx2(); builds without x86 dispatch run the
+     * scalar scan instead. The fixed-point overload emulates the 64-bit min
+     * with compare and blend.
+     */
+    [[nodiscard]] static int find_best_avx2(const double* room, size_t lanes, double needed) noexcept;
+    [[nodiscard]] static int find_best_avx2(const std::int64_t* room, size_t lanes,
+                                            std::int64_t needed) noexcept;
+
+    /**
+     * @brief The bounded best-fit packing loop
+     * @param items Items to pack, stored column-wise
+     * @param max_items Maximum items per pack
+     * @param max_weight Maximum weight per pack
+     * @param open_packs Number of packs kept open (K)
+     * @param packs Receives the packs
+     * @param weights Weight policy tag (floating_weights or fixed_weights)
+     * @param resource Memory resource for the packs' item lists
+     */
+    template <typename Weights = floating_weights>
+    static void pack_bounded_best_fit(const item_column_view& items,
+                                      int max_items,
+                                      double max_weight,
+                                      int open_packs,
+                                      std::vector<pack>& packs,
+                                      Weights = {},
+                                      std::pmr::memory_resource* resource = std::pmr::get_default_resource()) {
+        using capacity = typename Weights::value_type;
+        // A lane that can take nothing: closed, unused, or out of item slots
+        constexpr capacity NONE = std::numeric_limits<capacity>::lowest();
+
+        // SAFETY: Validate constraints to prevent infinite loops
+        max_items = std::max(1, max_items);
+        max_weight = std::max(0.1, max_weight);
+        open_packs = std::clamp(open_packs, 1, MAX_OPEN_PACKS);
+        const auto weight_limit = Weights::convert(max_weight);
+
+        // Lanes are scanned four at a time; the padding lanes stay NONE
+        const size_t lanes = (static_cast<size_t>(open_packs) + 3) / 4 * 4;
+        alignas(32) std::array<capacity, MAX_OPEN_PACKS> room;
+        std::array<size_t, MAX_OPEN_PACKS> pack_of;
+        room.fill(NONE);
+        size_t used = 0;
+        size_t newest = 0;  // lane of the most recently opened pack
+
+        auto refresh = [&](size_t lane) {
+            const pack& p = packs[pack_of[lane]];
+            room[lane] = p.get_total_items() < max_items ? Weights::remaining_weight(p, weight_limit) : NONE;
+        };
+        std::int64_t pack_number = 0;
+        auto open_next = [&] {
+            // The newest pack may have been filled since it opened (place_full_packs)
+            if (used > 0) refresh(newest);
+            size_t lane = used;
+            if (used == static_cast<size_t>(open_packs)) {
+                // Close the fullest pack
+                lane = 0;
+                for (size_t l = 1; l < used; ++l) {
+                    if (room[l] < room[lane]) lane = l;
+                }
+            } else {
+                ++used;
+            }
+            start_pack(packs, ++pack_number, resource);
+            pack_of[lane] = packs.size() - 1;
+            room[lane] = weight_limit;
+            newest = lane;
+        };
+        open_next();
+
+        for (size_t i = 0; i < items.size(); ++i) {
+            const size_t row = items.row(i);
+
+            // SAFETY: Skip items with non-positive quantities, and pieces no pack can hold
+            if (items.quantities[row] <= 0) continue;
+            const auto weight = Weights::convert(items.weights[row]);
+            if (weight > weight_limit) continue;
+
+            // Packs clamp negative (and NaN) weights to zero; look up with the same value
+            const capacity needed = std::max<capacity>(0, weight);
+            std::int64_t remaining_quantity = items.quantities[row];
+
+            while (remaining_quantity > 0) {
+                int lane = find_best(room.data(), lanes, needed);
+                if (lane < 0) {
+                    open_next();
+                    lane = static_cast<int>(newest);
+
+                    // A run spanning several new packs fills them in one step
+                    const std::int64_t placed = place_full_packs<Weights>(packs, open_next,
+                        items.ids[row], items.lengths[row], remaining_quantity,
+                        weight, max_items, weight_limit);
+                    if (placed > 0) {
+                        refresh(newest);
+                        remaining_quantity -= placed;
+                        continue;
+                    }
+                }
+
+                const std::int64_t added = Weights::add_partial_item(packs[pack_of[lane]],
+                    items.ids[row], items.lengths[row], remaining_quantity,
+                    weight, max_items, weight_limit);
+                refresh(static_cast<size_t>(lane));
+
+                // An empty pack that rejects the item (e.g. NaN weight) would loop forever
+                if (added <= 0) break;
+                remaining_quantity -= added;
+            }
+        }
+    }
+
+private:
+    int m_open_packs;
+};
@@ -0,0 +1,24 @@
+#pragma once
+
+/**
+ * @brief Runtime CPU feature checks for the SIMD kernels
+ * The library is not necessarily built with -mavx2, so AVX2 kernels are
+ * defined in a single translation unit with __attribute__((target("avx2")))
+ * and picked at run time. Headers never branch on __AVX2__, so every
+ * translation unit sees the same inline functions.
+ */
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define PACK_PLANNER_X86_DISPATCH 1
+#endif
+
+/**
+ * @brief Check whether the running CPU supports AVX2
+ * @return bool True if the AVX2 kernels may be called; false on non-x86 builds
+ */
+[[nodiscard]] inline bool cpu_has_avx2() noexcept {
+#ifdef PACK_PLANNER_X86_DISPATCH
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "item.h"
+
+/**
+ * @brief Per-chunk statistics collected while ingesting a CSV file
+ */
+struct ingest_chunk_stats {
+    size_t chunk_index = 0;
+    size_t bytes = 0;
+    size_t lines = 0;
+    size_t items = 0;
+    double parse_time = 0.0;  // milliseconds
+
+    /**
+     * @brief Get parse throughput for this chunk
+     * @return double Megabytes per second (0 if the chunk took no measurable time)
+     */
+    [[nodiscard]] double megabytes_per_second() const noexcept {
+        return parse_time > 0.0 ? (bytes / (1024.0 * 1024.0)) / (parse_time / 1000.0) : 0.0;
+    }
+};
+
+/**
+ * @brief Memory-mapped, multi-threaded loader for item CSV files
+ * The file is mapped, cut into newline-aligned chunks and every chunk is parsed
+ * on its own thread by csv_scanner (std::from_chars for irregular lines).
+ * Chunks are concatenated in order so the resulting items keep the input
+ * (NATURAL) order. Lines that are not "id,length,quantity,weight" (e.g. the
+ * spec header line) are skipped.
+ */
+class csv_ingest {
+public:
+    /**
+     * @brief Construct a new ingest engine
+     * @param thread_count Number of parser threads (0 = hardware concurrency)
+     */
+    explicit csv_ingest(unsigned int thread_count = 0) noexcept;
+
+    /**
+     * @brief Load all items from a file
+     * Falls back to a buffered read when the file cannot be mapped (pipes etc.)
+     * @param filename File to load
+     * @param items Output vector, cleared before loading
+     * @return bool True if at least one item was loaded
+     */
+    bool load(const std::string& filename, std::vector<item>& items);
+
+    /**
+     * @brief Parse an in-memory buffer with the same chunked parallel engine
+     * @param data Start of the buffer
+     * @param size Size of the buffer in bytes
+     * @param items Output vector, cleared before parsing
+     */
+    void parse(const char* data, size_t size, std::vector<item>& items);
+
+    /**
+     * @brief Get statistics for each chunk of the last load/parse call
+     * @return const std::vector<ingest_chunk_stats>& Per-chunk statistics
+     */
+    [[nodiscard]] const std::vector<ingest_chunk_stats>& get_chunk_stats() const noexcept {
+        return m_chunk_stats;
+    }
+
+    /**
+     * @brief Get wall time of the last load/parse call in milliseconds
+     * @return double Elapsed time including mapping and merging
+     */
+    [[nodiscard]] double get_total_time() const noexcept { return m_total_time; }
+
+    /**
+     * @brief Split a buffer into newline-aligned chunks
+     * @param data Start of the buffer
+     * @param size Size of the buffer in bytes
+     * @param chunk_count Desired number of chunks
+     * @return std::vector<size_t> Chunk boundaries (chunk i is [b[i], b[i+1]))
+     */
+    [[nodiscard]] static std::vector<size_t> split_chunks(const char* data, size_t size,
+                                                          size_t chunk_count);
+
+    /**
+     * @brief Parse every line in [first, last) one line at a time
+     * Reference reader used for verification; the chunk workers use csv_scanner.
+     * @param first Start of the range
+     * @param last End of the range
+     * @param items Vector to append parsed items to
+     * @return size_t Number of lines seen (including skipped ones)
+     */
+    static size_t parse_range(const char* first, const char* last, std::vector<item>& items);
+
+    /**
+     * @brief Parse a single "id,length,quantity,weight" line
+     * Leading blanks before each field are skipped and anything after the
+     * weight is ignored, matching the previous istringstream-based reader.
+     * @param first Start of the line
+     * @param last End of the line (excluding the newline)
+     * @param id Parsed item id
+     * @param length Parsed item length
+     * @param quantity Parsed item quantity
+     * @param weight Parsed piece weight
+     * @return bool True if all four fields were parsed
+     */
+    [[nodiscard]] static bool parse_line(const char* first, const char* last,
+                                         int& id, int& length, std::int64_t& quantity,
+                                         double& weight) noexcept {
+        return parse_int_field(first, last, id) && skip_separator(first, last) &&
+               parse_int_field(first, last, length) && skip_separator(first, last) &&
+               parse_int_field(first, last, quantity) && skip_separator(first, last) &&
+               parse_double_field(first, last, weight);
+    }
+
+private:
+    static void skip_blanks(const char*& first, const char* last) noexcept {
+        while (first != last && (*first == ' ' || *first == '\t')) ++first;
+    }
+
+    static bool skip_separator(const char*& first, const char* last) noexcept {
+        skip_blanks(first, last);
+        if (first == last || *first != ',') return false;
+        ++first;
+        return true;
+    }
+
+    template <typename Int>
+    static bool parse_int_field(const char*& first, const char* last, Int& value) noexcept {
+        skip_blanks(first, last);
+        if (first != last && *first == '+') ++first;
+        auto [ptr, ec] = std::from_chars(first, last, value);
+        if (ec != std::errc()) return false;
+        first = ptr;
+        return true;
+    }
+
+    static bool parse_double_field(const char*& first, const char* last, double& value) noexcept {
+        skip_blanks(first, last);
+        if (first != last && *first == '+') ++first;
+        auto [ptr, ec] = std::from_chars(first, last, value);
+        if (ec != std::errc()) return false;
+        first = ptr;
+        return true;
+    }
+
+    unsigned int m_thread_count;
+    std::vector<ingest_chunk_stats> m_chunk_stats;
+    double m_total_time = 0.0;
+
+    // Below this size a single chunk is parsed on the calling thread
+    static constexpr size_t MIN_CHUNK_BYTES = 1 << 20;
+};
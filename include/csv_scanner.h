@@ -0,0 +1,352 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "item.h"
+#include "csv_ingest.h"
+
+/**
+ * @brief Two-stage structural scanner for item CSV text
+ * Stage 1 finds every ',' and '\n' in a window of the input (32 bytes at a
+ * time on CPUs with AVX2, one byte at a time otherwise) and writes their
+ * offsets into a structural index. Stage 2 walks the index four entries per
+ * line and decodes id, length, quantity and weight from the spans between
+ * structurals. Lines that do not have the regular "d,d,d,d.d" shape (header
+ * lines, blanks, signs, CRLF oddities, very long numbers) are handed to
+ * csv_ingest::parse_line so the accepted input is exactly the same as the
+ * scalar reader.
+ */
+class csv_scanner {
+public:
+    // Bytes indexed per stage-1 pass; keeps the index resident in L2
+    static constexpr size_t WINDOW_BYTES = 64 * 1024;
+
+    /**
+     * @brief Find the offsets of all ',' and '\n' bytes
+     * @param data Start of the buffer
+     * @param size Size of the buffer in bytes
+     * @param out Output index; must hold at least size + 32 entries
+     * @return size_t Number of structural characters found
+     */
+    static size_t find_structurals(const char* data, size_t size, uint32_t* out) noexcept;
+
+    /**
+     * @brief Portable stage 1; writes every offset and advances only on a hit
+     */
+    static size_t find_structurals_scalar(const char* data, size_t size, uint32_t* out) noexcept {
+        return find_structurals_scalar_tail(data, 0, size, out);
+    }
+
+    /**
+     * @brief AVX2 stage 1; compares 32 bytes per step and flattens the bitmask
+     * with unconditional stores in groups of four (simdjson-style)
+     * Call only when cpu_has_avx2(); builds without x86 dispatch run the
+     * scalar scan instead.
+     */
+    static size_t find_structurals_avx2(const char* data, size_t size, uint32_t* out) noexcept;
+
+    /**
+     * @brief Parse every line in [first, last) and append valid items
+     * @param first Start of the range
+     * @param last End of the range
+     * @param items Vector to append parsed items to
+     * @return size_t Number of lines seen (including skipped ones)
+     */
+    static size_t parse_range(const char* first, const char* last, std::vector<item>& items) {
+        std::vector<uint32_t> index(WINDOW_BYTES + 32);
+        size_t lines = 0;
+
+        while (first < last) {
+            const size_t window = std::min<size_t>(WINDOW_BYTES, last - first);
+            const size_t count = find_structurals(first, window, index.data());
+
+            // Only complete lines are decoded; the tail is re-scanned next window
+            size_t end = count;
+            while (end > 0 && first[index[end - 1]] != '\n') --end;
+
+            if (end == 0) {
+                if (first + window == last) break;  // final line without a newline
+
+                // Line longer than a window: take the scalar path for it
+                const char* eol = static_cast<const char*>(std::memchr(first, '\n', last - first));
+                if (eol == nullptr) break;
+                parse_fallback(first, eol, items);
+                ++lines;
+                first = eol + 1;
+                continue;
+            }
+
+            lines += decode_window(first, last, index.data(), end, items);
+            first += index[end - 1] + 1;
+        }
+
+        if (first < last) {
+            parse_fallback(first, last, items);
+            ++lines;
+        }
+
+        return lines;
+    }
+
+    /**
+     * @brief Decode an unsigned or '-'-prefixed integer of at most 9 digits
+     * The digit loop accumulates a validity flag instead of branching per byte.
+     * @return bool False if the span is empty, too long or not all digits
+     */
+    [[nodiscard]] static bool decode_int(const char* p, const char* e, int& value) noexcept {
+        const bool negative = p < e && *p == '-';
+        p += negative;
+
+        const size_t length = static_cast<size_t>(e - p);
+        if (length == 0 || length > 9) return false;
+
+        uint32_t v = 0;
+        uint32_t bad = 0;
+        for (; p < e; ++p) {
+            const uint32_t digit = static_cast<uint32_t>(static_cast<unsigned char>(*p)) - '0';
+            bad |= digit > 9;
+            v = v * 10 + digit;
+        }
+
+        value = negative ? -static_cast<int>(v) : static_cast<int>(v);
+        return bad == 0;
+    }
+
+    /**
+     * @brief Decode a plain decimal ("12", "12.5", "0.125") of at most 15 digits
+     * Mantissa and 10^k are both exact doubles, so the single division is
+     * correctly rounded and matches std::from_chars bit for bit.
+     * @return bool False for anything else (exponents, signs, long mantissas)
+     */
+    [[nodiscard]] static bool decode_weight(const char* p, const char* e, double& value) noexcept {
+        e -= (e > p && e[-1] == '\r');
+
+        const bool negative = p < e && *p == '-';
+        p += negative;
+
+        const size_t length = static_cast<size_t>(e - p);
+        if (length == 0 || length > 16) return false;
+
+        // One pass: digits accumulate, a single '.' switches on fraction counting
+        uint64_t mantissa = 0;
+        uint32_t bad = 0;
+        uint32_t dots = 0;
+        uint32_t frac_digits = 0;
+        for (; p < e; ++p) {
+            const uint32_t digit = static_cast<uint32_t>(static_cast<unsigned char>(*p)) - '0';
+            const uint32_t is_dot = *p == '.';
+            bad |= (digit > 9) & (is_dot ^ 1);
+            dots += is_dot;
+            frac_digits += (dots != 0) & (is_dot ^ 1);
+            mantissa = is_dot ? mantissa : mantissa * 10 + digit;
+        }
+        bad |= dots > 1;
+        bad |= length - dots == 0 || length - dots > 15;
+        if (bad) return false;
+
+        const double magnitude = static_cast<double>(mantissa) / POW10[frac_digits];
+        value = negative ? -magnitude : magnitude;
+        return true;
+    }
+
+private:
+    static size_t find_structurals_scalar_tail(const char* data, size_t begin, size_t size,
+                                               uint32_t* out) noexcept {
+        size_t n = 0;
+        for (size_t i = begin; i < size; ++i) {
+            const char c = data[i];
+            out[n] = static_cast<uint32_t>(i);
+            n += (c == ',') | (c == '\n');
+        }
+        return n;
+    }
+
+    /**
+     * @brief Stage 2 over one window whose index ends on a newline
+     * @return size_t Number of lines decoded or skipped
+     */
+    static size_t decode_window(const char* base, const char* limit, const uint32_t* s,
+                                size_t count, std::vector<item>& items) {
+        size_t lines = 0;
+        size_t k = 0;
+        const char* line_start = base;
+
+        while (k < count) {
+            if (k + 3 < count &&
+                base[s[k]] == ',' && base[s[k + 1]] == ',' &&
+                base[s[k + 2]] == ',' && base[s[k + 3]] == '\n') {
+                const char* line_end = base + s[k + 3];
+                // Quantities past 9 digits fail here and take the 64-bit fallback
+                int id = 0, length = 0, quantity = 0;
+                double weight = 0.0;
+                bool ok;
+                if (line_end + 8 <= limit) {
+                    // Every field start has 8 readable bytes: use the SWAR decoders
+                    ok = decode_int_swar(line_start, base + s[k], id) &
+                         decode_int_swar(base + s[k] + 1, base + s[k + 1], length) &
+                         decode_int_swar(base + s[k + 1] + 1, base + s[k + 2], quantity) &
+                         decode_weight_swar(base + s[k + 2] + 1, line_end, weight);
+                } else {
+                    ok = decode_int(line_start, base + s[k], id) &
+                         decode_int(base + s[k] + 1, base + s[k + 1], length) &
+                         decode_int(base + s[k + 1] + 1, base + s[k + 2], quantity) &
+                         decode_weight(base + s[k + 2] + 1, line_end, weight);
+                }
+                if (ok) {
+                    items.emplace_back(id, length, quantity, weight);
+                } else {
+                    parse_fallback(line_start, line_end, items);
+                }
+                line_start = line_end + 1;
+                k += 4;
+            } else {
+                // Irregular line (header, blank, wrong field count): skip to its newline
+                while (base[s[k]] != '\n') ++k;
+                parse_fallback(line_start, base + s[k], items);
+                line_start = base + s[k] + 1;
+                ++k;
+            }
+            ++lines;
+        }
+
+        return lines;
+    }
+
+    /**
+     * @brief Convert 1-8 ASCII digits held in one 64-bit load (simdjson's
+     * eight-digit trick); p must have 8 readable bytes
+     */
+    static uint32_t parse_digits_swar(const char* p, size_t count, uint32_t& bad) noexcept {
+        uint64_t v;
+        std::memcpy(&v, p, sizeof(v));
+
+        // Move the digits to the top bytes and pad the bottom with '0'
+        v <<= (8 - count) * 8;
+        v |= count == 8 ? 0 : (0x3030303030303030ULL >> (count * 8));
+
+        bad |= ((v & 0xF0F0F0F0F0F0F0F0ULL) |
+                (((v + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) != 0x3333333333333333ULL;
+
+        v = ((v & 0x0F0F0F0F0F0F0F0FULL) * 2561) >> 8;
+        v = ((v & 0x00FF00FF00FF00FFULL) * 6553601) >> 16;
+        return static_cast<uint32_t>(((v & 0x0000FFFF0000FFFFULL) * 42949672960001ULL) >> 32);
+    }
+
+    static bool decode_int_swar(const char* p, const char* e, int& value) noexcept {
+        const bool negative = p < e && *p == '-';
+        p += negative;
+
+        const size_t length = static_cast<size_t>(e - p);
+        if (length == 0 || length > 8) return decode_int(p - negative, e, value);
+
+        uint32_t bad = 0;
+        const uint32_t v = parse_digits_swar(p, length, bad);
+        value = negative ? -static_cast<int>(v) : static_cast<int>(v);
+        return bad == 0;
+    }
+
+    static bool decode_weight_swar(const char* p, const char* e, double& value) noexcept {
+        const char* begin = p;
+        e -= (e > p && e[-1] == '\r');
+
+        const bool negative = p < e && *p == '-';
+        p += negative;
+
+        const size_t length = static_cast<size_t>(e - p);
+        if (length == 0 || length > 8) return decode_weight(begin, e, value);
+
+        // Locate the '.' inside the 8-byte word (zero-byte test on w ^ '.')
+        uint64_t w;
+        std::memcpy(&w, p, sizeof(w));
+        const uint64_t x = w ^ 0x2E2E2E2E2E2E2E2EULL;
+        const uint64_t zero = (x - 0x0101010101010101ULL) & ~x & 0x8080808080808080ULL;
+        const size_t dot = zero ? static_cast<size_t>(std::countr_zero(zero) / 8) : 8;
+
+        uint32_t bad = 0;
+        uint64_t mantissa;
+        size_t frac_digits;
+        if (dot >= length) {
+            mantissa = parse_digits_swar(p, length, bad);
+            frac_digits = 0;
+        } else {
+            frac_digits = length - dot - 1;
+            const uint64_t whole = dot ? parse_digits_swar(p, dot, bad) : 0;
+            const uint64_t fraction = frac_digits ? parse_digits_swar(p + dot + 1, frac_digits, bad) : 0;
+            mantissa = whole * POW10_INT[frac_digits] + fraction;
+            bad |= length == 1;  // a lone "."
+        }
+        if (bad) return false;
+
+        const double magnitude = static_cast<double>(mantissa) / POW10[frac_digits];
+        value = negative ? -magnitude : magnitude;
+        return true;
+    }
+
+    static constexpr double POW10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7,
+                                       1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15};
+    static constexpr uint64_t POW10_INT[] = {1, 10, 100, 1000, 10000, 100000, 1000000,
+                                             10000000, 100000000};
+
+    static void parse_fallback(const char* first, const char* last, std::vector<item>& items) {
+        int id, length;
+        std::int64_t quantity;
+        double weight;
+        if (csv_ingest::parse_line(first, last, id, length, quantity, weight)) {
+            items.emplace_back(id, length, quantity, weight);
+        }
+    }
+};
+
+/**
+ * @brief Incremental CSV parser for input that arrives in arbitrary blocks
+ * Complete lines of every block are parsed with csv_scanner; a partial last
+ * line is kept and prefixed to the next block.
+ */
+class csv_block_parser {
+public:
+    /**
+     * @brief Parse all complete lines of the next block
+     * @param data Start of the block
+     * @param size Size of the block in bytes
+     * @param items Vector to append parsed items to
+     */
+    void feed(const char* data, size_t size, std::vector<item>& items) {
+        const char* last = data + size;
+        const char* newline = last;
+        while (newline > data && newline[-1] != '\n') --newline;
+
+        if (newline == data) {
+            m_carry.append(data, size);  // no line ends in this block
+            return;
+        }
+
+        const char* first = data;
+        if (!m_carry.empty()) {
+            const char* eol = static_cast<const char*>(std::memchr(data, '\n', size));
+            m_carry.append(data, eol - data + 1);
+            csv_scanner::parse_range(m_carry.data(), m_carry.data() + m_carry.size(), items);
+            m_carry.clear();
+            first = eol + 1;
+        }
+
+        csv_scanner::parse_range(first, newline, items);
+        m_carry.assign(newline, last);
+    }
+
+    /**
+     * @brief Parse the final line if the input did not end with a newline
+     * @param items Vector to append parsed items to
+     */
+    void finish(std::vector<item>& items) {
+        if (!m_carry.empty()) {
+            csv_scanner::parse_range(m_carry.data(), m_carry.data() + m_carry.size(), items);
+            m_carry.clear();
+        }
+    }
+
+private:
+    std::string m_carry;
+};
@@ -0,0 +1,198 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+#include "pack_strategy.h"
+
+/**
+ * @brief Max tree over per-pack remaining capacity, for first-fit lookups
+ * Leaves are packs in pack-number order; each inner node holds the maximum
+ * of its children. The lowest-numbered pack with at least a given capacity
+ * is one root-to-leaf descent, and updating a pack one leaf-to-root walk,
+ * so both are O(log P). The tree doubles its leaf count as packs are added.
+ * @tparam T Capacity type (double, or int64 thousandths for fixed weights)
+ */
+template <typename T>
+class capacity_tree {
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    /**
+     * @brief Capacity of a pack that can take nothing (e.g. no item slots left)
+     */
+    static constexpr T NONE = std::numeric_limits<T>::lowest();
+
+    /**
+     * @brief Append a pack
+     * @param capacity Remaining capacity of the new pack
+     */
+    void push_back(T capacity) {
+        if (m_size == m_leaves) {
+            grow();
+        }
+        set(m_size++, capacity);
+    }
+
+    /**
+     * @brief Change the remaining capacity of a pack
+     * @param index Pack index (pack number - 1)
+     * @param capacity New remaining capacity
+     */
+    void set(size_t index, T capacity) noexcept {
+        size_t node = m_leaves + index;
+        m_max[node] = capacity;
+        // Stop as soon as an ancestor's maximum is unchanged
+        for (node /= 2; node > 0; node /= 2) {
+            const T best = std::max(m_max[2 * node], m_max[2 * node + 1]);
+            if (m_max[node] == best) break;
+            m_max[node] = best;
+        }
+    }
+
+    /**
+     * @brief Find the lowest-numbered pack with at least the given capacity
+     * @param needed Capacity required (comparisons with NaN find nothing)
+     * @return size_t Pack index, or npos if no pack has room
+     */
+    [[nodiscard]] size_t find_first(T needed) const noexcept {
+        if (m_size == 0 || !(m_max[1] >= needed)) return npos;
+        size_t node = 1;
+        while (node < m_leaves) {
+            node = m_max[2 * node] >= needed ? 2 * node : 2 * node + 1;
+        }
+        return node - m_leaves;
+    }
+
+    [[nodiscard]] size_t size() const noexcept { return m_size; }
+
+private:
+    // Rebuild with twice the leaves; amortized O(1) per push_back
+    void grow() {
+        const size_t leaves = m_leaves == 0 ? 64 : 2 * m_leaves;
+        std::vector<T> next(2 * leaves, NONE);
+        std::copy(m_max.begin() + m_leaves, m_max.begin() + m_leaves + m_size, next.begin() + leaves);
+        for (size_t node = leaves - 1; node > 0; --node) {
+            next[node] = std::max(next[2 * node], next[2 * node + 1]);
+        }
+        m_max = std::move(next);
+        m_leaves = leaves;
+    }
+
+    std::vector<T> m_max;  // 1-based heap layout; leaves start at m_leaves
+    size_t m_leaves = 0;
+    size_t m_size = 0;
+};
+
+/**
+ * @brief First-fit pack strategy
+ * Every run of pieces goes into the lowest-numbered pack that still has room
+ * for at least one of them, so later light items top up earlier packs. A
+ * capacity_tree finds that pack in O(log P). Only vector plans are filled
+ * directly: earlier packs keep growing, which flat arenas and range plans
+ * cannot represent.
+ */
+class first_fit_pack_strategy : public pack_strategy {
+public:
+    using pack_strategy::pack_items;
+
+    /**
+     * @brief Pack items first-fit
+     * @param items Items to pack, stored column-wise
+     * @param max_items Maximum items per pack
+     * @param max_weight Maximum weight per pack
+     * @return std::vector<pack> Vector of packs
+     */
+    std::vector<pack> pack_items(const item_column_view& items,
+                                 int max_items,
+                                 double max_weight) override {
+        std::vector<pack> packs;
+        with_weight_policy([&](auto weights) {
+            pack_first_fit(items, max_items, max_weight, packs, weights, get_memory_resource());
+        });
+        return packs;
+    }
+
+    std::string get_name() const override {
+        return "First-Fit";
+    }
+
+    /**
+     * @brief The first-fit packing loop
+     * @param items Items to pack, stored column-wise
+     * @param max_items Maximum items per pack
+     * @param max_weight Maximum weight per pack
+     * @param packs Receives the packs
+     * @param weights Weight policy tag (floating_weights or fixed_weights)
+     * @param resource Memory resource for the packs' item lists
+     */
+    template <typename Weights = floating_weights>
+    static void pack_first_fit(const item_column_view& items,
+                               int max_items,
+                               double max_weight,
+                               std::vector<pack>& packs,
+                               Weights = {},
+                               std::pmr::memory_resource* resource = std::pmr::get_default_resource()) {
+        using capacity = typename Weights::value_type;
+
+        // SAFETY: Validate constraints to prevent infinite loops
+        max_items = std::max(1, max_items);
+        max_weight = std::max(0.1, max_weight);
+        const auto weight_limit = Weights::convert(max_weight);
+
+        capacity_tree<capacity> room;
+        // A pack with no item slots left can take nothing, whatever its weight
+        auto remaining = [&](const pack& p) {
+            return p.get_total_items() < max_items ? Weights::remaining_weight(p, weight_limit)
+                                                   : capacity_tree<capacity>::NONE;
+        };
+        std::int64_t pack_number = 0;
+        auto open_next = [&] {
+            start_pack(packs, ++pack_number, resource);
+            room.push_back(weight_limit);
+        };
+        open_next();
+
+        for (size_t i = 0; i < items.size(); ++i) {
+            const size_t row = items.row(i);
+
+            // SAFETY: Skip items with non-positive quantities, and pieces no pack can hold
+            if (items.quantities[row] <= 0) continue;
+            const auto weight = Weights::convert(items.weights[row]);
+            if (weight > weight_limit) continue;
+
+            // Packs clamp negative (and NaN) weights to zero; look up with the same value
+            const capacity needed = std::max<capacity>(0, weight);
+            std::int64_t remaining_quantity = items.quantities[row];
+
+            while (remaining_quantity > 0) {
+                size_t slot = room.find_first(needed);
+                if (slot == capacity_tree<capacity>::npos) {
+                    open_next();
+                    slot = packs.size() - 1;
+
+                    // A run spanning several new packs fills them in one step
+                    const std::int64_t placed = place_full_packs<Weights>(packs, open_next,
+                        items.ids[row], items.lengths[row], remaining_quantity,
+                        weight, max_items, weight_limit);
+                    if (placed > 0) {
+                        for (size_t k = slot; k < packs.size(); ++k) {
+                            room.set(k, remaining(packs[k]));
+                        }
+                        remaining_quantity -= placed;
+                        continue;
+                    }
+                }
+
+                const std::int64_t added = Weights::add_partial_item(packs[slot],
+                    items.ids[row], items.lengths[row], remaining_quantity,
+                    weight, max_items, weight_limit);
+                room.set(slot, remaining(packs[slot]));
+
+                // An empty pack that rejects the item (e.g. NaN weight) would loop forever
+                if (added <= 0) break;
+                remaining_quantity -= added;
+            }
+        }
+    }
+};
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+#include "spsc_ring.h"
+
+struct gzFile_s;
+
+/**
+ * @brief Check whether a file starts with the gzip magic bytes
+ * @param path File to inspect
+ * @return bool True for gzip-compressed files
+ */
+[[nodiscard]] bool is_gzip_file(const std::string& path);
+
+/**
+ * @brief Check whether a path names gzip output (ends in ".gz")
+ * @param path Output path
+ * @return bool True if output should be compressed
+ */
+[[nodiscard]] bool has_gzip_extension(const std::string& path) noexcept;
+
+/**
+ * @brief Threaded gzip decompressor delivering fixed-size blocks
+ * A background thread inflates the file into blocks and queues them in a
+ * bounded ring, so decompression overlaps with whatever consumes the blocks
+ * (parsing, packing). Uncompressed files are passed through unchanged.
+ */
+class gzip_reader {
+public:
+    static constexpr size_t BLOCK_BYTES = 1 << 20;
+    static constexpr size_t RING_CAPACITY = 8;
+
+    gzip_reader() = default;
+    ~gzip_reader();
+
+    gzip_reader(const gzip_reader&) = delete;
+    gzip_reader& operator=(const gzip_reader&) = delete;
+
+    /**
+     * @brief Open a file and start the decompression thread
+     * @param path File to read
+     * @return bool True if the file could be opened
+     */
+    [[nodiscard]] bool open(const std::string& path);
+
+    /**
+     * @brief Get the next decompressed block (consumer side)
+     * @param block Receives the block contents
+     * @return bool False once all data has been delivered
+     */
+    bool next_block(std::string& block);
+
+    /**
+     * @brief Check for decompression errors (meaningful after next_block() returned false)
+     * @return bool True if the whole stream was inflated without error
+     */
+    [[nodiscard]] bool ok() const noexcept { return !m_failed.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Stop the decompression thread and close the file
+     */
+    void close();
+
+private:
+    void run();
+
+    gzFile_s* m_file = nullptr;
+    std::unique_ptr<spsc_ring<std::string>> m_blocks;
+    std::thread m_thread;
+    std::atomic<bool> m_stop{false};
+    std::atomic<bool> m_failed{false};
+};
+
+/**
+ * @brief Stream buffer compressing everything written to it into a gzip file
+ */
+class gzip_ostreambuf : public std::streambuf {
+public:
+    static constexpr size_t BUFFER_BYTES = 256 * 1024;
+
+    gzip_ostreambuf() = default;
+    ~gzip_ostreambuf() override;
+
+    gzip_ostreambuf(const gzip_ostreambuf&) = delete;
+    gzip_ostreambuf& operator=(const gzip_ostreambuf&) = delete;
+
+    /**
+     * @brief Create (or truncate) a gzip file
+     * @param path File to write
+     * @param level Compression level (1 = fastest, 9 = smallest)
+     * @return bool True if the file was opened
+     */
+    bool open(const std::string& path, int level = 6);
+
+    /**
+     * @brief Flush pending data and finish the gzip stream
+     * @return bool True if everything was written
+     */
+    bool close();
+
+    /**
+     * @brief Check whether a file is open
+     * @return bool True if open
+     */
+    [[nodiscard]] bool is_open() const noexcept { return m_file != nullptr; }
+
+protected:
+    int_type overflow(int_type ch) override;
+    std::streamsize xsputn(const char* data, std::streamsize count) override;
+    int sync() override;
+
+private:
+    bool flush_buffer();
+
+    gzFile_s* m_file = nullptr;
+    std::vector<char> m_buffer;
+};
+
+/**
+ * @brief Output stream writing a gzip-compressed file
+ */
+class gzip_ofstream : public std::ostream {
+public:
+    /**
+     * @brief Open a compressed output file
+     * @param path File to write
+     * @param level Compression level (1 = fastest, 9 = smallest)
+     */
+    explicit gzip_ofstream(const std::string& path, int level = 6)
+        : std::ostream(&m_buffer) {
+        if (!m_buffer.open(path, level)) {
+            setstate(std::ios::failbit);
+        }
+    }
+
+    /**
+     * @brief Check whether the file is open
+     * @return bool True if open
+     */
+    [[nodiscard]] bool is_open() const noexcept { return m_buffer.is_open(); }
+
+    /**
+     * @brief Finish the gzip stream and close the file
+     */
+    void close() {
+        if (!m_buffer.close()) {
+            setstate(std::ios::failbit);
+        }
+    }
+
+private:
+    gzip_ostreambuf m_buffer;
+};
@@ -1,8 +1,10 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <iomanip>
 #include <sstream>
+#include "weight_mode.h"
 
 /**
  * @brief Represents an item with id, length, quantity, and weight properties
@@ -16,7 +18,7 @@ public:
      * @param quantity The item quantity
      * @param weight The weight per piece
      */
-    item(int id, int length, int quantity, double weight) noexcept
+    item(int id, int length, std::int64_t quantity, double weight) noexcept
     : m_id(id), m_length(length), m_quantity(quantity), m_weight(weight)
     {}
 
@@ -35,9 +37,9 @@ public:
 
     /**
      * @brief Get the item quantity
-     * @return int The item quantity
+     * @return std::int64_t The item quantity
      */
-    [[nodiscard]] int get_quantity() const noexcept { return m_quantity; }
+    [[nodiscard]] std::int64_t get_quantity() const noexcept { return m_quantity; }
 
     /**
      * @brief Get the weight per piece
@@ -45,18 +47,26 @@ public:
      */
     [[nodiscard]] double get_weight() const noexcept { return m_weight; }
 
+    /**
+     * @brief Get the weight per piece rounded to integer thousandths
+     * @return std::int64_t The weight in fixed-point units (see fixed_weight)
+     */
+    [[nodiscard]] std::int64_t get_fixed_weight() const noexcept {
+        return fixed_weight::from_double(m_weight);
+    }
+
     // Setters
     /**
      * @brief Set the item quantity
      * @param quantity The new quantity
      */
-    void set_quantity(int quantity) noexcept { m_quantity = quantity; }
+    void set_quantity(std::int64_t quantity) noexcept { m_quantity = quantity; }
 
     /**
      * @brief Get the total weight for this item (quantity * weight per piece)
      * @return double The total weight
      */
-    [[nodiscard]] double get_total_weight() const noexcept { return m_quantity * m_weight; }
+    [[nodiscard]] double get_total_weight() const noexcept { return static_cast<double>(m_quantity) * m_weight; }
 
     /**
      * @brief Get string representation of the item
@@ -92,6 +102,6 @@ public:
 private:
     int m_id;
     int m_length;
-    int m_quantity;
+    std::int64_t m_quantity;  // 64-bit: aggregated feeds exceed 2^31 pieces
     double m_weight;  // weight per piece
 };
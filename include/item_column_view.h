@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "item.h"
+
+/**
+ * @brief Non-owning view of items stored column-wise (structure of arrays)
+ * Row r is (ids[r], lengths[r], quantities[r], weights[r]). The view does not
+ * own the columns; they typically point into a mapped binary item file.
+ * If order is set, the i-th item of the view is row order[i] (e.g. a sort
+ * permutation), so consumers index the columns through row(i).
+ */
+struct item_column_view {
+    const int* ids = nullptr;
+    const int* lengths = nullptr;
+    const std::int64_t* quantities = nullptr;
+    const double* weights = nullptr;
+    size_t count = 0;
+    const std::uint32_t* order = nullptr;  // optional permutation of count rows
+
+    /**
+     * @brief Map a position in the view to a column row
+     * @param i Position (must be < count)
+     * @return size_t Row index into the columns
+     */
+    [[nodiscard]] size_t row(size_t i) const noexcept { return order ? order[i] : i; }
+
+    /**
+     * @brief Get the number of rows
+     * @return size_t Row count
+     */
+    [[nodiscard]] size_t size() const noexcept { return count; }
+
+    /**
+     * @brief Check whether the view holds no rows
+     * @return bool True if empty
+     */
+    [[nodiscard]] bool empty() const noexcept { return count == 0; }
+
+    /**
+     * @brief Build the item at one position of the view
+     * @param i Position (must be < count)
+     * @return item Item at that position
+     */
+    [[nodiscard]] item at(size_t i) const noexcept {
+        const size_t r = row(i);
+        return item(ids[r], lengths[r], quantities[r], weights[r]);
+    }
+
+    /**
+     * @brief Materialize all rows as items
+     * @return std::vector<item> Items in view order
+     */
+    [[nodiscard]] std::vector<item> to_items() const {
+        std::vector<item> items;
+        items.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            items.push_back(at(i));
+        }
+        return items;
+    }
+};
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "item.h"
+#include "item_column_view.h"
+
+/**
+ * @brief Owning structure-of-arrays item store
+ * Row i is (ids()[i], lengths()[i], quantities()[i], weights()[i]). The
+ * packing strategies and the column sorts read these arrays directly, so a
+ * loop that only needs lengths touches 4 bytes per row (quantities, which
+ * are 64-bit, 8 bytes) instead of a whole item.
+ */
+class item_columns {
+public:
+    item_columns() = default;
+
+    /**
+     * @brief Copy items into columns (adapter for std::vector<item> callers)
+     * @param items Items in row order
+     */
+    explicit item_columns(const std::vector<item>& items) {
+        reserve(items.size());
+        for (const auto& i : items) {
+            push_back(i.get_id(), i.get_length(), i.get_quantity(), i.get_weight());
+        }
+    }
+
+    /**
+     * @brief Copy rows out of a non-owning view (e.g. a mapped binary item file)
+     * A permuted view is copied in view order.
+     * @param view Item columns to copy
+     */
+    explicit item_columns(const item_column_view& view) {
+        if (!view.order) {
+            m_ids.assign(view.ids, view.ids + view.count);
+            m_lengths.assign(view.lengths, view.lengths + view.count);
+            m_quantities.assign(view.quantities, view.quantities + view.count);
+            m_weights.assign(view.weights, view.weights + view.count);
+            return;
+        }
+        reserve(view.count);
+        for (size_t i = 0; i < view.count; ++i) {
+            const size_t r = view.order[i];
+            push_back(view.ids[r], view.lengths[r], view.quantities[r], view.weights[r]);
+        }
+    }
+
+    /**
+     * @brief Reserve space for rows
+     * @param count Number of rows
+     */
+    void reserve(size_t count) {
+        m_ids.reserve(count);
+        m_lengths.reserve(count);
+        m_quantities.reserve(count);
+        m_weights.reserve(count);
+    }
+
+    /**
+     * @brief Append a row
+     * @param id The item ID
+     * @param length The item length
+     * @param quantity The item quantity
+     * @param weight The weight per piece
+     */
+    void push_back(int id, int length, std::int64_t quantity, double weight) {
+        m_ids.push_back(id);
+        m_lengths.push_back(length);
+        m_quantities.push_back(quantity);
+        m_weights.push_back(weight);
+    }
+
+    /**
+     * @brief Remove all rows
+     */
+    void clear() noexcept {
+        m_ids.clear();
+        m_lengths.clear();
+        m_quantities.clear();
+        m_weights.clear();
+    }
+
+    /**
+     * @brief Get the number of rows
+     * @return size_t Row count
+     */
+    [[nodiscard]] size_t size() const noexcept { return m_ids.size(); }
+
+    /**
+     * @brief Check whether the store holds no rows
+     * @return bool True if empty
+     */
+    [[nodiscard]] bool empty() const noexcept { return m_ids.empty(); }
+
+    /**
+     * @brief Build an item for one row
+     * @param i Row index (must be < size())
+     * @return item Item for that row
+     */
+    [[nodiscard]] item at(size_t i) const noexcept {
+        return item(m_ids[i], m_lengths[i], m_quantities[i], m_weights[i]);
+    }
+
+    /**
+     * @brief Get a non-owning view of the columns
+     * The view is invalidated by any operation that reallocates the columns.
+     * @return item_column_view View over all rows
+     */
+    [[nodiscard]] item_column_view view() const noexcept {
+        return item_column_view{m_ids.data(), m_lengths.data(), m_quantities.data(),
+                                m_weights.data(), m_ids.size()};
+    }
+
+    /**
+     * @brief Materialize all rows as items
+     * @return std::vector<item> Items in row order
+     */
+    [[nodiscard]] std::vector<item> to_items() const { return view().to_items(); }
+
+    /**
+     * @brief Sum the positive quantities
+     * @return std::int64_t Total number of pieces
+     */
+    [[nodiscard]] std::int64_t total_quantity() const noexcept {
+        std::int64_t total = 0;
+        for (const std::int64_t quantity : m_quantities) {
+            total += quantity > 0 ? quantity : 0;
+        }
+        return total;
+    }
+
+    // Column access; the mutable overloads are for sorts that permute rows in place
+    [[nodiscard]] const std::vector<int>& ids() const noexcept { return m_ids; }
+    [[nodiscard]] const std::vector<int>& lengths() const noexcept { return m_lengths; }
+    [[nodiscard]] const std::vector<std::int64_t>& quantities() const noexcept { return m_quantities; }
+    [[nodiscard]] const std::vector<double>& weights() const noexcept { return m_weights; }
+    [[nodiscard]] std::vector<int>& ids() noexcept { return m_ids; }
+    [[nodiscard]] std::vector<int>& lengths() noexcept { return m_lengths; }
+    [[nodiscard]] std::vector<std::int64_t>& quantities() noexcept { return m_quantities; }
+    [[nodiscard]] std::vector<double>& weights() noexcept { return m_weights; }
+
+private:
+    std::vector<int> m_ids;
+    std::vector<int> m_lengths;
+    std::vector<std::int64_t> m_quantities;
+    std::vector<double> m_weights;
+};
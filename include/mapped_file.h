@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief RAII wrapper around a memory-mapped file
+ * Used by the ingest and output paths to avoid copying file contents through
+ * stream buffers. Only regular files can be mapped; callers fall back to
+ * stream I/O for pipes and character devices.
+ */
+class mapped_file {
+public:
+    mapped_file() noexcept = default;
+    ~mapped_file();
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+    mapped_file(mapped_file&& other) noexcept;
+    mapped_file& operator=(mapped_file&& other) noexcept;
+
+    /**
+     * @brief Map an existing file read-only
+     * @param path File to map
+     * @return bool True if the file is a regular file and was mapped
+     */
+    [[nodiscard]] bool open_read(const std::string& path);
+
+    /**
+     * @brief Create (or truncate) a file of the given size and map it read-write
+     * @param path File to create
+     * @param size Exact size of the file in bytes
+     * @return bool True if the file was created, its blocks reserved and mapped
+     */
+    [[nodiscard]] bool create(const std::string& path, size_t size);
+
+    /**
+     * @brief Unmap the file and close the descriptor
+     */
+    void close() noexcept;
+
+    /**
+     * @brief Hint the kernel that the mapping will be read front to back
+     */
+    void advise_sequential() const noexcept;
+
+    /**
+     * @brief Get the mapped bytes (nullptr for empty files)
+     * @return const char* Start of the mapping
+     */
+    [[nodiscard]] const char* data() const noexcept { return m_data; }
+
+    /**
+     * @brief Get the writable mapped bytes (only valid after create())
+     * @return char* Start of the mapping
+     */
+    [[nodiscard]] char* data() noexcept { return m_data; }
+
+    /**
+     * @brief Get the mapped size in bytes
+     * @return size_t Size of the mapping
+     */
+    [[nodiscard]] size_t size() const noexcept { return m_size; }
+
+    /**
+     * @brief Check whether a file is currently open
+     * @return bool True if open
+     */
+    [[nodiscard]] bool is_open() const noexcept { return m_fd >= 0; }
+
+private:
+    char* m_data = nullptr;
+    size_t m_size = 0;
+    int m_fd = -1;
+};
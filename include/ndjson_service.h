@@ -0,0 +1,122 @@
+#pragma once
+
+#include <istream>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "item.h"
+#include "pack_planner.h"
+
+/**
+ * @brief One parsed planning request
+ * Mirrors the body of the HTTP API's POST /api/pack plus an optional "id":
+ * {"id": ..., "items": [{"id","length","quantity","weight"}, ...],
+ *  "configuration": {"sortOrder","maxItemsPerPack","maxWeightPerPack",
+ *                    "strategyType","threadCount"}}
+ * Items may also be given as [id, length, quantity, weight] arrays.
+ */
+struct ndjson_request {
+    std::string id;  // raw JSON of the "id" member (string or number), empty if absent
+    pack_planner_config config;
+    std::vector<item> items;
+};
+
+/**
+ * @brief Newline-delimited JSON request/response processor
+ * Reads one planning request per line and writes one response object per
+ * line. Requests are planned concurrently on a worker pool; responses are
+ * written in request order by default, or as soon as they complete in
+ * unordered mode. Every response carries the request's "id", or its 1-based
+ * line number when the request had none, so unordered output can be matched
+ * back. A malformed request produces an error response, never a failed run.
+ */
+class ndjson_service {
+public:
+    // Requests read ahead of the writer per worker; bounds memory on long streams
+    static constexpr size_t IN_FLIGHT_PER_WORKER = 4;
+
+    /**
+     * @brief Construct a new service
+     * @param defaults Configuration used for fields a request leaves out
+     * @param worker_count Number of planning threads (0 = hardware concurrency)
+     * @param ordered Write responses in request order (false = completion order)
+     */
+    explicit ndjson_service(const pack_planner_config& defaults = {}, unsigned int worker_count = 0,
+                            bool ordered = true) noexcept;
+
+    /**
+     * @brief Process every request line of input, writing responses to output
+     * Blank lines are skipped and do not produce a response.
+     * @param input Request stream
+     * @param output Response stream
+     */
+    void run(std::istream& input, std::ostream& output);
+
+    /**
+     * @brief Plan one request line and render its response (without newline)
+     * @param line Request JSON
+     * @param line_number 1-based line number, used as id when the request has none
+     * @param planner Planner reused across requests by the calling worker
+     * @param response Receives the response JSON
+     * @return bool False if an error response was rendered
+     */
+    bool process(std::string_view line, size_t line_number, pack_planner& planner,
+                 std::string& response) const;
+
+    /**
+     * @brief Parse a request line
+     * @param line Request JSON
+     * @param request Receives the request; its config starts from the defaults
+     * @param error Receives a description on failure
+     * @return bool True if the line was a valid request
+     */
+    [[nodiscard]] bool parse_request(std::string_view line, ndjson_request& request,
+                                     std::string& error) const;
+
+    /**
+     * @brief Render a successful planning response
+     * @param id Raw JSON id
+     * @param config Configuration the request was planned with
+     * @param result Planning result
+     * @param out String the JSON object is appended to
+     */
+    static void render_response(std::string_view id, const pack_planner_config& config,
+                                const pack_planner_result& result, std::string& out);
+
+    /**
+     * @brief Render an error response: {"id":..,"success":false,"error":..,"details":..}
+     * @param id Raw JSON id
+     * @param error Short error
+     * @param details Human-readable details
+     * @param out String the JSON object is appended to
+     */
+    static void render_error(std::string_view id, std::string_view error, std::string_view details,
+                             std::string& out);
+
+    /**
+     * @brief Get the number of requests answered by the last run call
+     * @return size_t Response count (including error responses)
+     */
+    [[nodiscard]] size_t get_requests() const noexcept { return m_requests; }
+
+    /**
+     * @brief Get the number of error responses written by the last run call
+     * @return size_t Failed request count
+     */
+    [[nodiscard]] size_t get_failed() const noexcept { return m_failed; }
+
+    /**
+     * @brief Get wall time of the last run call in milliseconds
+     * @return double Elapsed time
+     */
+    [[nodiscard]] double get_total_time() const noexcept { return m_total_time; }
+
+private:
+    pack_planner_config m_defaults;
+    unsigned int m_worker_count;
+    bool m_ordered;
+    size_t m_requests = 0;
+    size_t m_failed = 0;
+    double m_total_time = 0.0;
+};
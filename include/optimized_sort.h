@@ -8,7 +8,10 @@
 #include <concurrentqueue/moodycamel/concurrentqueue.h>
 #include <immintrin.h>
 #include <cmath>
+#include <cstdint>
+#include <limits>
 #include "item.h"
+#include "item_columns.h"
 
 namespace optimized_sort {
 
@@ -1183,4 +1186,221 @@ private:
     }
 };
 
+// LSD radix sort for item_columns. Keys are read from the contiguous length
+// column and every pass scatters the four columns, so no item is constructed
+// and the counting pass touches 4 bytes per row. Stable, like RadixSort.
+class ColumnRadixSort {
+public:
+    static void sort_by_length(item_columns& columns, bool ascending = true) {
+        const size_t n = columns.size();
+        if (n < 2) return;
+
+        constexpr int RADIX_BITS = 8;
+        constexpr int RADIX_SIZE = 1 << RADIX_BITS;
+        constexpr uint32_t RADIX_MASK = RADIX_SIZE - 1;
+
+        std::vector<int>& ids = columns.ids();
+        std::vector<int>& lengths = columns.lengths();
+        std::vector<std::int64_t>& quantities = columns.quantities();
+        std::vector<double>& weights = columns.weights();
+
+        // Plain loops over an int column vectorize; keys are biased by the
+        // minimum so negative lengths order correctly and narrow ranges need
+        // fewer passes
+        int min_length = lengths[0];
+        int max_length = lengths[0];
+        for (const int length : lengths) {
+            min_length = std::min(min_length, length);
+            max_length = std::max(max_length, length);
+        }
+        const uint32_t base = static_cast<uint32_t>(min_length);
+        const uint32_t range = static_cast<uint32_t>(max_length) - base;
+        if (range == 0) return;
+
+        std::vector<int> ids_buffer(n);
+        std::vector<int> lengths_buffer(n);
+        std::vector<std::int64_t> quantities_buffer(n);
+        std::vector<double> weights_buffer(n);
+        std::vector<size_t> count(RADIX_SIZE);
+
+        for (int shift = 0; shift < 32 && (range >> shift) > 0; shift += RADIX_BITS) {
+            std::fill(count.begin(), count.end(), 0);
+            for (const int length : lengths) {
+                ++count[((static_cast<uint32_t>(length) - base) >> shift) & RADIX_MASK];
+            }
+
+            // A pass where every key lands in one bucket would not move anything
+            const size_t first_bucket = ((static_cast<uint32_t>(lengths[0]) - base) >> shift) & RADIX_MASK;
+            if (count[first_bucket] == n) continue;
+
+            // Exclusive prefix sum, walking buckets backwards for descending order
+            size_t running = 0;
+            for (int b = 0; b < RADIX_SIZE; ++b) {
+                const int bucket = ascending ? b : RADIX_SIZE - 1 - b;
+                const size_t c = count[bucket];
+                count[bucket] = running;
+                running += c;
+            }
+
+            for (size_t i = 0; i < n; ++i) {
+                const uint32_t bucket = ((static_cast<uint32_t>(lengths[i]) - base) >> shift) & RADIX_MASK;
+                const size_t dst = count[bucket]++;
+                ids_buffer[dst] = ids[i];
+                lengths_buffer[dst] = lengths[i];
+                quantities_buffer[dst] = quantities[i];
+                weights_buffer[dst] = weights[i];
+            }
+
+            ids.swap(ids_buffer);
+            lengths.swap(lengths_buffer);
+            quantities.swap(quantities_buffer);
+            weights.swap(weights_buffer);
+        }
+    }
+};
+
+
+// LSD radix sort of packed (length, row index) keys: 8 bytes per row move on
+// each pass however wide a row is, and the rows are gathered once at the
+// end. sort_permutation() returns the order itself so callers can read rows
+// through it (item_column_view::order) without reordering the source.
+// Stable, like RadixSort.
+class KeyIndexRadixSort {
+public:
+    // Row indices are packed into the low 32 bits of each key
+    static constexpr size_t MAX_ROWS = std::numeric_limits<uint32_t>::max();
+
+    /**
+     * @brief Compute the stable order of rows by length
+     * @param lengths Length column
+     * @param n Number of rows
+     * @param ascending Sort short to long if true, long to short otherwise
+     * @return std::vector<uint32_t> Row indices in sorted order (empty if n > MAX_ROWS)
+     */
+    static std::vector<uint32_t> sort_permutation(const int* lengths, size_t n, bool ascending = true) {
+        std::vector<uint32_t> order;
+        if (n == 0 || n > MAX_ROWS) return order;
+
+        constexpr int RADIX_BITS = 8;
+        constexpr int RADIX_SIZE = 1 << RADIX_BITS;
+        constexpr uint64_t RADIX_MASK = RADIX_SIZE - 1;
+
+        int min_length = lengths[0];
+        int max_length = lengths[0];
+        for (size_t i = 0; i < n; ++i) {
+            min_length = std::min(min_length, lengths[i]);
+            max_length = std::max(max_length, lengths[i]);
+        }
+        const uint32_t base = static_cast<uint32_t>(min_length);
+        const uint32_t range = static_cast<uint32_t>(max_length) - base;
+
+        // Descending order inverts the biased key, so ties keep input order
+        std::vector<uint64_t> keys(n);
+        for (size_t i = 0; i < n; ++i) {
+            const uint32_t biased = static_cast<uint32_t>(lengths[i]) - base;
+            const uint32_t key = ascending ? biased : range - biased;
+            keys[i] = (static_cast<uint64_t>(key) << 32) | static_cast<uint32_t>(i);
+        }
+
+        std::vector<uint64_t> buffer(n);
+        std::vector<size_t> count(RADIX_SIZE);
+        for (int shift = 32; shift < 64 && (static_cast<uint64_t>(range) >> (shift - 32)) > 0;
+             shift += RADIX_BITS) {
+            std::fill(count.begin(), count.end(), 0);
+            for (const uint64_t key : keys) {
+                ++count[(key >> shift) & RADIX_MASK];
+            }
+
+            // A pass where every key lands in one bucket would not move anything
+            if (count[(keys[0] >> shift) & RADIX_MASK] == n) continue;
+
+            size_t running = 0;
+            for (int b = 0; b < RADIX_SIZE; ++b) {
+                const size_t c = count[b];
+                count[b] = running;
+                running += c;
+            }
+
+            for (const uint64_t key : keys) {
+                buffer[count[(key >> shift) & RADIX_MASK]++] = key;
+            }
+            keys.swap(buffer);
+        }
+
+        order.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            order[i] = static_cast<uint32_t>(keys[i]);
+        }
+        return order;
+    }
+
+    /**
+     * @brief Compute the stable order of a view's items by length
+     * A view that is already permuted yields a permutation of its rows.
+     * @param view Items to order
+     * @param ascending Sort short to long if true, long to short otherwise
+     * @return std::vector<uint32_t> Row indices in sorted order (empty if too many rows)
+     */
+    static std::vector<uint32_t> sort_permutation(const item_column_view& view, bool ascending = true) {
+        if (!view.order) return sort_permutation(view.lengths, view.count, ascending);
+
+        std::vector<int> lengths(view.count);
+        for (size_t i = 0; i < view.count; ++i) {
+            lengths[i] = view.lengths[view.order[i]];
+        }
+        std::vector<uint32_t> order = sort_permutation(lengths.data(), view.count, ascending);
+        for (uint32_t& row : order) {
+            row = view.order[row];
+        }
+        return order;
+    }
+
+    static void sort_by_length(std::vector<item>& items, bool ascending = true) {
+        const size_t n = items.size();
+        if (n < 2) return;
+        if (n > MAX_ROWS) {
+            RadixSort::sort_by_length(items, ascending);
+            return;
+        }
+
+        std::vector<int> lengths(n);
+        for (size_t i = 0; i < n; ++i) {
+            lengths[i] = items[i].get_length();
+        }
+        const std::vector<uint32_t> order = sort_permutation(lengths.data(), n, ascending);
+
+        std::vector<item> sorted;
+        sorted.reserve(n);
+        for (const uint32_t row : order) {
+            sorted.push_back(items[row]);
+        }
+        items.swap(sorted);
+    }
+
+    static void sort_by_length(item_columns& columns, bool ascending = true) {
+        const size_t n = columns.size();
+        if (n < 2) return;
+        if (n > MAX_ROWS) {
+            ColumnRadixSort::sort_by_length(columns, ascending);
+            return;
+        }
+
+        const std::vector<uint32_t> order = sort_permutation(columns.lengths().data(), n, ascending);
+        gather(columns.ids(), order);
+        gather(columns.lengths(), order);
+        gather(columns.quantities(), order);
+        gather(columns.weights(), order);
+    }
+
+private:
+    template <typename T>
+    static void gather(std::vector<T>& column, const std::vector<uint32_t>& order) {
+        std::vector<T> sorted(order.size());
+        for (size_t i = 0; i < order.size(); ++i) {
+            sorted[i] = column[order[i]];
+        }
+        column.swap(sorted);
+    }
+};
+
 }
@@ -1,26 +1,67 @@
 #pragma once
 
 #include <vector>
+#include <memory_resource>
 #include <string>
 #include <algorithm>
+#include <cstdint>
 #include <sstream>
 #include "item.h"
 
 /**
  * @brief Represents a pack containing multiple items
+ * The item list is allocated from a std::pmr::memory_resource (the default
+ * resource unless one is given), so a whole plan can live in one arena.
  */
 class pack {
 public:
+    using allocator_type = std::pmr::polymorphic_allocator<item>;
+
     /**
      * @brief Construct a new pack object
      * @param pack_number The pack identifier
      */
-    explicit pack(int pack_number) noexcept
-        : m_pack_number(pack_number) {
+    explicit pack(std::int64_t pack_number) noexcept
+        : pack(pack_number, allocator_type{}) {}
+
+    /**
+     * @brief Construct a new pack object whose items live in a memory resource
+     * The resource must outlive the pack.
+     * @param pack_number The pack identifier
+     * @param alloc Allocator (or memory resource) for the item list
+     */
+    pack(std::int64_t pack_number, const allocator_type& alloc) noexcept
+        : m_pack_number(pack_number), m_items(alloc) {
         // Reserve some space to avoid initial reallocations
         m_items.reserve(8);
     }
 
+    // Plain copies use the default resource, so they never outlive an arena
+    pack(const pack&) = default;
+    pack(pack&&) noexcept = default;
+    pack& operator=(const pack&) = default;
+    pack& operator=(pack&&) = default;
+
+    /**
+     * @brief Copy a pack into another memory resource (allocator-extended copy)
+     * @param other Pack to copy
+     * @param alloc Allocator for the copy's item list
+     */
+    pack(const pack& other, const allocator_type& alloc)
+        : m_pack_number(other.m_pack_number), m_items(other.m_items, alloc),
+          m_total_items(other.m_total_items), m_total_weight(other.m_total_weight),
+          m_total_weight_fixed(other.m_total_weight_fixed), m_max_length(other.m_max_length) {}
+
+    /**
+     * @brief Move a pack into another memory resource (copies the items if the resources differ)
+     * @param other Pack to move from
+     * @param alloc Allocator for the new pack's item list
+     */
+    pack(pack&& other, const allocator_type& alloc)
+        : m_pack_number(other.m_pack_number), m_items(std::move(other.m_items), alloc),
+          m_total_items(other.m_total_items), m_total_weight(other.m_total_weight),
+          m_total_weight_fixed(other.m_total_weight_fixed), m_max_length(other.m_max_length) {}
+
     /**
      * @brief Add item to pack
      * @param item The item to add
@@ -29,7 +70,7 @@ public:
      * @return bool True if successful, false if constraints violated
      */
     [[nodiscard]] bool add_item(const item& item, int max_items, double max_weight) noexcept {
-        int new_quantity = m_total_items + item.get_quantity();
+        const std::int64_t new_quantity = m_total_items + item.get_quantity();
         double new_weight = m_total_weight + item.get_total_weight();
 
         if (new_quantity <= max_items && new_weight <= max_weight) {
@@ -47,9 +88,9 @@ public:
      * @param item The item to add
      * @param max_items Maximum number of items allowed in the pack
      * @param max_weight Maximum weight allowed in the pack
-     * @return int Number of items successfully added
+     * @return std::int64_t Number of items successfully added
      */
-    [[nodiscard]] int add_partial_item(const item& item, int max_items, double max_weight) noexcept {
+    [[nodiscard]] std::int64_t add_partial_item(const item& item, int max_items, double max_weight) noexcept {
         return add_partial_item(item.get_id(), item.get_length(),
                                 item.get_quantity(), item.get_weight(), max_items, max_weight);
     }
@@ -62,41 +103,120 @@ public:
      * @param weight The item weight per piece
      * @param max_items Maximum number of items allowed in the pack
      * @param max_weight Maximum weight allowed in the pack
-     * @return int Number of items successfully added
+     * @return std::int64_t Number of items successfully added
      */
-    [[nodiscard]] int add_partial_item(int id, int length, int quantity, double weight,
-                                    int max_items, double max_weight) noexcept {
-        // SAFETY: Validate inputs to prevent negative values
-        if (quantity <= 0 || max_items <= 0 || max_weight < 0) {
-            return 0;
-        }
-
+    [[nodiscard]] std::int64_t add_partial_item(int id, int length, std::int64_t quantity, double weight,
+                                                int max_items, double max_weight) noexcept {
         // SAFETY: Ensure length is positive for valid packing
         length = std::max(1, length);
 
         // SAFETY: Ensure weight is non-negative
         weight = std::max(0.0, weight);
 
-        const int max_by_items = max_items - m_total_items;
-        const double weight_remaining = max_weight - m_total_weight;
-
-        // Handle zero weight case - if weight is 0, weight constraint doesn't apply
-        const int max_by_weight = (weight == 0.0) ? quantity :
-                                    static_cast<int>(weight_remaining / weight);
+        const std::int64_t can_add = fit_quantity(quantity, weight, m_total_items, m_total_weight,
+                                                  max_items, max_weight);
+        if (can_add > 0) {
+            m_items.emplace_back(id, length, can_add, weight);
+            m_total_items += can_add;
+            m_total_weight += static_cast<double>(can_add) * weight;
+            m_max_length = std::max(m_max_length, length);
+        }
+        return can_add;
+    }
 
-        // SAFETY: Ensure max_by_weight is non-negative to prevent underflow
-        const int safe_max_by_weight = std::max(0, max_by_weight);
+    /**
+     * @brief Try to add partial quantity of an item with fixed-point weights
+     * The capacity check is exact integer arithmetic. A pack should be filled
+     * through either this or the double overload, not both.
+     * @param id The item ID
+     * @param length The item length
+     * @param quantity The item quantity
+     * @param weight The item weight per piece in thousandths
+     * @param max_items Maximum number of items allowed in the pack
+     * @param max_weight Maximum weight allowed in the pack in thousandths
+     * @return std::int64_t Number of items successfully added
+     */
+    [[nodiscard]] std::int64_t add_partial_item_fixed(int id, int length, std::int64_t quantity, std::int64_t weight,
+                                                      int max_items, std::int64_t max_weight) noexcept {
+        // SAFETY: Same input clamping as add_partial_item
+        length = std::max(1, length);
+        weight = std::max<std::int64_t>(0, weight);
 
-        const int can_add = std::min({max_by_items, safe_max_by_weight, quantity});
+        const std::int64_t can_add = fit_quantity_fixed(quantity, weight, m_total_items, m_total_weight_fixed,
+                                                        max_items, max_weight);
         if (can_add > 0) {
-            m_items.emplace_back(id, length, can_add, weight);
+            m_items.emplace_back(id, length, can_add, fixed_weight::to_double(weight));
             m_total_items += can_add;
-            m_total_weight += can_add * weight;
+            m_total_weight_fixed += can_add * weight;
+            m_total_weight = fixed_weight::to_double(m_total_weight_fixed);
             m_max_length = std::max(m_max_length, length);
         }
         return can_add;
     }
 
+    /**
+     * @brief Compute how many pieces of an item fit into a partly filled pack
+     * Shared by pack and plan_arena so both fill packs identically.
+     * @param quantity Pieces offered
+     * @param weight Weight per piece (already clamped to >= 0)
+     * @param total_items Pieces already in the pack
+     * @param total_weight Weight already in the pack
+     * @param max_items Maximum number of items allowed in the pack
+     * @param max_weight Maximum weight allowed in the pack
+     * @return std::int64_t Number of pieces that fit (0 if none)
+     */
+    [[nodiscard]] static std::int64_t fit_quantity(std::int64_t quantity, double weight,
+                                                   std::int64_t total_items, double total_weight,
+                                                   int max_items, double max_weight) noexcept {
+        // SAFETY: Validate inputs to prevent negative values
+        if (quantity <= 0 || max_items <= 0 || max_weight < 0) {
+            return 0;
+        }
+
+        const std::int64_t max_by_items = max_items - total_items;
+        const double weight_remaining = max_weight - total_weight;
+
+        // Handle zero weight case - if weight is 0, weight constraint doesn't apply
+        const double by_weight = (weight == 0.0) ? static_cast<double>(quantity) : weight_remaining / weight;
+
+        // SAFETY: Bound by quantity before narrowing (a light piece in a huge pack
+        // overflows the integer); negative or NaN room fits nothing
+        const std::int64_t safe_max_by_weight = by_weight >= static_cast<double>(quantity) ? quantity :
+                                                by_weight > 0.0 ? static_cast<std::int64_t>(by_weight) : 0;
+
+        return std::min({max_by_items, safe_max_by_weight, quantity});
+    }
+
+    /**
+     * @brief Integer counterpart of fit_quantity for fixed-point weights
+     * @param quantity Pieces offered
+     * @param weight Weight per piece in thousandths (already clamped to >= 0)
+     * @param total_items Pieces already in the pack
+     * @param total_weight Weight already in the pack in thousandths
+     * @param max_items Maximum number of items allowed in the pack
+     * @param max_weight Maximum weight allowed in the pack in thousandths
+     * @return std::int64_t Number of pieces that fit (0 if none)
+     */
+    [[nodiscard]] static std::int64_t fit_quantity_fixed(std::int64_t quantity, std::int64_t weight,
+                                                         std::int64_t total_items, std::int64_t total_weight,
+                                                         int max_items, std::int64_t max_weight) noexcept {
+        // SAFETY: Validate inputs to prevent negative values
+        if (quantity <= 0 || max_items <= 0 || max_weight < 0) {
+            return 0;
+        }
+
+        const std::int64_t max_by_items = max_items - total_items;
+        const std::int64_t weight_remaining = max_weight - total_weight;
+
+        // Zero weight never limits
+        const std::int64_t max_by_weight = (weight == 0) ? quantity : weight_remaining / weight;
+
+        // SAFETY: Ensure max_by_weight is non-negative to prevent underflow
+        const std::int64_t safe_max_by_weight = std::max<std::int64_t>(0, max_by_weight);
+
+        return std::min({max_by_items, safe_max_by_weight, quantity});
+    }
+
     /**
      * @brief Check if the pack is full
      * @param max_items Maximum number of items allowed in the pack
@@ -108,29 +228,45 @@ public:
         return m_total_items >= max_items || m_total_weight >= max_weight - 1e-9;
     }
 
+    /**
+     * @brief Check if a pack filled with fixed-point weights is full (exact, no epsilon)
+     * @param max_items Maximum number of items allowed in the pack
+     * @param max_weight Maximum weight allowed in the pack in thousandths
+     * @return bool True if the pack is full
+     */
+    [[nodiscard]] bool is_full_fixed(int max_items, std::int64_t max_weight) const noexcept {
+        return m_total_items >= max_items || m_total_weight_fixed >= max_weight;
+    }
+
     /**
      * @brief Get the pack number
-     * @return int The pack number
+     * @return std::int64_t The pack number
      */
-    [[nodiscard]] int get_pack_number() const noexcept { return m_pack_number; }
+    [[nodiscard]] std::int64_t get_pack_number() const noexcept { return m_pack_number; }
 
     /**
      * @brief Set the pack number
      * @param pack_number The pack number
      */
-    void set_pack_number(int pack_number) { m_pack_number = pack_number; }
+    void set_pack_number(std::int64_t pack_number) { m_pack_number = pack_number; }
 
     /**
      * @brief Get the items in the pack
-     * @return const std::vector<Item>& Reference to the items vector
+     * @return const std::pmr::vector<item>& Reference to the items vector
      */
-    [[nodiscard]] const std::vector<item>& get_items() const noexcept { return m_items; }
+    [[nodiscard]] const std::pmr::vector<item>& get_items() const noexcept { return m_items; }
+
+    /**
+     * @brief Get the allocator of the item list
+     * @return allocator_type Allocator wrapping the pack's memory resource
+     */
+    [[nodiscard]] allocator_type get_allocator() const noexcept { return m_items.get_allocator(); }
 
     /**
      * @brief Get the total number of items in the pack
-     * @return int Total number of items
+     * @return std::int64_t Total number of items
      */
-    [[nodiscard]] int get_total_items() const noexcept { return m_total_items; }
+    [[nodiscard]] std::int64_t get_total_items() const noexcept { return m_total_items; }
 
     /**
      * @brief Get the total weight of the pack
@@ -138,6 +274,12 @@ public:
      */
     [[nodiscard]] double get_total_weight() const noexcept { return m_total_weight; }
 
+    /**
+     * @brief Get the total weight added through add_partial_item_fixed
+     * @return std::int64_t Total weight in thousandths
+     */
+    [[nodiscard]] std::int64_t get_total_weight_fixed() const noexcept { return m_total_weight_fixed; }
+
     /**
      * @brief Get the maximum length of any item in the pack
      * @return int Maximum length
@@ -180,16 +322,17 @@ public:
     /**
      * @brief Get the remaining capacity capacity based on the given maximum capacity
      * @param max_items Maximum capacity
-     * @return int The remaining capacity in this Pack
+     * @return std::int64_t The remaining capacity in this Pack
      */
-    [[nodiscard]] int get_remaining_item_capacity(int max_items) const noexcept {
+    [[nodiscard]] std::int64_t get_remaining_item_capacity(int max_items) const noexcept {
         return max_items - get_total_items();
     }
 
 private:
-    int m_pack_number = 0;
-    std::vector<item> m_items;
-    int m_total_items = 0;
+    std::int64_t m_pack_number = 0;
+    std::pmr::vector<item> m_items;
+    std::int64_t m_total_items = 0;
     double m_total_weight = 0.0;
+    std::int64_t m_total_weight_fixed = 0;
     int m_max_length = 0;
 };
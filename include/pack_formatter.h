@@ -0,0 +1,191 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <ostream>
+#include "item.h"
+#include "pack.h"
+
+/**
+ * @brief Buffered text renderer for packs in the spec output format
+ * Lines are written with std::to_chars straight into one reusable buffer that
+ * is handed to the output stream in multi-megabyte blocks. The bytes are
+ * identical to pack::to_string() followed by a newline.
+ */
+class pack_formatter {
+public:
+    // Flush threshold; large enough that stream overhead is negligible
+    static constexpr size_t DEFAULT_BLOCK_BYTES = 4 << 20;
+
+    // Upper bound for one rendered line: four ints plus a fixed-format double
+    // (DBL_MAX prints 309 integer digits) and the separators
+    static constexpr size_t MAX_LINE_BYTES = 384;
+
+    /**
+     * @brief Construct a new formatter
+     * @param output Stream receiving the rendered blocks
+     * @param block_bytes Buffer size; a block is flushed when it is (nearly) full
+     */
+    explicit pack_formatter(std::ostream& output, size_t block_bytes = DEFAULT_BLOCK_BYTES)
+        : m_output(output),
+          m_capacity(std::max(block_bytes, MAX_LINE_BYTES * 2)),
+          m_buffer(std::make_unique<char[]>(m_capacity)) {}
+
+    ~pack_formatter() {
+        flush();
+    }
+
+    pack_formatter(const pack_formatter&) = delete;
+    pack_formatter& operator=(const pack_formatter&) = delete;
+
+    /**
+     * @brief Render one pack (header, item lines, footer)
+     * @param p Pack to render (pack or plan_arena::pack_ref)
+     */
+    template <typename Pack>
+    void write_pack(const Pack& p) {
+        for_each_line(p, [this](auto&& format_line) {
+            reserve_line();
+            m_size = format_line(m_buffer.get() + m_size) - m_buffer.get();
+        });
+    }
+
+    /**
+     * @brief Write buffered bytes to the stream and flush it
+     */
+    void flush() {
+        write_block();
+        m_output.flush();
+    }
+
+    /**
+     * @brief Get the exact number of bytes write_pack() produces for a pack
+     * @param p Pack to measure
+     * @return size_t Rendered size in bytes
+     */
+    template <typename Pack>
+    [[nodiscard]] static size_t measure_pack(const Pack& p) noexcept {
+        char line[MAX_LINE_BYTES];
+        size_t total = 0;
+        for_each_line(p, [&](auto&& format_line) {
+            total += static_cast<size_t>(format_line(line) - line);
+        });
+        return total;
+    }
+
+    /**
+     * @brief Render a pack into caller-owned memory without writing past end
+     * Lines close to the end are staged on the stack, so [out, end) may be
+     * sized exactly with measure_pack(). If the range is too small the output
+     * is truncated at end and the returned pointer lies past end.
+     * @param out Destination
+     * @param end End of the writable range
+     * @param p Pack to render
+     * @return char* One past the last written byte
+     */
+    template <typename Pack>
+    static char* render_pack(char* out, const char* end, const Pack& p) noexcept {
+        for_each_line(p, [&](auto&& format_line) {
+            const size_t available = out < end ? static_cast<size_t>(end - out) : 0;
+            if (available >= MAX_LINE_BYTES) {
+                out = format_line(out);
+            } else {
+                // SAFETY: Never touch bytes past end, even if the range was undersized
+                char line[MAX_LINE_BYTES];
+                const size_t length = static_cast<size_t>(format_line(line) - line);
+                std::memcpy(out, line, std::min(length, available));
+                out += length;
+            }
+        });
+        return out;
+    }
+
+    /**
+     * @brief Render "Pack Number: N\n"
+     * @param out Destination with at least MAX_LINE_BYTES free
+     * @return char* One past the last written byte
+     */
+    static char* format_pack_header(char* out, std::int64_t pack_number) noexcept {
+        out = append(out, "Pack Number: ");
+        out = std::to_chars(out, out + 24, pack_number).ptr;
+        *out++ = '\n';
+        return out;
+    }
+
+    /**
+     * @brief Render "id,length,quantity,weight\n" with 3 weight decimals
+     * @param out Destination with at least MAX_LINE_BYTES free
+     * @return char* One past the last written byte
+     */
+    static char* format_item(char* out, int id, int length, std::int64_t quantity, double weight) noexcept {
+        char* const limit = out + MAX_LINE_BYTES;
+        // Integers get their exact worst-case width (sign and digits)
+        out = std::to_chars(out, out + 11, id).ptr;
+        *out++ = ',';
+        out = std::to_chars(out, out + 11, length).ptr;
+        *out++ = ',';
+        out = std::to_chars(out, out + 20, quantity).ptr;
+        *out++ = ',';
+        out = std::to_chars(out, limit, weight, std::chars_format::fixed, 3).ptr;
+        *out++ = '\n';
+        return out;
+    }
+
+    /**
+     * @brief Render "Pack Length: L, Pack Weight: W\n" with 2 weight decimals
+     * @param out Destination with at least MAX_LINE_BYTES free
+     * @return char* One past the last written byte
+     */
+    static char* format_pack_footer(char* out, int pack_length, double pack_weight) noexcept {
+        char* const limit = out + MAX_LINE_BYTES;
+        out = append(out, "Pack Length: ");
+        out = std::to_chars(out, limit, pack_length).ptr;
+        out = append(out, ", Pack Weight: ");
+        out = std::to_chars(out, limit, pack_weight, std::chars_format::fixed, 2).ptr;
+        *out++ = '\n';
+        return out;
+    }
+
+private:
+    // Calls emit(format_line) for every output line of a pack, where
+    // format_line(char* out) renders the line and returns its end
+    template <typename Pack, typename Emit>
+    static void for_each_line(const Pack& p, Emit&& emit) {
+        emit([&p](char* out) { return format_pack_header(out, p.get_pack_number()); });
+        for (const auto& i : p.get_items()) {
+            emit([&i](char* out) {
+                return format_item(out, i.get_id(), i.get_length(), i.get_quantity(), i.get_weight());
+            });
+        }
+        emit([&p](char* out) {
+            return format_pack_footer(out, p.get_pack_length(), p.get_total_weight());
+        });
+    }
+
+    template <size_t N>
+    static char* append(char* out, const char (&text)[N]) noexcept {
+        std::memcpy(out, text, N - 1);
+        return out + N - 1;
+    }
+
+    void reserve_line() {
+        if (m_capacity - m_size < MAX_LINE_BYTES) {
+            write_block();
+        }
+    }
+
+    void write_block() {
+        if (m_size > 0) {
+            m_output.write(m_buffer.get(), static_cast<std::streamsize>(m_size));
+            m_size = 0;
+        }
+    }
+
+    std::ostream& m_output;
+    size_t m_capacity;
+    size_t m_size = 0;
+    std::unique_ptr<char[]> m_buffer;
+};
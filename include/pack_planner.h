@@ -2,11 +2,24 @@
 
 #include <vector>
 #include <string>
+#include <string_view>
+#include <charconv>
+#include <cctype>
 #include <iostream>
 #include <memory>
+#include <memory_resource>
+#include <optional>
+#include <type_traits>
 #include "item.h"
+#include "item_column_view.h"
+#include "item_columns.h"
 #include "pack.h"
+#include "pack_formatter.h"
+#include "plan_arena.h"
+#include "range_plan.h"
+#include "streaming_packer.h"
 #include "sort_order.h"
+#include "weight_mode.h"
 #include "pack_strategy.h"
 #include "timer.h"
 #include "optimized_sort.h"
@@ -20,22 +33,72 @@ struct pack_planner_config {
     double max_weight_per_pack = 200.0;
     strategy_type type = strategy_type::BLOCKING_FIRST_FIT;
     int thread_count = 4;
+    weight_mode weights = weight_mode::FLOATING;
 
     // C++20: default all comparisons
     auto operator<=>(const pack_planner_config&) const = default;
 };
 
+/**
+ * @brief Parse the spec header line "[sort order],[max pieces],[max weight]"
+ * Only the three fields are overwritten; strategy and thread count are kept.
+ * @param line Header line (trailing whitespace/CR allowed)
+ * @param config Configuration to update
+ * @return bool True if the line was a valid header
+ */
+[[nodiscard]] inline bool parse_config_header(std::string_view line, pack_planner_config& config) noexcept {
+    auto trim = [](std::string_view s) {
+        while (!s.empty() && std::isspace(static_cast<unsigned char>(s.front()))) s.remove_prefix(1);
+        while (!s.empty() && std::isspace(static_cast<unsigned char>(s.back()))) s.remove_suffix(1);
+        return s;
+    };
+
+    const size_t first_comma = line.find(',');
+    const size_t second_comma = first_comma == std::string_view::npos ?
+                                    std::string_view::npos : line.find(',', first_comma + 1);
+    if (second_comma == std::string_view::npos) return false;
+
+    const std::string_view order = trim(line.substr(0, first_comma));
+    const std::string_view pieces = trim(line.substr(first_comma + 1, second_comma - first_comma - 1));
+    const std::string_view weight = trim(line.substr(second_comma + 1));
+
+    // parse_sort_order() falls back to NATURAL, so match the names explicitly
+    sort_order parsed_order;
+    if (order == "NATURAL") parsed_order = sort_order::NATURAL;
+    else if (order == "SHORT_TO_LONG") parsed_order = sort_order::SHORT_TO_LONG;
+    else if (order == "LONG_TO_SHORT") parsed_order = sort_order::LONG_TO_SHORT;
+    else return false;
+
+    int max_items = 0;
+    double max_weight = 0.0;
+    auto [items_end, items_ec] = std::from_chars(pieces.data(), pieces.data() + pieces.size(), max_items);
+    auto [weight_end, weight_ec] = std::from_chars(weight.data(), weight.data() + weight.size(), max_weight);
+    if (items_ec != std::errc() || items_end != pieces.data() + pieces.size() ||
+        weight_ec != std::errc() || weight_end != weight.data() + weight.size()) {
+        return false;
+    }
+
+    config.order = parsed_order;
+    config.max_items_per_pack = max_items;
+    config.max_weight_per_pack = max_weight;
+    return true;
+}
+
 /**
  * @brief Results of the pack planning process
+ * When planned with a memory resource, the packs' item lists live in that
+ * resource and the result must be destroyed before the resource is.
  */
 struct pack_planner_result {
     std::vector<pack> packs;
     double sorting_time;
     double packing_time;
     double total_time;
-    int total_items;
+    std::int64_t total_items;
     double utilization_percent;
     std::string strategy_name;
+    std::int64_t unplaced_items = 0;  // input pieces no pack holds
+    std::string error;             // why pieces were not packed; empty if all were
 };
 
 /**
@@ -56,50 +119,123 @@ public:
      * @return pack_planner_result Results of the planning process
      */
     [[nodiscard]] pack_planner_result plan_packs(const pack_planner_config& config,
-                                                std::vector<item> items) {
+                                                const std::vector<item>& items) {
+        return plan_packs(config, item_columns(items));
+    }
+
+    /**
+     * @brief Plan packs with given configuration and column-stored items
+     * Sorting permutes the columns and the strategy reads them directly.
+     * @param config Configuration for planning
+     * @param items Items to pack
+     * @return pack_planner_result Results of the planning process
+     */
+    [[nodiscard]] pack_planner_result plan_packs(const pack_planner_config& config,
+                                                item_columns items) {
+        return plan_packs(config, std::move(items), std::pmr::get_default_resource());
+    }
+
+    /**
+     * @brief Plan packs, allocating every pack's item list from a memory resource
+     * With a std::pmr::monotonic_buffer_resource per request, building the
+     * plan is a pointer bump per pack and freeing it is one release().
+     * @param config Configuration for planning
+     * @param items Items to pack
+     * @param resource Resource for the packs; must outlive the result
+     * @return pack_planner_result Results of the planning process
+     */
+    [[nodiscard]] pack_planner_result plan_packs(const pack_planner_config& config,
+                                                item_columns items,
+                                                std::pmr::memory_resource* resource) {
         pack_planner_result result;
-        m_timer.start();
+        plan_into(config, items, result.packs, result, resource);
+        return result;
+    }
 
-        // SAFETY: Validate and sanitize configuration
-        pack_planner_config safe_config = config;
-        safe_config.max_items_per_pack = std::max(1, config.max_items_per_pack);
-        safe_config.max_weight_per_pack = std::max(0.1, config.max_weight_per_pack);
-        safe_config.thread_count = std::clamp(config.thread_count, 1, 32);
+    /**
+     * @brief Plan packs into a flat plan arena instead of per-pack vectors
+     * The packs are appended to out; the returned result carries the timings
+     * and statistics and leaves its packs vector empty.
+     * @param config Configuration for planning
+     * @param items Items to pack
+     * @param out Arena receiving the packs
+     * @return pack_planner_result Timings and statistics of the planning process
+     */
+    [[nodiscard]] pack_planner_result plan_packs(const pack_planner_config& config,
+                                                item_columns items, plan_arena& out) {
+        pack_planner_result result;
+        plan_into(config, items, out, result);
+        return result;
+    }
 
-        // Sort items
-        timer sort_timer;
-        sort_timer.start();
-        sort_items(items, safe_config.order);
-        result.sorting_time = sort_timer.stop();
+    /**
+     * @brief Plan packs as contiguous ranges (O(packs) plan memory)
+     * items is sorted in place and the ranges index it, so it must outlive
+     * any range_plan_view(out, items.view()) used to expand the packs.
+     * @param config Configuration for planning
+     * @param items Items to pack (sorted in place)
+     * @param out Range plan receiving the packs
+     * @return std::optional<pack_planner_result> Timings and statistics, or
+     *         std::nullopt if the configured strategy cannot produce ranges
+     */
+    [[nodiscard]] std::optional<pack_planner_result> plan_packs(const pack_planner_config& config,
+                                                               item_columns& items, range_plan& out) {
+        pack_planner_result result;
+        if (!plan_into(config, items, out, result)) {
+            return std::nullopt;
+        }
+        return result;
+    }
 
-        // Create or reuse strategy if config changed
-        if (!m_strategy || config != m_config) {
-            m_strategy = pack_strategy_factory::create_strategy(safe_config.type, safe_config.thread_count);
-            m_config = safe_config;
+    /**
+     * @brief Plan packs directly from column storage (e.g. a mapped binary item file)
+     * NATURAL order with a streaming strategy and floating weights packs the
+     * rows in place without materializing items; other configurations copy
+     * the rows and use the regular path.
+     * @param config Configuration for planning
+     * @param columns Items to pack
+     * @return pack_planner_result Results of the planning process
+     */
+    [[nodiscard]] pack_planner_result plan_packs(const pack_planner_config& config,
+                                                const item_column_view& columns) {
+        if (config.order != sort_order::NATURAL || config.weights != weight_mode::FLOATING ||
+            !pack_strategy_factory::is_streaming_strategy(config.type)) {
+            return plan_packs(config, item_columns(columns));
         }
 
-        result.strategy_name = m_strategy->get_name();
+        pack_planner_result result;
+        m_timer.start();
+
+        const int max_items = std::max(1, config.max_items_per_pack);
+        const double max_weight = std::max(0.1, config.max_weight_per_pack);
 
-        // Pack
         timer pack_timer;
         pack_timer.start();
-        result.packs = m_strategy->pack_items(items, safe_config.max_items_per_pack, safe_config.max_weight_per_pack);
+        streaming_packer packer(max_items, max_weight,
+                                [&result](const pack& p) { result.packs.push_back(p); });
+        for (size_t i = 0; i < columns.size(); ++i) {
+            const size_t row = columns.row(i);
+            packer.add_item(columns.ids[row], columns.lengths[row],
+                            columns.quantities[row], columns.weights[row]);
+        }
+        packer.finish();
         result.packing_time = pack_timer.stop();
 
+        result.strategy_name = pack_strategy_factory::strategy_type_to_string(config.type);
         result.total_time = m_timer.stop();
 
-        // SAFETY: Calculate total items safely
-        result.total_items = 0;
-        for (const auto& i : items) {
-            // SAFETY: Skip negative quantities and avoid overflow
-            if (i.get_quantity() > 0 &&
-                result.total_items <= std::numeric_limits<int>::max() - i.get_quantity()) {
-                result.total_items += i.get_quantity();
+        std::int64_t total_items = 0;
+        for (size_t i = 0; i < columns.size(); ++i) {
+            if (columns.quantities[i] > 0) {
+                total_items += columns.quantities[i];
             }
         }
+        result.total_items = total_items;
 
-        result.utilization_percent = calculate_utilization(result.packs, safe_config.max_weight_per_pack);
-
+        result.utilization_percent = calculate_utilization(result.packs, max_weight);
+        pack_planner_config safe_config = config;
+        safe_config.max_weight_per_pack = max_weight;
+        report_unplaced(result, columns, safe_config, packer.get_unplaced_items());
         return result;
     }
 
@@ -109,25 +245,58 @@ public:
      * @param output Output stream (defaults to std::cout)
      */
     void output_results(const std::vector<pack>& packs, std::ostream& output = std::cout) const {
+        pack_formatter formatter(output);
         for (const auto& p : packs) {
             if (!p.is_empty()) {
-                output << p.to_string() << std::endl;
+                formatter.write_pack(p);
             }
         }
+        formatter.flush();
+    }
+
+    /**
+     * @brief Output results held in a plan arena to a stream
+     * @param packs Packs to output
+     * @param output Output stream (defaults to std::cout)
+     */
+    void output_results(const plan_arena& packs, std::ostream& output = std::cout) const {
+        pack_formatter formatter(output);
+        for (const auto p : packs) {
+            if (!p.is_empty()) {
+                formatter.write_pack(p);
+            }
+        }
+        formatter.flush();
+    }
+
+    /**
+     * @brief Output the packs of a range plan to a stream, expanding them lazily
+     * @param packs View over the range plan and its items
+     * @param output Output stream (defaults to std::cout)
+     */
+    void output_results(const range_plan_view& packs, std::ostream& output = std::cout) const {
+        pack_formatter formatter(output);
+        for (const auto p : packs) {
+            if (!p.is_empty()) {
+                formatter.write_pack(p);
+            }
+        }
+        formatter.flush();
     }
 
     /**
      * @brief Calculate utilization percentage
-     * @param packs Packs to calculate utilization for
+     * @param packs Packs to calculate utilization for (std::vector<pack>, plan_arena or range_plan_view)
      * @param max_weight Maximum weight per pack
      * @return double Utilization percentage
      */
-    [[nodiscard]] double calculate_utilization(const std::vector<pack>& packs,
+    template <typename Packs>
+    [[nodiscard]] double calculate_utilization(const Packs& packs,
                                             double max_weight) const noexcept {
         if (packs.empty() || max_weight <= 0.0) return 0.0;
 
         double total_weight = 0.0;
-        int non_empty_packs = 0;
+        std::int64_t non_empty_packs = 0;
 
         for (const auto& p : packs) {
             if (!p.is_empty()) {
@@ -142,7 +311,7 @@ public:
 
         if (non_empty_packs == 0) return 0.0;
 
-        double max_possible_weight = non_empty_packs * max_weight;
+        double max_possible_weight = static_cast<double>(non_empty_packs) * max_weight;
 
         // SAFETY: Avoid division by zero
         if (max_possible_weight <= 0.0) return 0.0;
@@ -152,30 +321,130 @@ public:
     }
 
 private:
+    /**
+     * @brief Sort, pack and fill in the statistics
+     * @param config Configuration for planning
+     * @param items Items to pack (sorted in place)
+     * @param packs Receives the packs (std::vector<pack>, plan_arena or range_plan)
+     * @param result Receives timings and statistics
+     * @param resource Resource for the item lists of vector plans
+     * @return bool False if the strategy cannot fill this kind of plan
+     */
+    template <typename Plan>
+    bool plan_into(const pack_planner_config& config, item_columns& items, Plan& packs,
+                   pack_planner_result& result,
+                   std::pmr::memory_resource* resource = std::pmr::get_default_resource()) {
+        m_timer.start();
+
+        // SAFETY: Validate and sanitize configuration
+        pack_planner_config safe_config = config;
+        safe_config.max_items_per_pack = std::max(1, config.max_items_per_pack);
+        safe_config.max_weight_per_pack = std::max(0.1, config.max_weight_per_pack);
+        safe_config.thread_count = std::clamp(config.thread_count, 1, 32);
+
+        // Sort items
+        timer sort_timer;
+        sort_timer.start();
+        sort_items(items, safe_config.order);
+        result.sorting_time = sort_timer.stop();
+
+        // Create or reuse strategy if config changed
+        if (!m_strategy || config != m_config) {
+            m_strategy = pack_strategy_factory::create_strategy(safe_config.type, safe_config.thread_count,
+                                                                safe_config.weights);
+            m_config = safe_config;
+        }
+
+        result.strategy_name = m_strategy->get_name();
+        m_strategy->set_memory_resource(resource);
+
+        // Pack
+        timer pack_timer;
+        pack_timer.start();
+        if constexpr (std::is_same_v<Plan, plan_arena>) {
+            m_strategy->pack_items(items.view(), safe_config.max_items_per_pack,
+                                   safe_config.max_weight_per_pack, packs);
+        } else if constexpr (std::is_same_v<Plan, range_plan>) {
+            if (!m_strategy->pack_items(items.view(), safe_config.max_items_per_pack,
+                                        safe_config.max_weight_per_pack, packs)) {
+                return false;
+            }
+        } else {
+            packs = m_strategy->pack_items(items.view(), safe_config.max_items_per_pack,
+                                           safe_config.max_weight_per_pack);
+        }
+        result.packing_time = pack_timer.stop();
+
+        result.total_time = m_timer.stop();
+
+        const std::int64_t total_items = items.total_quantity();
+        result.total_items = total_items;
+
+        if constexpr (std::is_same_v<Plan, range_plan>) {
+            const range_plan_view view(packs, items.view());
+            result.utilization_percent = calculate_utilization(view, safe_config.max_weight_per_pack);
+            report_unplaced(result, items.view(), safe_config, total_items - placed_items(view));
+        } else {
+            result.utilization_percent = calculate_utilization(packs, safe_config.max_weight_per_pack);
+            report_unplaced(result, items.view(), safe_config, total_items - placed_items(packs));
+        }
+        return true;
+    }
+
+    /**
+     * @brief Count the pieces held by a plan's packs
+     * @param packs Packs (std::vector<pack>, plan_arena or range_plan_view)
+     * @return std::int64_t Total pieces packed
+     */
+    template <typename Packs>
+    [[nodiscard]] static std::int64_t placed_items(const Packs& packs) noexcept {
+        std::int64_t placed = 0;
+        for (const auto& p : packs) {
+            placed += p.get_total_items();
+        }
+        return placed;
+    }
+
+    /**
+     * @brief Record pieces the plan does not hold, and why
+     * The loops only leave out pieces heavier than a whole pack.
+     * @param result Receives unplaced_items and error
+     * @param items The items that were packed
+     * @param config Sanitized configuration used for packing
+     * @param unplaced Input pieces minus packed pieces
+     */
+    static void report_unplaced(pack_planner_result& result, const item_column_view& items,
+                                const pack_planner_config& config, std::int64_t unplaced) {
+        result.unplaced_items = unplaced;
+        if (unplaced <= 0) return;
+
+        std::int64_t too_heavy = 0;
+        for (size_t i = 0; i < items.size(); ++i) {
+            if (items.quantities[i] > 0 &&
+                exceeds_weight_limit(items.weights[i], config.max_weight_per_pack, config.weights)) {
+                too_heavy += items.quantities[i];
+            }
+        }
+
+        result.error = std::to_string(unplaced) + " pieces were not packed";
+        if (too_heavy > 0) {
+            result.error += ": " + std::to_string(too_heavy) + " weigh more than a pack's weight limit";
+        }
+    }
+
     /**
      * @brief Sort items according to sort order
      * @param items Items to sort
      * @param order Sort order to use
      */
-    void sort_items(std::vector<item>& items, sort_order order) noexcept {
+    void sort_items(item_columns& items, sort_order order) noexcept {
         switch (order) {
         case sort_order::SHORT_TO_LONG:
-#ifdef __AVX2__
-            // Use SIMD-optimized RadixSort for best performance
-            optimized_sort::SIMDRadixSortV2::sort_by_length(items, true);
-#else
-            // Fall back to regular RadixSort
-            optimized_sort::RadixSort::sort_by_length(items, true);
-#endif
+            optimized_sort::ColumnRadixSort::sort_by_length(items, true);
             break;
         case sort_order::LONG_TO_SHORT:
-#ifdef __AVX2__
-            // Use SIMD-optimized RadixSort for best performance
-            optimized_sort::SIMDRadixSortV2::sort_by_length(items, false);
-#else
-            // Fall back to regular RadixSort
-            optimized_sort::RadixSort::sort_by_length(items, false);
-#endif
+            optimized_sort::ColumnRadixSort::sort_by_length(items, false);
+            break;
         case sort_order::NATURAL:
         default:
             // Keep original order
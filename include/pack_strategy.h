@@ -1,15 +1,26 @@
 #pragma once
 
 #include <vector>
+#include <algorithm>
+#include <cstdint>
 #include <memory>
+#include <memory_resource>
+#include <type_traits>
 #include "item.h"
+#include "item_columns.h"
 #include "pack.h"
+#include "plan_arena.h"
+#include "range_plan.h"
+#include "weight_mode.h"
 
 enum class strategy_type {
     BLOCKING_FIRST_FIT,
     PARALLEL_FIRST_FIT,
     LOCKFREE_FIRST_FIT,
-    BLOCKING_NEXT_FIT
+    BLOCKING_NEXT_FIT,
+    FIRST_FIT,         // true first-fit: the lowest-numbered pack with room
+    BEST_FIT,          // the pack with the least remaining weight that still fits
+    BOUNDED_BEST_FIT   // best-fit over a fixed number of open packs
 };
 
 /**
@@ -21,22 +32,242 @@ public:
 
     /**
      * @brief Pack items using the specific strategy
-     * @param items Items to pack
+     * @param items Items to pack, stored column-wise
      * @param max_items Maximum items per pack
      * @param max_weight Maximum weight per pack
      * @return std::vector<pack> Vector of packed items
      */
-    virtual std::vector<pack> pack_items(const std::vector<item>& items,
+    virtual std::vector<pack> pack_items(const item_column_view& items,
                                        int max_items,
                                        double max_weight) = 0;
 
+    /**
+     * @brief Pack items, appending the packs to a flat plan arena
+     * The default copies the packs of the vector overload; the next-fit
+     * style strategies fill the arena directly.
+     * @param items Items to pack, stored column-wise
+     * @param max_items Maximum items per pack
+     * @param max_weight Maximum weight per pack
+     * @param out Arena receiving the packs
+     */
+    virtual void pack_items(const item_column_view& items,
+                            int max_items,
+                            double max_weight,
+                            plan_arena& out) {
+        for (const auto& p : pack_items(items, max_items, max_weight)) {
+            out.append(p);
+        }
+    }
+
+    /**
+     * @brief Pack items into a range plan (one contiguous run per pack)
+     * Only strategies that fill packs from a single cursor over the items can
+     * produce ranges; the default reports that this one cannot. out records
+     * max_weight and the weight mode so its view can expand the packs.
+     * @param items Items to pack, stored column-wise
+     * @param max_items Maximum items per pack
+     * @param max_weight Maximum weight per pack
+     * @param out Range plan receiving the packs
+     * @return bool False if the strategy does not support range plans
+     */
+    virtual bool pack_items(const item_column_view&, int, double, range_plan&) {
+        return false;
+    }
+
+    /**
+     * @brief Pack items held as item records (copies them into columns first)
+     * @param items Items to pack
+     * @param max_items Maximum items per pack
+     * @param max_weight Maximum weight per pack
+     * @return std::vector<pack> Vector of packed items
+     */
+    std::vector<pack> pack_items(const std::vector<item>& items,
+                                 int max_items,
+                                 double max_weight) {
+        const item_columns columns(items);
+        return pack_items(columns.view(), max_items, max_weight);
+    }
+
     /**
      * @brief Get strategy name for identification
      * @return std::string Strategy name
      */
     virtual std::string get_name() const = 0;
+
+    /**
+     * @brief Select the numeric representation of weights while packing
+     * @param mode FLOATING (default) or FIXED_POINT
+     */
+    void set_weight_mode(weight_mode mode) noexcept { m_weight_mode = mode; }
+
+    /**
+     * @brief Get the numeric representation of weights while packing
+     * @return weight_mode The current mode
+     */
+    [[nodiscard]] weight_mode get_weight_mode() const noexcept { return m_weight_mode; }
+
+    /**
+     * @brief Allocate the item lists of vector plans from a memory resource
+     * The resource must outlive the returned packs and is only used from one
+     * thread at a time; nullptr selects the default resource.
+     * @param resource Memory resource, e.g. a per-request monotonic arena
+     */
+    void set_memory_resource(std::pmr::memory_resource* resource) noexcept { m_resource = resource; }
+
+    /**
+     * @brief Get the memory resource used for vector plans
+     * @return std::pmr::memory_resource* The resource (never nullptr)
+     */
+    [[nodiscard]] std::pmr::memory_resource* get_memory_resource() const noexcept {
+        return m_resource ? m_resource : std::pmr::get_default_resource();
+    }
+
+protected:
+    /**
+     * @brief Call fn with the weight policy (floating_weights or fixed_weights) of the current mode
+     * @param fn Generic callable taking the policy tag by value
+     */
+    template <typename Fn>
+    void with_weight_policy(Fn&& fn) const {
+        if (m_weight_mode == weight_mode::FIXED_POINT) {
+            fn(fixed_weights{});
+        } else {
+            fn(floating_weights{});
+        }
+    }
+
+private:
+    weight_mode m_weight_mode = weight_mode::FLOATING;
+    std::pmr::memory_resource* m_resource = nullptr;
 };
 
+/**
+ * @brief Open a new pack at the end of a vector plan, allocating from resource
+ * @param packs Plan to extend
+ * @param pack_number The pack identifier
+ * @param resource Memory resource for the pack's item list
+ */
+inline void start_pack(std::vector<pack>& packs, std::int64_t pack_number, std::pmr::memory_resource* resource) {
+    packs.emplace_back(pack_number, resource);
+}
+
+/**
+ * @brief Open a new pack at the end of a plan arena (which owns its storage)
+ * @param packs Plan to extend
+ * @param pack_number The pack identifier
+ */
+inline void start_pack(plan_arena& packs, std::int64_t pack_number, std::pmr::memory_resource*) {
+    packs.emplace_back(pack_number);
+}
+
+/**
+ * @brief Open a new pack at the end of a range plan
+ * @param packs Plan to extend
+ * @param pack_number The pack identifier
+ */
+inline void start_pack(range_plan& packs, std::int64_t pack_number, std::pmr::memory_resource*) {
+    packs.emplace_back(pack_number);
+}
+
+/**
+ * @brief Reserve a plan from an O(n) estimate of its size
+ * No plan has fewer packs than pieces / max_items or total weight /
+ * max_weight. Next-fit stays within a few percent of that bound on typical
+ * inputs, so the bound plus 1/8 headroom is reserved; a plan that needs
+ * more grows. A loop walking the rows in order makes at most rows + packs
+ * placements. The pack estimate is capped at twice the row count so a
+ * single huge quantity reserves nothing absurd.
+ * @param packs Plan to reserve (std::vector<pack>, plan_arena or range_plan)
+ * @param items Items about to be packed
+ * @param begin First position to be packed
+ * @param end One past the last position
+ * @param max_items Maximum items per pack
+ * @param max_weight Maximum weight per pack
+ */
+template <typename Plan>
+inline void reserve_plan(Plan& packs, const item_column_view& items, size_t begin, size_t end,
+                         int max_items, double max_weight) {
+    double pieces = 0.0;
+    double weight = 0.0;
+    for (size_t i = begin; i < end; ++i) {
+        const size_t row = items.row(i);
+        const std::int64_t quantity = items.quantities[row];
+        const double piece_weight = items.weights[row];
+        // Rows the loop skips add nothing (NaN weights count as weightless)
+        if (quantity <= 0 || piece_weight > max_weight) continue;
+        pieces += static_cast<double>(quantity);
+        weight += piece_weight > 0.0 ? static_cast<double>(quantity) * piece_weight : 0.0;
+    }
+
+    const size_t rows = end - begin;
+    const double bound = std::max(pieces / std::max(1, max_items), weight / std::max(0.1, max_weight));
+    const size_t pack_count =
+        static_cast<size_t>(std::min(bound * 1.125, 2.0 * static_cast<double>(rows))) + 1;
+    if constexpr (std::is_same_v<Plan, plan_arena>) {
+        packs.reserve(packs.size() + pack_count, packs.placements().size() + rows + pack_count);
+    } else {
+        packs.reserve(packs.size() + pack_count);
+    }
+}
+
+/**
+ * @brief Tell the plan which position the packing loop is about to place
+ * Only range plans record it; other plans ignore the call.
+ * @param packs Plan being filled
+ * @param position Position in the item view
+ * @param quantity Full quantity of the item at that position
+ */
+template <typename Plan>
+inline void visit_row(Plan& packs, size_t position, std::int64_t quantity) noexcept {
+    if constexpr (std::is_same_v<Plan, range_plan>) {
+        packs.visit_row(position, quantity);
+    } else {
+        (void)packs;
+        (void)position;
+        (void)quantity;
+    }
+}
+
+/**
+ * @brief Place a long run of one item into whole packs in one step
+ * Called when the open pack is empty: every pack the run fills then holds
+ * the same number of pieces, so the number of full packs is one division
+ * instead of one failed capacity check per pack. The last full pack stays
+ * open, exactly as the per-pack loop would leave it.
+ * @param packs Plan whose last pack is open and empty
+ * @param open_next Callable opening the next pack
+ * @param id The item ID
+ * @param length The item length
+ * @param quantity Pieces still to place
+ * @param weight Weight per piece (in the policy's units)
+ * @param max_items Maximum items per pack
+ * @param weight_limit Maximum weight per pack (in the policy's units)
+ * @return std::int64_t Pieces placed; 0 if the run fits in fewer than two packs
+ */
+template <typename Weights, typename Plan, typename OpenNext>
+[[nodiscard]] std::int64_t place_full_packs(Plan& packs, OpenNext&& open_next, int id, int length,
+                                            std::int64_t quantity, typename Weights::value_type weight,
+                                            int max_items, typename Weights::value_type weight_limit) {
+    std::int64_t per_pack = 0;
+    if constexpr (std::is_same_v<Weights, fixed_weights>) {
+        per_pack = pack::fit_quantity_fixed(quantity, std::max<std::int64_t>(0, weight), 0, 0,
+                                            max_items, weight_limit);
+    } else {
+        per_pack = pack::fit_quantity(quantity, std::max(0.0, weight), 0, 0.0, max_items, weight_limit);
+    }
+    if (per_pack <= 0 || quantity / per_pack < 2) return 0;
+
+    const std::int64_t full = quantity / per_pack;
+    std::int64_t remaining = quantity;
+    for (std::int64_t n = 0; n < full; ++n) {
+        if (n > 0) open_next();
+        auto&& open_pack = packs.back();
+        remaining -= Weights::add_partial_item(open_pack, id, length, remaining, weight,
+                                               max_items, weight_limit);
+    }
+    return quantity - remaining;
+}
+
 /**
  * @brief Factory for creating pack strategies
  */
@@ -46,11 +277,13 @@ public:
      * @brief Create a pack strategy
      * @param type Strategy type to create
      * @param thread_count Number of threads for parallel strategy (ignored for others)
+     * @param weights Numeric representation of weights while packing
      * @return std::unique_ptr<pack_strategy> Created strategy
      */
     static std::unique_ptr<pack_strategy> create_strategy(
         strategy_type type,
-        int thread_count = 4);
+        int thread_count = 4,
+        weight_mode weights = weight_mode::FLOATING);
 
     /**
      * @brief Parse strategy type from string
@@ -73,7 +306,7 @@ public:
     static std::vector<strategy_type> get_all_strategies();
 
     /**
-     * @brief Get only fast strategies (excludes WORST_FIT, BEST_FIT)
+     * @brief Get only fast strategies (all current ones are O(log P) per placement or better)
      * @return std::vector<strategy_type> List of fast strategies
      */
     static std::vector<strategy_type> get_fast_strategies();
@@ -85,6 +318,15 @@ public:
      */
     static bool is_parallel_strategy(strategy_type type);
 
+    /**
+     * @brief Check if a strategy only ever fills the last pack
+     * Such strategies can pack rows as they arrive and emit each pack once
+     * the next one is opened (streaming_packer gives the same packs).
+     * @param type Strategy type
+     * @return bool True if earlier packs are never revisited
+     */
+    static bool is_streaming_strategy(strategy_type type);
+
     /**
      * @brief Get default thread count for a strategy
      * @param type Strategy type
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "pack.h"
+#include "plan_arena.h"
+
+/**
+ * @brief Parallel renderer writing packs straight into a memory-mapped file
+ * Every worker first measures the exact rendered size of its packs; the
+ * per-worker sizes are prefix-summed into file offsets, the file is created
+ * at its final size and mapped, and each worker then formats its packs
+ * directly into its own region. The bytes are identical to
+ * pack_planner::output_results().
+ */
+class parallel_output {
+public:
+    /**
+     * @brief Construct a new output writer
+     * @param thread_count Number of render threads (0 = hardware concurrency)
+     */
+    explicit parallel_output(unsigned int thread_count = 0) noexcept;
+
+    /**
+     * @brief Render all non-empty packs into a file
+     * Results too small to split are streamed through pack_formatter on the
+     * calling thread instead, since the measuring pass only pays off when
+     * the rendering is shared.
+     * @param packs Packs to write
+     * @param path Output file (created or truncated)
+     * @return bool True if the file was written completely
+     */
+    bool write_file(const std::vector<pack>& packs, const std::string& path);
+
+    /**
+     * @brief Render all non-empty packs of a plan arena into a file
+     * Same output and fallback rules as write_file().
+     * @param packs Packs to write
+     * @param path Output file (created or truncated)
+     * @return bool True if the file was written completely
+     */
+    bool write_arena_file(const plan_arena& packs, const std::string& path);
+
+    /**
+     * @brief Get the size of the last written file
+     * @return size_t Bytes written
+     */
+    [[nodiscard]] size_t get_bytes_written() const noexcept { return m_bytes_written; }
+
+    /**
+     * @brief Get the number of threads used by the last write_file call
+     * @return size_t Render thread count
+     */
+    [[nodiscard]] size_t get_threads_used() const noexcept { return m_threads_used; }
+
+    /**
+     * @brief Get wall time of the last write_file call in milliseconds
+     * @return double Elapsed time including measuring, mapping and rendering
+     */
+    [[nodiscard]] double get_total_time() const noexcept { return m_total_time; }
+
+    /**
+     * @brief Split packs into contiguous ranges with roughly equal line counts
+     * @param packs Packs to split
+     * @param range_count Desired number of ranges
+     * @return std::vector<size_t> Range boundaries (range i is [b[i], b[i+1]))
+     */
+    [[nodiscard]] static std::vector<size_t> split_ranges(const std::vector<pack>& packs,
+                                                          size_t range_count);
+
+    // Below this many item lines per worker an extra thread is not worth starting
+    static constexpr size_t MIN_LINES_PER_THREAD = 16384;
+
+private:
+    template <typename Packs>
+    bool write_packs(const Packs& packs, const std::string& path);
+
+    unsigned int m_thread_count;
+    size_t m_bytes_written = 0;
+    size_t m_threads_used = 0;
+    double m_total_time = 0.0;
+};
@@ -1,11 +1,13 @@
 #pragma once
 
 #include "pack_strategy.h"
+#include "blocking_pack_strategy.h"
 #include <thread>
 #include <future>
 #include <mutex>
 #include <atomic>
 #include <algorithm>
+#include <type_traits>
 
 /**
  * @brief Parallel pack strategy using multiple threads
@@ -22,105 +24,46 @@ private:
      * @param end_idx Ending index in the items vector
      * @param max_items Maximum items per pack
      * @param max_weight Maximum weight per pack
-     * @param result_packs Vector to store resulting packs
+     * @param result_packs Plan (std::vector<pack>, plan_arena or range_plan) to store resulting packs
      * @param next_pack_number Atomic counter for pack numbers
      * @param mutex Mutex for thread synchronization
      */
+    template <typename Plan, typename Weights>
     void worker_thread(
-        const std::vector<item>& items,
+        const item_column_view& items,
         size_t start_idx,
         size_t end_idx,
         int max_items,
         double max_weight,
-        std::vector<pack>& result_packs,
-        std::atomic<int>& next_pack_number,
+        Plan& result_packs,
+        std::atomic<std::int64_t>& next_pack_number,
         std::mutex& mutex) {
 
-        // SAFETY: Validate constraints to prevent infinite loops
-        max_items = std::max(1, max_items);
-        max_weight = std::max(0.1, max_weight);
-
         // Process items in this thread's chunk
-        std::vector<pack> local_packs;
-        // SAFETY: Limit initial allocation to prevent OOM with extreme values
-        const size_t max_safe_reserve = std::min<size_t>(20000, (end_idx - start_idx) / 10 + 500);
-        local_packs.reserve(std::min(max_safe_reserve,
-                        std::max<size_t>(16, static_cast<size_t>((end_idx - start_idx) * 0.00222) + 8)));
-
-        // Get first pack number for this thread
-        int pack_number = next_pack_number.fetch_add(1);
-        local_packs.emplace_back(pack_number);
-
-        // SAFETY: Add a safety counter to prevent infinite loops
-        const int max_iterations = 500000; // Reasonable upper limit per thread
-        int safety_counter = 0;
-
-        for (size_t i = start_idx; i < end_idx; ++i) {
-            const auto& item = items[i];
-            // SAFETY: Skip items with non-positive quantities
-            if (item.get_quantity() <= 0) continue;
-
-            int remaining_quantity = item.get_quantity();
-
-            while (remaining_quantity > 0) {
-                // SAFETY: Check for potential infinite loop
-                if (++safety_counter > max_iterations) {
-                    // Force exit the loop if we've exceeded reasonable iterations
-                    break;
-                }
+        Plan local_packs;
+        reserve_plan(local_packs, items, start_idx, end_idx, max_items, max_weight);
+        fill_chunk<Plan, Weights>(items, start_idx, end_idx, max_items, max_weight,
+                                  local_packs, next_pack_number);
 
-                pack& current_pack = local_packs.back();
-                int added_quantity = current_pack.add_partial_item(
-                    item.get_id(),
-                    item.get_length(),
-                    remaining_quantity,
-                    item.get_weight(),
-                    max_items,
-                    max_weight);
-
-                if (added_quantity > 0) {
-                    remaining_quantity -= added_quantity;
-                } else {
-                    // Check if this item can never fit (weight exceeds max_weight)
-                    if (item.get_weight() > max_weight) {
-                        // Item is too heavy to fit in any pack, skip it
-                        remaining_quantity = 0;
-                        break;
-                    }
-                    // Fallback: If pack is empty but item should fit, something else is wrong
-                    if (current_pack.is_empty()) {
-                        remaining_quantity = 0;
-                        break;
-                    }
-                    
-                    // SAFETY: Limit maximum number of packs to prevent OOM
-                    if (local_packs.size() >= max_safe_reserve) {
-                        // Force exit if we've created too many packs
-                        remaining_quantity = 0;
-                        break;
-                    }
-                    // Get next pack number atomically
-                    pack_number = next_pack_number.fetch_add(1);
-                    local_packs.emplace_back(pack_number);
-                }
-            }
-        }
-
-        // Merge local results into the shared result vector
+        // Merge local results into the shared result (reserved by pack_parallel)
         {
             std::lock_guard<std::mutex> lock(mutex);
-            // SAFETY: Limit the total number of packs to prevent OOM
-            const size_t max_total_packs = std::min<size_t>(200000, items.size() / 5 + 10000);
-            if (result_packs.size() < max_total_packs) {
-                result_packs.insert(result_packs.end(),
-                                local_packs.begin(),
-                                local_packs.begin() + std::min(local_packs.size(),
-                                                                max_total_packs - result_packs.size()));
+            if constexpr (!std::is_same_v<Plan, std::vector<pack>>) {
+                result_packs.append(local_packs);
+            } else {
+                // Workers allocate from the default resource; the shared
+                // resource is only touched here, under the lock
+                std::pmr::memory_resource* resource = get_memory_resource();
+                for (auto& p : local_packs) {
+                    result_packs.emplace_back(std::move(p), resource);
+                }
             }
         }
     }
 
 public:
+    using pack_strategy::pack_items;
+
     /**
      * @brief Construct a new parallel packing strategy
      * @param num_threads Number of threads to use (0 = use hardware concurrency)
@@ -135,113 +78,160 @@ public:
 
     /**
      * @brief Pack items into packs using multiple threads
-     * @param items Items to pack
+     * @param items Items to pack, stored column-wise
      * @param max_items Maximum items per pack
      * @param max_weight Maximum weight per pack
      * @return std::vector<pack> Vector of packs
      */
-    std::vector<pack> pack_items(const std::vector<item>& items,
+    std::vector<pack> pack_items(const item_column_view& items,
                             int max_items,
                             double max_weight) override {
+        std::vector<pack> packs;
+        with_weight_policy([&](auto weights) {
+            pack_parallel(items, max_items, max_weight, packs, weights);
+        });
+        return packs;
+    }
+
+    /**
+     * @brief Pack items using multiple threads, appending to a plan arena
+     * @param items Items to pack, stored column-wise
+     * @param max_items Maximum items per pack
+     * @param max_weight Maximum weight per pack
+     * @param out Arena receiving the packs
+     */
+    void pack_items(const item_column_view& items,
+                    int max_items,
+                    double max_weight,
+                    plan_arena& out) override {
+        with_weight_policy([&](auto weights) {
+            pack_parallel(items, max_items, max_weight, out, weights);
+        });
+    }
+
+    /**
+     * @brief Pack items using multiple threads into a range plan
+     * @param items Items to pack, stored column-wise
+     * @param max_items Maximum items per pack
+     * @param max_weight Maximum weight per pack
+     * @param out Range plan receiving the packs
+     * @return bool Always true
+     */
+    bool pack_items(const item_column_view& items,
+                    int max_items,
+                    double max_weight,
+                    range_plan& out) override {
+        out.set_weight_limit(max_weight, get_weight_mode());
+        with_weight_policy([&](auto weights) {
+            pack_parallel(items, max_items, max_weight, out, weights);
+        });
+        return true;
+    }
+
+    /**
+     * @brief Run the packing loop over one chunk of items into a local plan
+     * Weights is the weight policy (floating_weights or fixed_weights).
+     * @param items Items to process
+     * @param start_idx Starting index in the items vector
+     * @param end_idx Ending index in the items vector
+     * @param max_items Maximum items per pack
+     * @param max_weight Maximum weight per pack
+     * @param local_packs Plan receiving the chunk's packs
+     * @param next_pack_number Atomic counter for pack numbers
+     */
+    template <typename Plan, typename Weights>
+    static void fill_chunk(
+        const item_column_view& items,
+        size_t start_idx,
+        size_t end_idx,
+        int max_items,
+        double max_weight,
+        Plan& local_packs,
+        std::atomic<std::int64_t>& next_pack_number) {
+
         // SAFETY: Validate constraints to prevent infinite loops
         max_items = std::max(1, max_items);
         max_weight = std::max(0.1, max_weight);
+        const auto weight_limit = Weights::convert(max_weight);
 
-        // SAFETY: Limit thread count to a reasonable number
-        m_num_threads = std::min(static_cast<unsigned int>(32),
-                            std::max(static_cast<unsigned int>(1), m_num_threads));
+        // Get first pack number for this thread
+        std::int64_t pack_number = next_pack_number.fetch_add(1);
+        local_packs.emplace_back(pack_number);
+        auto open_next = [&] {
+            pack_number = next_pack_number.fetch_add(1);
+            local_packs.emplace_back(pack_number);
+        };
 
-        // If items are few or we have only 1 thread, use sequential approach
-        // Hybrid approach
-        if (items.size() < 5000 || m_num_threads == 1) {
-            // SAFETY: Same fixes as in blocking strategy
-            std::vector<pack> packs;
-            const size_t max_safe_reserve = std::min<size_t>(100000, items.size() / 10 + 1000);
-            packs.reserve(std::min(max_safe_reserve,
-                        std::max<size_t>(64, static_cast<size_t>(items.size() * 0.00222) + 16)));
-            int pack_number = 1;
-            packs.emplace_back(pack_number);
+        for (size_t i = start_idx; i < end_idx; ++i) {
+            const size_t row = items.row(i);
 
-            // SAFETY: Add a safety counter to prevent infinite loops
-            const int max_iterations = 1000000; // Reasonable upper limit
-            int safety_counter = 0;
+            // SAFETY: Skip items with non-positive quantities
+            if (items.quantities[row] <= 0) continue;
+            visit_row(local_packs, i, items.quantities[row]);
 
-            for (const auto& i : items) {
-                // SAFETY: Skip items with non-positive quantities
-                if (i.get_quantity() <= 0) continue;
+            const auto weight = Weights::convert(items.weights[row]);
+            std::int64_t remaining_quantity = items.quantities[row];
 
-                int remaining_quantity = i.get_quantity();
+            while (remaining_quantity > 0) {
+                auto&& current_pack = local_packs.back();
+                if (current_pack.is_empty()) {
+                    // A run spanning several packs fills them in one step
+                    const std::int64_t placed = place_full_packs<Weights>(local_packs, open_next,
+                        items.ids[row], items.lengths[row], remaining_quantity,
+                        weight, max_items, weight_limit);
+                    if (placed > 0) {
+                        remaining_quantity -= placed;
+                        continue;
+                    }
+                }
+                std::int64_t added_quantity = Weights::add_partial_item(
+                    current_pack,
+                    items.ids[row],
+                    items.lengths[row],
+                    remaining_quantity,
+                    weight,
+                    max_items,
+                    weight_limit);
 
-                while (remaining_quantity > 0) {
-                    // SAFETY: Check for potential infinite loop
-                    if (++safety_counter > max_iterations) {
-                        // Force exit the loop if we've exceeded reasonable iterations
+                if (added_quantity > 0) {
+                    remaining_quantity -= added_quantity;
+                } else {
+                    // Check if this item can never fit (weight exceeds max_weight)
+                    if (weight > weight_limit) {
+                        // Item is too heavy to fit in any pack, skip it
                         break;
                     }
-
-                    pack& current_pack = packs.back();
-                    int added_quantity =
-                        current_pack.add_partial_item(i.get_id(), i.get_length(), remaining_quantity,
-                                                    i.get_weight(), max_items, max_weight);
-
-                    if (added_quantity > 0) {
-                        remaining_quantity -= added_quantity;
-                    } else {
-                        // Check if this item can never fit (weight exceeds max_weight)
-                        if (i.get_weight() > max_weight) {
-                            // Item is too heavy to fit in any pack, skip it
-                            remaining_quantity = 0;
-                            break;
-                        }
-                        // Fallback: If pack is empty but item should fit, something else is wrong
-                        if (current_pack.is_empty()) {
-                            remaining_quantity = 0;
-                            break;
-                        }
-                        
-                        // SAFETY: Limit maximum number of packs to prevent OOM
-                        if (packs.size() >= max_safe_reserve) {
-                            // Force exit if we've created too many packs
-                            remaining_quantity = 0;
-                            break;
-                        }
-                        packs.emplace_back(++pack_number);
+                    // Fallback: If pack is empty but item should fit, something else is wrong
+                    if (current_pack.is_empty()) {
+                        break;
                     }
+                    open_next();
                 }
             }
-            return packs;
         }
+    }
 
-        // For parallel processing
-        std::vector<pack> result_packs;
-        std::mutex result_mutex;
-        std::atomic<int> next_pack_number{1};
-
+    /**
+     * @brief Run fn(thread_index, start_idx, end_idx) on one thread per chunk
+     * @param item_count Number of items to split
+     * @param thread_count Number of threads (and chunks)
+     * @param fn Chunk function
+     */
+    template <typename Fn>
+    static void run_chunks(size_t item_count, unsigned int thread_count, Fn&& fn) {
         // Calculate chunk size for each thread
-        size_t chunk_size = items.size() / m_num_threads;
-        size_t remainder = items.size() % m_num_threads;
+        const size_t chunk_size = item_count / thread_count;
+        const size_t remainder = item_count % thread_count;
 
         // Create and start threads
         std::vector<std::thread> threads;
-        threads.reserve(m_num_threads);
+        threads.reserve(thread_count);
 
         size_t start_idx = 0;
-        for (unsigned int i = 0; i < m_num_threads; ++i) {
+        for (unsigned int i = 0; i < thread_count; ++i) {
             // Distribute remainder items among first 'remainder' threads
-            size_t thread_chunk_size = chunk_size + (i < remainder ? 1 : 0);
-            size_t end_idx = start_idx + thread_chunk_size;
-
-            threads.emplace_back(&parallel_pack_strategy::worker_thread,
-                                this,
-                                std::ref(items),
-                                start_idx,
-                                end_idx,
-                                max_items,
-                                max_weight,
-                                std::ref(result_packs),
-                                std::ref(next_pack_number),
-                                std::ref(result_mutex));
-
+            const size_t end_idx = start_idx + chunk_size + (i < remainder ? 1 : 0);
+            threads.emplace_back([&fn, i, start_idx, end_idx] { fn(i, start_idx, end_idx); });
             start_idx = end_idx;
         }
 
@@ -249,11 +239,43 @@ public:
         for (auto& thread : threads) {
             thread.join();
         }
-
-        return result_packs;
     }
 
     std::string get_name() const override {
         return "Parallel(" + std::to_string(m_num_threads) + " threads)";
     }
+
+private:
+    template <typename Plan, typename Weights>
+    void pack_parallel(const item_column_view& items,
+                       int max_items,
+                       double max_weight,
+                       Plan& result_packs,
+                       Weights weights) {
+        // SAFETY: Validate constraints to prevent infinite loops
+        max_items = std::max(1, max_items);
+        max_weight = std::max(0.1, max_weight);
+
+        // SAFETY: Limit thread count to a reasonable number
+        m_num_threads = std::min(static_cast<unsigned int>(32),
+                            std::max(static_cast<unsigned int>(1), m_num_threads));
+
+        // If items are few or we have only 1 thread, use sequential approach
+        // Hybrid approach
+        if (items.size() < 5000 || m_num_threads == 1) {
+            blocking_pack_strategy::pack_sequential(items, max_items, max_weight, result_packs, weights,
+                                                    get_memory_resource());
+            return;
+        }
+
+        reserve_plan(result_packs, items, 0, items.size(), max_items, max_weight);
+
+        // For parallel processing
+        std::mutex result_mutex;
+        std::atomic<std::int64_t> next_pack_number{1};
+        run_chunks(items.size(), m_num_threads, [&](unsigned int, size_t start_idx, size_t end_idx) {
+            worker_thread<Plan, Weights>(items, start_idx, end_idx, max_items, max_weight,
+                                         result_packs, next_pack_number, result_mutex);
+        });
+    }
 };
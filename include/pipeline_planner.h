@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "pack_planner.h"
+#include "spsc_ring.h"
+
+/**
+ * @brief Busy time of each pipeline stage for one run
+ */
+struct pipeline_stats {
+    size_t items = 0;
+    size_t packs = 0;
+    std::int64_t pieces = 0;
+    std::int64_t unplaced_pieces = 0;  // pieces heavier than a whole pack, left out
+    double parse_time = 0.0;  // milliseconds spent parsing (excluding waits)
+    double pack_time = 0.0;   // milliseconds spent packing (incl. waiting on a full output ring)
+    double write_time = 0.0;  // milliseconds spent formatting and writing
+    double total_time = 0.0;  // wall time of the whole run
+};
+
+/**
+ * @brief Three-stage parse -> pack -> write pipeline for NATURAL order
+ * A parser thread cuts the input into newline-aligned slices and pushes
+ * item batches, the calling thread packs them with streaming_packer and
+ * pushes batches of sealed packs, and a writer thread renders them with
+ * pack_formatter. Stages are connected by bounded spsc_rings, so wall time
+ * approaches the slowest stage rather than the sum of all three.
+ */
+class pipeline_planner {
+public:
+    // Input slice handed to the parser per batch
+    static constexpr size_t DEFAULT_SLICE_BYTES = 256 * 1024;
+
+    // Sealed packs collected before handing them to the writer
+    static constexpr size_t DEFAULT_PACK_BATCH = 1024;
+
+    // Batches in flight per ring
+    static constexpr size_t DEFAULT_RING_CAPACITY = 16;
+
+    /**
+     * @brief Construct a new pipeline
+     * @param slice_bytes Input bytes per item batch
+     * @param pack_batch Sealed packs per output batch
+     * @param ring_capacity Batches in flight between two stages
+     */
+    explicit pipeline_planner(size_t slice_bytes = DEFAULT_SLICE_BYTES,
+                              size_t pack_batch = DEFAULT_PACK_BATCH,
+                              size_t ring_capacity = DEFAULT_RING_CAPACITY) noexcept;
+
+    /**
+     * @brief Plan an in-memory CSV buffer and write the packs as text
+     * Sort order in config is ignored; the pipeline always packs in input order.
+     * @param data Start of the CSV buffer
+     * @param size Size of the buffer in bytes
+     * @param config Pack limits
+     * @param output Stream receiving the rendered packs
+     * @return pipeline_stats Counts and per-stage times
+     */
+    pipeline_stats run(const char* data, size_t size, const pack_planner_config& config,
+                       std::ostream& output);
+
+    /**
+     * @brief Plan CSV text delivered in arbitrary blocks (e.g. by gzip_reader)
+     * The parser thread pulls blocks itself, so a producer running on yet
+     * another thread (decompression) overlaps with all three stages.
+     * @param next_block Returns the next block, or false at end of input
+     * @param config Pack limits
+     * @param output Stream receiving the rendered packs
+     * @return pipeline_stats Counts and per-stage times
+     */
+    pipeline_stats run_blocks(const std::function<bool(std::string&)>& next_block,
+                              const pack_planner_config& config, std::ostream& output);
+
+    /**
+     * @brief Plan a CSV file (memory-mapped when possible)
+     * @param input_path CSV file to read
+     * @param config Pack limits
+     * @param output Stream receiving the rendered packs
+     * @param stats Receives counts and per-stage times
+     * @return bool True if the input could be read
+     */
+    bool run_file(const std::string& input_path, const pack_planner_config& config,
+                  std::ostream& output, pipeline_stats& stats);
+
+private:
+    using item_ring = spsc_ring<std::vector<item>>;
+
+    // Runs the pack and write stages around a parse stage that fills the item ring
+    pipeline_stats run_stages(const std::function<void(item_ring&, pipeline_stats&)>& parse_stage,
+                              const pack_planner_config& config, std::ostream& output);
+
+    size_t m_slice_bytes;
+    size_t m_pack_batch;
+    size_t m_ring_capacity;
+};
@@ -0,0 +1,330 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <span>
+#include <string>
+#include <vector>
+#include "item.h"
+#include "pack.h"
+
+/**
+ * @brief Flat plan storage: all placements in one array plus a pack table
+ * Pack i owns placements [first, first + count) of the shared placement
+ * array, so a plan of any size lives in two allocations and is walked front
+ * to back without following per-pack pointers. Only the last (open) pack
+ * accepts items, which is how the next-fit style strategies fill packs.
+ */
+class plan_arena {
+public:
+    /**
+     * @brief One row of the pack table
+     */
+    struct pack_entry {
+        size_t first = 0;  // index of the pack's first placement
+        size_t count = 0;  // number of placements
+        std::int64_t pack_number = 0;
+        std::int64_t total_items = 0;
+        double total_weight = 0.0;
+        std::int64_t total_weight_fixed = 0;  // thousandths, fixed-point mode only
+        int max_length = 0;
+    };
+
+    /**
+     * @brief Read-only view of one pack with the same getters as pack
+     */
+    class pack_ref {
+    public:
+        pack_ref(const pack_entry& entry, const item* placements) noexcept
+            : m_entry(&entry), m_placements(placements) {}
+
+        [[nodiscard]] std::int64_t get_pack_number() const noexcept { return m_entry->pack_number; }
+        [[nodiscard]] std::int64_t get_total_items() const noexcept { return m_entry->total_items; }
+        [[nodiscard]] double get_total_weight() const noexcept { return m_entry->total_weight; }
+        [[nodiscard]] int get_pack_length() const noexcept { return m_entry->max_length; }
+        [[nodiscard]] bool is_empty() const noexcept { return m_entry->count == 0; }
+
+        /**
+         * @brief Get the placements of this pack
+         * @return std::span<const item> Placements in insertion order
+         */
+        [[nodiscard]] std::span<const item> get_items() const noexcept {
+            return {m_placements + m_entry->first, m_entry->count};
+        }
+
+        /**
+         * @brief Copy the pack into a standalone pack object
+         * @return pack Equivalent pack
+         */
+        [[nodiscard]] pack to_pack() const {
+            pack p(m_entry->pack_number);
+            const bool fixed = m_entry->total_weight_fixed > 0;
+            for (const auto& i : get_items()) {
+                // Unlimited capacity: the totals are re-accumulated in the same order
+                if (fixed) {
+                    (void)p.add_partial_item_fixed(i.get_id(), i.get_length(), i.get_quantity(),
+                                                   i.get_fixed_weight(), std::numeric_limits<int>::max(),
+                                                   fixed_weight::MAX_VALUE);
+                } else {
+                    (void)p.add_item(i, std::numeric_limits<int>::max(), std::numeric_limits<double>::max());
+                }
+            }
+            return p;
+        }
+
+        /**
+         * @brief Get string representation of the pack (same as pack::to_string())
+         * @return std::string The string representation
+         */
+        [[nodiscard]] std::string to_string() const { return to_pack().to_string(); }
+
+    private:
+        const pack_entry* m_entry;
+        const item* m_placements;
+    };
+
+    /**
+     * @brief Handle on the open pack, as returned by back()
+     * Mirrors the part of pack the strategies use while filling.
+     */
+    class open_pack {
+    public:
+        explicit open_pack(plan_arena& arena) noexcept : m_arena(&arena) {}
+
+        /**
+         * @brief Try to add partial quantity of an item (same rules as pack)
+         * @param id The item ID
+         * @param length The item length
+         * @param quantity The item quantity
+         * @param weight The item weight per piece
+         * @param max_items Maximum number of items allowed in the pack
+         * @param max_weight Maximum weight allowed in the pack
+         * @return std::int64_t Number of items successfully added
+         */
+        [[nodiscard]] std::int64_t add_partial_item(int id, int length, std::int64_t quantity, double weight,
+                                                    int max_items, double max_weight) {
+            return m_arena->add_to_open_pack(id, length, quantity, weight, max_items, max_weight);
+        }
+
+        /**
+         * @brief Try to add partial quantity with fixed-point weights (same rules as pack)
+         * @param id The item ID
+         * @param length The item length
+         * @param quantity The item quantity
+         * @param weight The item weight per piece in thousandths
+         * @param max_items Maximum number of items allowed in the pack
+         * @param max_weight Maximum weight allowed in the pack in thousandths
+         * @return std::int64_t Number of items successfully added
+         */
+        [[nodiscard]] std::int64_t add_partial_item_fixed(int id, int length, std::int64_t quantity,
+                                                          std::int64_t weight, int max_items,
+                                                          std::int64_t max_weight) {
+            return m_arena->add_to_open_pack_fixed(id, length, quantity, weight, max_items, max_weight);
+        }
+
+        [[nodiscard]] bool is_empty() const noexcept { return m_arena->m_packs.back().count == 0; }
+
+    private:
+        plan_arena* m_arena;
+    };
+
+    /**
+     * @brief Forward iterator yielding pack_ref values
+     */
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = pack_ref;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = pack_ref;
+
+        const_iterator() noexcept = default;
+        const_iterator(const plan_arena* arena, size_t index) noexcept
+            : m_arena(arena), m_index(index) {}
+
+        pack_ref operator*() const noexcept { return (*m_arena)[m_index]; }
+        const_iterator& operator++() noexcept { ++m_index; return *this; }
+        const_iterator operator++(int) noexcept { const_iterator old = *this; ++m_index; return old; }
+        bool operator==(const const_iterator& other) const noexcept = default;
+
+    private:
+        const plan_arena* m_arena = nullptr;
+        size_t m_index = 0;
+    };
+
+    /**
+     * @brief Reserve the pack table and placement array
+     * @param pack_count Expected number of packs
+     * @param placement_count Expected number of placements (at least one per pack)
+     */
+    void reserve(size_t pack_count, size_t placement_count = 0) {
+        m_packs.reserve(pack_count);
+        m_placements.reserve(std::max(pack_count, placement_count));
+    }
+
+    /**
+     * @brief Open a new, empty pack at the end
+     * @param pack_number The pack identifier
+     */
+    void emplace_back(std::int64_t pack_number) {
+        pack_entry entry;
+        entry.first = m_placements.size();
+        entry.pack_number = pack_number;
+        m_packs.push_back(entry);
+    }
+
+    /**
+     * @brief Get the open (last) pack; the arena must not be empty
+     * @return open_pack Handle for adding items
+     */
+    [[nodiscard]] open_pack back() noexcept { return open_pack(*this); }
+
+    /**
+     * @brief Append a copy of a pack as a new closed pack
+     * @param p Pack to copy
+     */
+    void append(const pack& p) {
+        pack_entry entry;
+        entry.first = m_placements.size();
+        entry.count = p.get_items().size();
+        entry.pack_number = p.get_pack_number();
+        entry.total_items = p.get_total_items();
+        entry.total_weight = p.get_total_weight();
+        entry.total_weight_fixed = p.get_total_weight_fixed();
+        entry.max_length = p.get_pack_length();
+        m_placements.insert(m_placements.end(), p.get_items().begin(), p.get_items().end());
+        m_packs.push_back(entry);
+    }
+
+    /**
+     * @brief Append packs [first, last) of another arena
+     * @param other Arena to copy from
+     * @param first Index of the first pack to copy
+     * @param last One past the last pack to copy
+     */
+    void append(const plan_arena& other, size_t first, size_t last) {
+        if (first >= last) return;
+        const size_t from = other.m_packs[first].first;
+        const size_t to = other.m_packs[last - 1].first + other.m_packs[last - 1].count;
+        const size_t shift = m_placements.size() - from;  // wraps when negative; sums stay correct
+        m_placements.insert(m_placements.end(), other.m_placements.begin() + from,
+                            other.m_placements.begin() + to);
+        for (size_t i = first; i < last; ++i) {
+            pack_entry entry = other.m_packs[i];
+            entry.first += shift;
+            m_packs.push_back(entry);
+        }
+    }
+
+    /**
+     * @brief Append all packs of another arena
+     * @param other Arena to copy from
+     */
+    void append(const plan_arena& other) { append(other, 0, other.size()); }
+
+    /**
+     * @brief Remove all packs and placements, keeping the capacity
+     */
+    void clear() noexcept {
+        m_packs.clear();
+        m_placements.clear();
+    }
+
+    /**
+     * @brief Get the number of packs (including empty ones)
+     * @return size_t Pack count
+     */
+    [[nodiscard]] size_t size() const noexcept { return m_packs.size(); }
+
+    /**
+     * @brief Check whether the arena holds no packs
+     * @return bool True if empty
+     */
+    [[nodiscard]] bool empty() const noexcept { return m_packs.empty(); }
+
+    /**
+     * @brief Get a view of one pack
+     * @param i Pack index (must be < size())
+     * @return pack_ref View of the pack
+     */
+    [[nodiscard]] pack_ref operator[](size_t i) const noexcept {
+        return pack_ref(m_packs[i], m_placements.data());
+    }
+
+    [[nodiscard]] const_iterator begin() const noexcept { return const_iterator(this, 0); }
+    [[nodiscard]] const_iterator end() const noexcept { return const_iterator(this, m_packs.size()); }
+
+    /**
+     * @brief Get the pack table
+     * @return const std::vector<pack_entry>& Packs in plan order
+     */
+    [[nodiscard]] const std::vector<pack_entry>& packs() const noexcept { return m_packs; }
+
+    /**
+     * @brief Get all placements of all packs
+     * @return const std::vector<item>& Placements in plan order
+     */
+    [[nodiscard]] const std::vector<item>& placements() const noexcept { return m_placements; }
+
+    /**
+     * @brief Copy the plan into per-pack objects (for vector<pack> consumers)
+     * @return std::vector<pack> Equivalent packs
+     */
+    [[nodiscard]] std::vector<pack> to_packs() const {
+        std::vector<pack> result;
+        result.reserve(m_packs.size());
+        for (const auto p : *this) {
+            result.push_back(p.to_pack());
+        }
+        return result;
+    }
+
+private:
+    std::int64_t add_to_open_pack(int id, int length, std::int64_t quantity, double weight,
+                                  int max_items, double max_weight) {
+        pack_entry& entry = m_packs.back();
+
+        // SAFETY: Same input clamping as pack::add_partial_item
+        length = std::max(1, length);
+        weight = std::max(0.0, weight);
+
+        const std::int64_t can_add = pack::fit_quantity(quantity, weight, entry.total_items,
+                                                        entry.total_weight, max_items, max_weight);
+        if (can_add > 0) {
+            m_placements.emplace_back(id, length, can_add, weight);
+            ++entry.count;
+            entry.total_items += can_add;
+            entry.total_weight += static_cast<double>(can_add) * weight;
+            entry.max_length = std::max(entry.max_length, length);
+        }
+        return can_add;
+    }
+
+    std::int64_t add_to_open_pack_fixed(int id, int length, std::int64_t quantity, std::int64_t weight,
+                                        int max_items, std::int64_t max_weight) {
+        pack_entry& entry = m_packs.back();
+
+        // SAFETY: Same input clamping as pack::add_partial_item_fixed
+        length = std::max(1, length);
+        weight = std::max<std::int64_t>(0, weight);
+
+        const std::int64_t can_add = pack::fit_quantity_fixed(quantity, weight, entry.total_items,
+                                                              entry.total_weight_fixed, max_items, max_weight);
+        if (can_add > 0) {
+            m_placements.emplace_back(id, length, can_add, fixed_weight::to_double(weight));
+            ++entry.count;
+            entry.total_items += can_add;
+            entry.total_weight_fixed += can_add * weight;
+            entry.total_weight = fixed_weight::to_double(entry.total_weight_fixed);
+            entry.max_length = std::max(entry.max_length, length);
+        }
+        return can_add;
+    }
+
+    std::vector<pack_entry> m_packs;
+    std::vector<item> m_placements;
+};
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include "binary_plan_file.h"
+#include "item.h"
+#include "item_column_view.h"
+
+/**
+ * @brief Kinds of problems plan_validator reports
+ */
+enum class violation_kind {
+    TOO_MANY_ITEMS,   // pack holds more pieces than max items
+    TOO_HEAVY,        // pack weight exceeds max weight
+    COUNT_MISMATCH,   // reported pack item count is not the sum of its pieces (binary plans)
+    LENGTH_MISMATCH,  // reported pack length is not the longest item in the pack
+    WEIGHT_MISMATCH,  // reported pack weight is not the sum of its pieces
+    UNKNOWN_ITEM,     // plan places an item id that is not in the input
+    ITEM_MISMATCH,    // item line disagrees with the input's length or weight
+    MISSING_PIECES,   // input pieces that were never placed
+    EXTRA_PIECES,     // pieces placed more often than the input holds them
+    MALFORMED         // plan text that is not a header, item line or footer
+};
+
+/**
+ * @brief One problem found in a plan
+ */
+struct plan_violation {
+    violation_kind kind = violation_kind::MALFORMED;
+    int64_t pack_number = -1;  // -1 for item-level findings
+    int64_t item_id = -1;      // -1 for pack-level findings
+    double expected = 0.0;
+    double actual = 0.0;
+    size_t offset = 0;  // byte offset of the offending line (text plans)
+
+    /**
+     * @brief Describe the violation in one line
+     * @return std::string Human-readable description
+     */
+    [[nodiscard]] std::string to_string() const;
+};
+
+/**
+ * @brief Outcome of one validation run
+ */
+struct validation_report {
+    size_t packs = 0;
+    size_t placements = 0;  // item lines (text) or placement records (binary)
+    long long pieces = 0;
+    size_t violation_count = 0;             // all violations found
+    std::vector<plan_violation> violations;  // the first ones, ordered by pack then item
+    double total_time = 0.0;                 // milliseconds, excluding item loading
+
+    /**
+     * @brief Check whether the plan passed
+     * @return bool True if no violation was found
+     */
+    [[nodiscard]] bool ok() const noexcept { return violation_count == 0; }
+};
+
+/**
+ * @brief Parallel checker for produced plans
+ * The input items are indexed by id once; the plan (the text output
+ * format or a binary plan file) is then split into pack-aligned ranges
+ * that are checked on separate threads. Placed pieces are tallied per
+ * input item with relaxed atomic adds, so the final accounting pass is a
+ * parallel sweep over the items. Items heavier than max weight (and items
+ * with no pieces) are expected to be left out of the plan, as the
+ * planner drops them.
+ */
+class plan_validator {
+public:
+    // Violations kept in the report; all of them are still counted
+    static constexpr size_t DEFAULT_MAX_REPORTED = 1000;
+
+    /**
+     * @brief Construct a new validator
+     * @param max_items Maximum pieces per pack
+     * @param max_weight Maximum weight per pack
+     * @param thread_count Number of checking threads (0 = hardware concurrency)
+     * @param max_reported Violations kept in the report
+     */
+    plan_validator(int max_items, double max_weight, unsigned int thread_count = 0,
+                   size_t max_reported = DEFAULT_MAX_REPORTED) noexcept;
+
+    /**
+     * @brief Index the input items
+     * @param items Items as loaded from the input
+     */
+    void set_items(const std::vector<item>& items);
+
+    /**
+     * @brief Index the input items from columns (e.g. a mapped binary item file)
+     * @param columns Item columns
+     */
+    void set_items(const item_column_view& columns);
+
+    /**
+     * @brief Validate a plan in the text output format
+     * @param data Start of the plan text
+     * @param size Size of the plan text in bytes
+     * @return validation_report Findings
+     */
+    [[nodiscard]] validation_report validate_text(const char* data, size_t size);
+
+    /**
+     * @brief Validate a binary plan file
+     * @param plan Opened plan file
+     * @return validation_report Findings
+     */
+    [[nodiscard]] validation_report validate_binary(const binary_plan_file& plan);
+
+    /**
+     * @brief Map a plan file (text or binary, detected by its magic) and validate it
+     * @param path Plan file
+     * @param report Receives the findings
+     * @return bool False if the file could not be read or is a corrupt binary plan
+     */
+    bool validate_file(const std::string& path, validation_report& report);
+
+    /**
+     * @brief Split plan text into ranges that each start at a "Pack Number:" line
+     * @param data Start of the plan text
+     * @param size Size of the plan text in bytes
+     * @param range_count Desired number of ranges
+     * @return std::vector<size_t> Range boundaries (range i is [b[i], b[i+1]))
+     */
+    [[nodiscard]] static std::vector<size_t> split_packs(const char* data, size_t size,
+                                                         size_t range_count);
+
+private:
+    struct range_result;
+
+    template <typename Row>
+    void build_index(size_t count, Row&& row);
+
+    [[nodiscard]] int64_t find_slot(int64_t id) const noexcept;
+
+    void check_text_range(const char* first, const char* last, range_result& out);
+    void check_pack(int64_t pack_number, long long pieces, double weight, range_result& out) const;
+    void record(range_result& out, const plan_violation& violation) const;
+
+    validation_report merge(std::vector<range_result>& ranges);
+
+    // Runs fn(task) for every task in [0, task_count), one task per thread
+    template <typename Fn>
+    static void run_tasks(size_t task_count, Fn&& fn);
+
+    int m_max_items;
+    double m_max_weight;
+    unsigned int m_thread_count;
+    size_t m_max_reported;
+
+    // Input items by slot; duplicate ids share the slot of their first row
+    int64_t m_min_id = 0;
+    std::vector<int32_t> m_dense_slots;                 // id - m_min_id -> slot (-1 = none)
+    std::vector<std::pair<int64_t, int32_t>> m_sparse;  // sorted (id, slot) when ids are sparse
+    std::vector<int64_t> m_ids;
+    std::vector<int> m_lengths;
+    std::vector<double> m_weights;
+    std::vector<long long> m_expected;
+    std::vector<long long> m_placed;
+    std::vector<uint8_t> m_ambiguous;  // duplicate id with a different length or weight
+};
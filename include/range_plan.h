@@ -0,0 +1,427 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <vector>
+#include "item.h"
+#include "item_column_view.h"
+#include "pack.h"
+#include "plan_arena.h"
+#include "weight_mode.h"
+
+/**
+ * @brief Plan encoding for next-fit style packing: one range per pack
+ * Those loops fill packs from a single cursor over the ordered items, so
+ * every pack holds a contiguous run of pieces: the rest of its first row,
+ * whole rows, then a prefix of its last row. A pack is stored as where the
+ * run starts (row and piece offset) plus its totals; the placements are
+ * recovered by walking total_items pieces from there. Plan memory is
+ * O(packs) instead of O(placements).
+ *
+ * Rows the loops never place (non-positive quantity, or heavier than the
+ * pack capacity) are skipped during the walk, which is why the plan keeps
+ * the capacity and weight mode it was built with.
+ */
+class range_plan {
+public:
+    /**
+     * @brief One packed run of pieces
+     */
+    struct pack_range {
+        size_t first_row = 0;   // row (view position) of the first piece
+        std::int64_t first_offset = 0;  // pieces of first_row placed by earlier packs
+        std::int64_t pack_number = 0;
+        std::int64_t total_items = 0;
+        int max_length = 0;
+        double total_weight = 0.0;
+        std::int64_t total_weight_fixed = 0;  // thousandths, fixed-point mode only
+    };
+
+    /**
+     * @brief Handle on the open pack, as returned by back()
+     * Mirrors the part of pack the strategies use while filling.
+     */
+    class open_range {
+    public:
+        explicit open_range(range_plan& plan) noexcept : m_plan(&plan) {}
+
+        /**
+         * @brief Try to add partial quantity of the current row (same rules as pack)
+         * @param id The item ID (unused; the row identifies the item)
+         * @param length The item length
+         * @param quantity The item quantity still to place
+         * @param weight The item weight per piece
+         * @param max_items Maximum number of items allowed in the pack
+         * @param max_weight Maximum weight allowed in the pack
+         * @return std::int64_t Number of items successfully added
+         */
+        [[nodiscard]] std::int64_t add_partial_item(int id, int length, std::int64_t quantity, double weight,
+                                                    int max_items, double max_weight) noexcept {
+            (void)id;
+            pack_range& range = m_plan->open_pack(quantity);
+            const double clamped = std::max(0.0, weight);
+            const std::int64_t can_add = pack::fit_quantity(quantity, clamped, range.total_items,
+                                                            range.total_weight, max_items, max_weight);
+            if (can_add > 0) {
+                range.total_items += can_add;
+                range.total_weight += static_cast<double>(can_add) * clamped;
+                range.max_length = std::max(range.max_length, std::max(1, length));
+            }
+            return can_add;
+        }
+
+        /**
+         * @brief Try to add partial quantity with fixed-point weights (same rules as pack)
+         * @param id The item ID (unused; the row identifies the item)
+         * @param length The item length
+         * @param quantity The item quantity still to place
+         * @param weight The item weight per piece in thousandths
+         * @param max_items Maximum number of items allowed in the pack
+         * @param max_weight Maximum weight allowed in the pack in thousandths
+         * @return std::int64_t Number of items successfully added
+         */
+        [[nodiscard]] std::int64_t add_partial_item_fixed(int id, int length, std::int64_t quantity,
+                                                          std::int64_t weight, int max_items,
+                                                          std::int64_t max_weight) noexcept {
+            (void)id;
+            pack_range& range = m_plan->open_pack(quantity);
+            const std::int64_t clamped = std::max<std::int64_t>(0, weight);
+            const std::int64_t can_add = pack::fit_quantity_fixed(quantity, clamped, range.total_items,
+                                                                  range.total_weight_fixed, max_items, max_weight);
+            if (can_add > 0) {
+                range.total_items += can_add;
+                range.total_weight_fixed += can_add * clamped;
+                range.total_weight = fixed_weight::to_double(range.total_weight_fixed);
+                range.max_length = std::max(range.max_length, std::max(1, length));
+            }
+            return can_add;
+        }
+
+        [[nodiscard]] bool is_empty() const noexcept { return m_plan->m_ranges.back().total_items == 0; }
+
+    private:
+        range_plan* m_plan;
+    };
+
+    /**
+     * @brief Set the capacity rule the plan was (or will be) built with
+     * Needed to skip rows the strategy could not place when expanding.
+     * @param max_weight Maximum weight per pack (clamped like the strategies do)
+     * @param mode Weight representation used while packing
+     */
+    void set_weight_limit(double max_weight, weight_mode mode) noexcept {
+        m_max_weight = std::max(0.1, max_weight);
+        m_weight_mode = mode;
+    }
+
+    [[nodiscard]] double get_max_weight() const noexcept { return m_max_weight; }
+    [[nodiscard]] weight_mode get_weight_mode() const noexcept { return m_weight_mode; }
+
+    /**
+     * @brief Reserve the range table
+     * @param pack_count Expected number of packs
+     */
+    void reserve(size_t pack_count) { m_ranges.reserve(pack_count); }
+
+    /**
+     * @brief Open a new, empty pack at the end
+     * @param pack_number The pack identifier
+     */
+    void emplace_back(std::int64_t pack_number) {
+        pack_range range;
+        range.pack_number = pack_number;
+        m_ranges.push_back(range);
+    }
+
+    /**
+     * @brief Get the open (last) pack; the plan must not be empty
+     * @return open_range Handle for adding items
+     */
+    [[nodiscard]] open_range back() noexcept { return open_range(*this); }
+
+    /**
+     * @brief Tell the plan which row the strategy loop is on
+     * @param row Row (view position) about to be placed
+     * @param quantity Full quantity of that row
+     */
+    void visit_row(size_t row, std::int64_t quantity) noexcept {
+        m_row = row;
+        m_row_quantity = quantity;
+    }
+
+    /**
+     * @brief Append packs [first, last) of another range plan over the same items
+     * @param other Plan to copy from
+     * @param first Index of the first pack to copy
+     * @param last One past the last pack to copy
+     */
+    void append(const range_plan& other, size_t first, size_t last) {
+        if (first >= last) return;
+        m_ranges.insert(m_ranges.end(), other.m_ranges.begin() + first, other.m_ranges.begin() + last);
+    }
+
+    /**
+     * @brief Append all packs of another range plan over the same items
+     * @param other Plan to copy from
+     */
+    void append(const range_plan& other) { append(other, 0, other.size()); }
+
+    /**
+     * @brief Remove all packs, keeping the capacity and the weight limit
+     */
+    void clear() noexcept { m_ranges.clear(); }
+
+    /**
+     * @brief Get the number of packs (including empty ones)
+     * @return size_t Pack count
+     */
+    [[nodiscard]] size_t size() const noexcept { return m_ranges.size(); }
+
+    /**
+     * @brief Check whether the plan holds no packs
+     * @return bool True if empty
+     */
+    [[nodiscard]] bool empty() const noexcept { return m_ranges.empty(); }
+
+    /**
+     * @brief Get the range table
+     * @return const std::vector<pack_range>& Packs in plan order
+     */
+    [[nodiscard]] const std::vector<pack_range>& ranges() const noexcept { return m_ranges; }
+
+    /**
+     * @brief Check whether the packing loops skip a row entirely
+     * @param quantity Row quantity
+     * @param weight Row weight per piece
+     * @return bool True if no piece of the row is ever placed
+     */
+    [[nodiscard]] bool skips_row(std::int64_t quantity, double weight) const noexcept {
+        return quantity <= 0 || exceeds_weight_limit(weight, m_max_weight, m_weight_mode);
+    }
+
+private:
+    // The first successful add of a pack fixes where its run starts
+    pack_range& open_pack(std::int64_t remaining_quantity) noexcept {
+        pack_range& range = m_ranges.back();
+        if (range.total_items == 0) {
+            range.first_row = m_row;
+            range.first_offset = m_row_quantity - remaining_quantity;
+        }
+        return range;
+    }
+
+    std::vector<pack_range> m_ranges;
+    double m_max_weight = std::numeric_limits<double>::max();
+    weight_mode m_weight_mode = weight_mode::FLOATING;
+    size_t m_row = 0;
+    std::int64_t m_row_quantity = 0;
+};
+
+/**
+ * @brief Lazy pack view over a range plan and the items it was built from
+ * Packs expose the same getters as pack; get_items() walks the pack's run
+ * and yields the placements one at a time, so the view renders with
+ * pack_formatter or materializes into a plan_arena without ever holding
+ * all placements.
+ */
+class range_plan_view {
+public:
+    /**
+     * @brief Input range over the placements of one pack
+     */
+    class placement_range {
+    public:
+        class iterator {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = item;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = item;
+
+            iterator() noexcept = default;
+            iterator(const range_plan_view* view, size_t row, std::int64_t offset,
+                     std::int64_t remaining) noexcept
+                : m_view(view), m_row(row), m_offset(offset), m_remaining(remaining) {
+                settle();
+            }
+
+            item operator*() const noexcept {
+                const item_column_view& items = m_view->m_items;
+                const size_t r = items.row(m_row);
+                const std::int64_t take = std::min<std::int64_t>(items.quantities[r] - m_offset, m_remaining);
+                const double weight = m_view->m_plan->get_weight_mode() == weight_mode::FIXED_POINT
+                    ? fixed_weight::to_double(fixed_weight::from_double(items.weights[r]))
+                    : std::max(0.0, items.weights[r]);
+                return item(items.ids[r], std::max(1, items.lengths[r]), take, weight);
+            }
+
+            iterator& operator++() noexcept {
+                const item_column_view& items = m_view->m_items;
+                m_remaining -= std::min(items.quantities[items.row(m_row)] - m_offset, m_remaining);
+                ++m_row;
+                m_offset = 0;
+                settle();
+                return *this;
+            }
+
+            void operator++(int) noexcept { ++*this; }
+
+            // Iterators only compare equal once exhausted
+            bool operator==(const iterator& other) const noexcept {
+                return m_remaining == other.m_remaining;
+            }
+
+        private:
+            // Skip rows the packing loop never placed
+            void settle() noexcept {
+                if (m_remaining <= 0) return;
+                const item_column_view& items = m_view->m_items;
+                while (m_row < items.size()) {
+                    const size_t r = items.row(m_row);
+                    if (!m_view->m_plan->skips_row(items.quantities[r], items.weights[r]) &&
+                        items.quantities[r] > m_offset) {
+                        return;
+                    }
+                    ++m_row;
+                    m_offset = 0;
+                }
+                m_remaining = 0;  // SAFETY: never walk past the items
+            }
+
+            const range_plan_view* m_view = nullptr;
+            size_t m_row = 0;
+            std::int64_t m_offset = 0;
+            std::int64_t m_remaining = 0;
+        };
+
+        placement_range(const range_plan_view& view, const range_plan::pack_range& range) noexcept
+            : m_view(&view), m_range(&range) {}
+
+        [[nodiscard]] iterator begin() const noexcept {
+            return iterator(m_view, m_range->first_row, m_range->first_offset, m_range->total_items);
+        }
+        [[nodiscard]] iterator end() const noexcept { return iterator(); }
+
+    private:
+        const range_plan_view* m_view;
+        const range_plan::pack_range* m_range;
+    };
+
+    /**
+     * @brief Read-only view of one pack with the same getters as pack
+     */
+    class pack_ref {
+    public:
+        pack_ref(const range_plan_view& view, const range_plan::pack_range& range) noexcept
+            : m_view(&view), m_range(&range) {}
+
+        [[nodiscard]] std::int64_t get_pack_number() const noexcept { return m_range->pack_number; }
+        [[nodiscard]] std::int64_t get_total_items() const noexcept { return m_range->total_items; }
+        [[nodiscard]] double get_total_weight() const noexcept { return m_range->total_weight; }
+        [[nodiscard]] int get_pack_length() const noexcept { return m_range->max_length; }
+        [[nodiscard]] bool is_empty() const noexcept { return m_range->total_items == 0; }
+
+        /**
+         * @brief Get the placements of this pack, expanded lazily
+         * @return placement_range Input range yielding one item per placement
+         */
+        [[nodiscard]] placement_range get_items() const noexcept { return placement_range(*m_view, *m_range); }
+
+        /**
+         * @brief Expand the pack into a standalone pack object
+         * @return pack Equivalent pack
+         */
+        [[nodiscard]] pack to_pack() const {
+            pack p(m_range->pack_number);
+            const bool fixed = m_view->m_plan->get_weight_mode() == weight_mode::FIXED_POINT;
+            for (const auto& i : get_items()) {
+                // Unlimited capacity: the totals are re-accumulated in the same order
+                if (fixed) {
+                    (void)p.add_partial_item_fixed(i.get_id(), i.get_length(), i.get_quantity(),
+                                                   i.get_fixed_weight(), std::numeric_limits<int>::max(),
+                                                   fixed_weight::MAX_VALUE);
+                } else {
+                    (void)p.add_item(i, std::numeric_limits<int>::max(), std::numeric_limits<double>::max());
+                }
+            }
+            return p;
+        }
+
+        /**
+         * @brief Get string representation of the pack (same as pack::to_string())
+         * @return std::string The string representation
+         */
+        [[nodiscard]] std::string to_string() const { return to_pack().to_string(); }
+
+    private:
+        const range_plan_view* m_view;
+        const range_plan::pack_range* m_range;
+    };
+
+    /**
+     * @brief Forward iterator yielding pack_ref values
+     */
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = pack_ref;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = pack_ref;
+
+        const_iterator() noexcept = default;
+        const_iterator(const range_plan_view* view, size_t index) noexcept : m_view(view), m_index(index) {}
+
+        pack_ref operator*() const noexcept { return (*m_view)[m_index]; }
+        const_iterator& operator++() noexcept { ++m_index; return *this; }
+        const_iterator operator++(int) noexcept { const_iterator old = *this; ++m_index; return old; }
+        bool operator==(const const_iterator& other) const noexcept = default;
+
+    private:
+        const range_plan_view* m_view = nullptr;
+        size_t m_index = 0;
+    };
+
+    /**
+     * @brief Construct a view; both arguments must outlive it
+     * @param plan Range plan
+     * @param items The items the plan was built from, in packing order
+     */
+    range_plan_view(const range_plan& plan, const item_column_view& items) noexcept
+        : m_plan(&plan), m_items(items) {}
+
+    [[nodiscard]] size_t size() const noexcept { return m_plan->size(); }
+    [[nodiscard]] bool empty() const noexcept { return m_plan->empty(); }
+
+    /**
+     * @brief Get a view of one pack
+     * @param i Pack index (must be < size())
+     * @return pack_ref View of the pack
+     */
+    [[nodiscard]] pack_ref operator[](size_t i) const noexcept { return pack_ref(*this, m_plan->ranges()[i]); }
+
+    [[nodiscard]] const_iterator begin() const noexcept { return const_iterator(this, 0); }
+    [[nodiscard]] const_iterator end() const noexcept { return const_iterator(this, size()); }
+
+    /**
+     * @brief Expand every pack into a flat plan arena
+     * @return plan_arena Equivalent plan with explicit placements
+     */
+    [[nodiscard]] plan_arena to_arena() const {
+        plan_arena arena;
+        arena.reserve(size());
+        for (const auto p : *this) {
+            arena.append(p.to_pack());
+        }
+        return arena;
+    }
+
+private:
+    const range_plan* m_plan;
+    item_column_view m_items;
+};
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <new>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Bounded single-producer/single-consumer ring buffer
+ * One thread pushes, one thread pops. Both ends spin briefly and then yield
+ * while the ring is full (producer) or empty (consumer). The producer calls
+ * close() after its last push; pop() then drains the ring and returns false.
+ * @tparam T Element type (default constructible and movable)
+ */
+template <typename T>
+class spsc_ring {
+public:
+    /**
+     * @brief Construct a new ring
+     * @param capacity Maximum number of queued elements (rounded up to a power of two)
+     */
+    explicit spsc_ring(size_t capacity)
+        : m_slots(std::bit_ceil(std::max<size_t>(2, capacity))),
+          m_mask(m_slots.size() - 1) {}
+
+    spsc_ring(const spsc_ring&) = delete;
+    spsc_ring& operator=(const spsc_ring&) = delete;
+
+    /**
+     * @brief Try to enqueue without waiting (producer only)
+     * @param value Element to move in; left untouched if the ring is full
+     * @return bool True if the element was enqueued
+     */
+    bool try_push(T& value) {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head_cache == m_slots.size()) {
+            m_head_cache = m_head.load(std::memory_order_acquire);
+            if (tail - m_head_cache == m_slots.size()) return false;
+        }
+        m_slots[tail & m_mask] = std::move(value);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Enqueue, waiting while the ring is full (producer only)
+     * @param value Element to move in
+     */
+    void push(T value) {
+        for (unsigned spins = 0; !try_push(value); ++spins) {
+            backoff(spins);
+        }
+    }
+
+    /**
+     * @brief Try to dequeue without waiting (consumer only)
+     * @param value Receives the element
+     * @return bool True if an element was dequeued
+     */
+    bool try_pop(T& value) {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail_cache) {
+            m_tail_cache = m_tail.load(std::memory_order_acquire);
+            if (head == m_tail_cache) return false;
+        }
+        value = std::move(m_slots[head & m_mask]);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Dequeue, waiting while the ring is empty and open (consumer only)
+     * @param value Receives the element
+     * @return bool False once the ring is closed and drained
+     */
+    bool pop(T& value) {
+        for (unsigned spins = 0;; ++spins) {
+            if (try_pop(value)) return true;
+            if (m_closed.load(std::memory_order_acquire)) {
+                // Elements pushed before close() are visible after the acquire
+                return try_pop(value);
+            }
+            backoff(spins);
+        }
+    }
+
+    /**
+     * @brief Mark the end of the stream (producer only, after the last push)
+     */
+    void close() noexcept { m_closed.store(true, std::memory_order_release); }
+
+    /**
+     * @brief Get the ring capacity
+     * @return size_t Maximum number of queued elements
+     */
+    [[nodiscard]] size_t capacity() const noexcept { return m_slots.size(); }
+
+private:
+    static void backoff(unsigned spins) noexcept {
+        if (spins >= SPIN_LIMIT) {
+            std::this_thread::yield();
+        }
+    }
+
+    static constexpr unsigned SPIN_LIMIT = 64;
+    static constexpr size_t CACHE_LINE = 64;
+
+    std::vector<T> m_slots;
+    const size_t m_mask;
+
+    // Producer and consumer indices live on separate cache lines
+    alignas(CACHE_LINE) std::atomic<size_t> m_tail{0};
+    size_t m_head_cache = 0;
+    alignas(CACHE_LINE) std::atomic<size_t> m_head{0};
+    size_t m_tail_cache = 0;
+    alignas(CACHE_LINE) std::atomic<bool> m_closed{false};
+};
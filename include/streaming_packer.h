@@ -0,0 +1,138 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include "item.h"
+#include "pack.h"
+
+/**
+ * @brief Incremental next-fit packer for unbounded item streams
+ * Items are packed as they arrive with the same rules as
+ * blocking_pack_strategy; a pack is handed to the sink as soon as the next
+ * one is opened, so memory stays O(1) packs regardless of input size.
+ */
+class streaming_packer {
+public:
+    using pack_sink = std::function<void(const pack&)>;
+
+    /**
+     * @brief Construct a new streaming packer
+     * @param max_items Maximum items per pack
+     * @param max_weight Maximum weight per pack
+     * @param sink Callback receiving every sealed, non-empty pack in order
+     */
+    streaming_packer(int max_items, double max_weight, pack_sink sink)
+        : m_max_items(std::max(1, max_items)),
+          m_max_weight(std::max(0.1, max_weight)),
+          m_sink(std::move(sink)),
+          m_current(1) {}
+
+    /**
+     * @brief Pack one item, emitting any packs it seals
+     * @param i Item to pack
+     */
+    void add_item(const item& i) {
+        add_item(i.get_id(), i.get_length(), i.get_quantity(), i.get_weight());
+    }
+
+    /**
+     * @brief Pack one item given by its fields (e.g. a row of a column view)
+     * @param id Item id
+     * @param length Item length
+     * @param quantity Number of pieces
+     * @param weight Weight per piece
+     */
+    void add_item(int id, int length, std::int64_t quantity, double weight) {
+        if (quantity <= 0) return;
+
+        std::int64_t remaining_quantity = quantity;
+        m_total_items += remaining_quantity;
+
+        while (remaining_quantity > 0) {
+            if (m_current.is_empty()) {
+                remaining_quantity -= fill_full_packs(id, length, remaining_quantity, weight);
+                if (remaining_quantity == 0) break;
+            }
+
+            const std::int64_t added = m_current.add_partial_item(
+                id, length, remaining_quantity, weight, m_max_items, m_max_weight);
+
+            if (added > 0) {
+                remaining_quantity -= added;
+                continue;
+            }
+
+            // Item can never fit, or an empty pack rejected it: drop the rest
+            if (weight > m_max_weight || m_current.is_empty()) {
+                m_total_items -= remaining_quantity;
+                m_unplaced_items += remaining_quantity;
+                break;
+            }
+
+            seal_current();
+        }
+    }
+
+    /**
+     * @brief Emit the last open pack (if it holds anything)
+     */
+    void finish() {
+        if (!m_current.is_empty()) {
+            m_sink(m_current);
+            ++m_emitted_packs;
+        }
+    }
+
+    /**
+     * @brief Get the number of packs handed to the sink so far
+     * @return size_t Emitted pack count
+     */
+    [[nodiscard]] size_t get_emitted_packs() const noexcept { return m_emitted_packs; }
+
+    /**
+     * @brief Get the number of pieces placed into packs so far
+     * @return std::int64_t Total pieces packed
+     */
+    [[nodiscard]] std::int64_t get_total_items() const noexcept { return m_total_items; }
+
+    /**
+     * @brief Get the number of pieces dropped because no pack can hold them
+     * @return std::int64_t Pieces heavier than a whole pack
+     */
+    [[nodiscard]] std::int64_t get_unplaced_items() const noexcept { return m_unplaced_items; }
+
+private:
+    // A run spanning several packs fills each with the same pieces: build the
+    // pack once and hand it to the sink under consecutive numbers. The last
+    // full pack stays open, as the per-pack loop would leave it.
+    std::int64_t fill_full_packs(int id, int length, std::int64_t quantity, double weight) {
+        const std::int64_t per_pack = pack::fit_quantity(quantity, std::max(0.0, weight), 0, 0.0,
+                                                         m_max_items, m_max_weight);
+        if (per_pack <= 0 || quantity / per_pack < 2) return 0;
+
+        const std::int64_t full = quantity / per_pack;
+        (void)m_current.add_partial_item(id, length, per_pack, weight, m_max_items, m_max_weight);
+        for (std::int64_t n = 1; n < full; ++n) {
+            m_sink(m_current);
+            ++m_emitted_packs;
+            m_current.set_pack_number(m_current.get_pack_number() + 1);
+        }
+        return full * per_pack;
+    }
+
+    void seal_current() {
+        m_sink(m_current);
+        ++m_emitted_packs;
+        m_current = pack(m_current.get_pack_number() + 1);
+    }
+
+    int m_max_items;
+    double m_max_weight;
+    pack_sink m_sink;
+    pack m_current;
+    size_t m_emitted_packs = 0;
+    std::int64_t m_total_items = 0;
+    std::int64_t m_unplaced_items = 0;
+};
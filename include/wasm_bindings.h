@@ -11,6 +11,7 @@
 #include <string>
 #include <chrono>
 #include <cmath>
+#include <cstdint>
 #include <random>
 #include <algorithm>
 
@@ -195,7 +196,7 @@ public:
             items.emplace_back(
                 jsItem[0].as<int>(),    // id
                 jsItem[1].as<int>(),    // length
-                jsItem[2].as<int>(),    // quantity
+                static_cast<std::int64_t>(jsItem[2].as<double>()),  // quantity
                 jsItem[3].as<double>()  // weight
             );
         }
@@ -234,7 +235,7 @@ public:
             items.emplace_back(
                 jsItem[0].as<int>(),    // id
                 jsItem[1].as<int>(),    // length
-                jsItem[2].as<int>(),    // quantity
+                static_cast<std::int64_t>(jsItem[2].as<double>()),  // quantity
                 jsItem[3].as<double>()  // weight
             );
         }
@@ -256,7 +257,7 @@ public:
         stats.set("sortingTime", result.sorting_time);
         stats.set("packingTime", result.packing_time);
         stats.set("totalTime", result.total_time);
-        stats.set("totalItems", result.total_items);
+        stats.set("totalItems", static_cast<double>(result.total_items));
         stats.set("utilizationPercent", result.utilization_percent);
         stats.set("strategyName", result.strategy_name);
         stats.set("packCount", result.packs.size());
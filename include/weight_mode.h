@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Numeric representation used for weight capacity checks
+ */
+enum class weight_mode {
+    FLOATING,    // double weights, capacity by floating-point division
+    FIXED_POINT  // weights rounded to integer thousandths, exact integer capacity checks
+};
+
+/**
+ * @brief Parse a string to get the corresponding weight_mode
+ * @param str The string to parse
+ * @return weight_mode The parsed mode (FLOATING if unknown)
+ */
+[[nodiscard]] inline weight_mode parse_weight_mode(const std::string& str) noexcept {
+    if (str == "FIXED_POINT") return weight_mode::FIXED_POINT;
+    return weight_mode::FLOATING;
+}
+
+/**
+ * @brief Convert a weight_mode to its string representation
+ * @param mode The mode to convert
+ * @return std::string The string representation
+ */
+[[nodiscard]] inline std::string weight_mode_to_string(weight_mode mode) noexcept {
+    return mode == weight_mode::FIXED_POINT ? "FIXED_POINT" : "FLOATING";
+}
+
+/**
+ * @brief Conversions between double weights and fixed-point thousandths
+ * The output format prints item weights with 3 decimals, so one unit is the
+ * smallest weight step the spec can express (a milligram for kg weights).
+ */
+namespace fixed_weight {
+
+inline constexpr std::int64_t SCALE = 1000;
+
+// Saturation bound; a pack total never exceeds its capacity, so sums and
+// quantity * weight products stay far from int64 overflow
+inline constexpr std::int64_t MAX_VALUE = std::int64_t{1} << 62;
+
+/**
+ * @brief Round a weight to the nearest thousandth
+ * @param weight Weight as double
+ * @return std::int64_t Weight in thousandths, clamped to [0, MAX_VALUE] (NaN -> 0)
+ */
+[[nodiscard]] inline std::int64_t from_double(double weight) noexcept {
+    if (!(weight > 0.0)) return 0;
+    if (weight >= static_cast<double>(MAX_VALUE / SCALE)) return MAX_VALUE;
+    return std::llround(weight * static_cast<double>(SCALE));
+}
+
+/**
+ * @brief Convert thousandths back to a double weight
+ * @param weight Weight in thousandths
+ * @return double Weight
+ */
+[[nodiscard]] inline double to_double(std::int64_t weight) noexcept {
+    return static_cast<double>(weight) / static_cast<double>(SCALE);
+}
+
+} // namespace fixed_weight
+
+/**
+ * @brief Check whether one piece is heavier than a pack may hold
+ * Same comparison the packing loops use to skip an item, in the units of
+ * the weight mode.
+ * @param weight Weight per piece
+ * @param max_weight Maximum weight per pack
+ * @param mode Weight representation used while packing
+ * @return bool True if no piece of the item can ever be packed
+ */
+[[nodiscard]] inline bool exceeds_weight_limit(double weight, double max_weight, weight_mode mode) noexcept {
+    if (mode == weight_mode::FIXED_POINT) {
+        return fixed_weight::from_double(weight) > fixed_weight::from_double(max_weight);
+    }
+    return weight > max_weight;
+}
+
+/**
+ * @brief Weight policy for the packing loops: double weights
+ */
+struct floating_weights {
+    using value_type = double;
+
+    [[nodiscard]] static constexpr double convert(double weight) noexcept { return weight; }
+
+    template <typename Pack>
+    [[nodiscard]] static std::int64_t add_partial_item(Pack& p, int id, int length, std::int64_t quantity,
+                                                       double weight, int max_items, double max_weight) {
+        return p.add_partial_item(id, length, quantity, weight, max_items, max_weight);
+    }
+
+    /**
+     * @brief Weight a pack can still take, computed as fit_quantity does
+     */
+    template <typename Pack>
+    [[nodiscard]] static double remaining_weight(const Pack& p, double max_weight) noexcept {
+        return max_weight - p.get_total_weight();
+    }
+};
+
+/**
+ * @brief Weight policy for the packing loops: integer thousandths
+ */
+struct fixed_weights {
+    using value_type = std::int64_t;
+
+    [[nodiscard]] static std::int64_t convert(double weight) noexcept {
+        return fixed_weight::from_double(weight);
+    }
+
+    template <typename Pack>
+    [[nodiscard]] static std::int64_t add_partial_item(Pack& p, int id, int length, std::int64_t quantity,
+                                                       std::int64_t weight, int max_items,
+                                                       std::int64_t max_weight) {
+        return p.add_partial_item_fixed(id, length, quantity, weight, max_items, max_weight);
+    }
+
+    /**
+     * @brief Weight a pack can still take, in thousandths
+     */
+    template <typename Pack>
+    [[nodiscard]] static std::int64_t remaining_weight(const Pack& p, std::int64_t max_weight) noexcept {
+        return max_weight - p.get_total_weight_fixed();
+    }
+};
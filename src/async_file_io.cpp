@@ -0,0 +1,511 @@
+#include "async_file_io.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define PACK_PLANNER_IO_URING 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+#ifdef PACK_PLANNER_IO_URING
+
+/**
+ * @brief Minimal io_uring wrapper on raw syscalls (no liburing dependency)
+ * Only what the reader and writer need: queue a read or write, submit, and
+ * reap completions. Used from a single thread.
+ */
+class io_uring_queue {
+public:
+    struct completion {
+        unsigned long long user_data;
+        int result;
+    };
+
+    ~io_uring_queue() {
+        if (m_sqes != nullptr) ::munmap(m_sqes, m_sqes_size);
+        if (m_cq_ptr != nullptr && m_cq_ptr != m_sq_ptr) ::munmap(m_cq_ptr, m_cq_size);
+        if (m_sq_ptr != nullptr) ::munmap(m_sq_ptr, m_sq_size);
+        if (m_fd >= 0) ::close(m_fd);
+    }
+
+    /**
+     * @brief Create the ring
+     * @param entries Submission queue size
+     * @return bool False if io_uring is unavailable
+     */
+    bool init(unsigned entries) noexcept {
+        io_uring_params params{};
+        m_fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+        if (m_fd < 0) return false;
+
+        m_sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        m_cq_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single_mmap) {
+            m_sq_size = m_cq_size = std::max(m_sq_size, m_cq_size);
+        }
+
+        m_sq_ptr = ::mmap(nullptr, m_sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                          m_fd, IORING_OFF_SQ_RING);
+        if (m_sq_ptr == MAP_FAILED) {
+            m_sq_ptr = nullptr;
+            return false;
+        }
+        m_cq_ptr = single_mmap ? m_sq_ptr :
+                   ::mmap(nullptr, m_cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                          m_fd, IORING_OFF_CQ_RING);
+        if (m_cq_ptr == MAP_FAILED) {
+            m_cq_ptr = nullptr;
+            return false;
+        }
+
+        m_sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+        void* sqes = ::mmap(nullptr, m_sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                            m_fd, IORING_OFF_SQES);
+        if (sqes == MAP_FAILED) return false;
+        m_sqes = static_cast<io_uring_sqe*>(sqes);
+
+        auto* sq = static_cast<char*>(m_sq_ptr);
+        m_sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        m_sq_mask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        m_sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+        auto* cq = static_cast<char*>(m_cq_ptr);
+        m_cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        m_cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        m_cq_mask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        m_cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        return true;
+    }
+
+    // Queue and submit a read of [offset, offset + size) into buffer
+    bool submit_read(int fd, void* buffer, size_t size, size_t offset,
+                     unsigned long long user_data) noexcept {
+        return submit(IORING_OP_READ, fd, buffer, size, offset, user_data);
+    }
+
+    // Queue and submit a write of buffer to [offset, offset + size)
+    bool submit_write(int fd, const void* buffer, size_t size, size_t offset,
+                      unsigned long long user_data) noexcept {
+        return submit(IORING_OP_WRITE, fd, const_cast<void*>(buffer), size, offset, user_data);
+    }
+
+    /**
+     * @brief Get one completion
+     * @param wait Block until a completion is available
+     * @param out Receives the completion
+     * @return bool True if a completion was returned
+     */
+    bool reap(bool wait, completion& out) noexcept;
+
+private:
+    // Queue one request and submit it
+    bool submit(unsigned char opcode, int fd, void* buffer, size_t size, size_t offset,
+                unsigned long long user_data) noexcept {
+        const unsigned tail = std::atomic_ref<unsigned>(*m_sq_tail).load(std::memory_order_relaxed);
+        const unsigned index = tail & m_sq_mask;
+
+        io_uring_sqe& sqe = m_sqes[index];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = opcode;
+        sqe.fd = fd;
+        sqe.addr = reinterpret_cast<unsigned long long>(buffer);
+        sqe.len = static_cast<unsigned>(size);
+        sqe.off = offset;
+        sqe.user_data = user_data;
+        m_sq_array[index] = index;
+
+        std::atomic_ref<unsigned>(*m_sq_tail).store(tail + 1, std::memory_order_release);
+        return enter(1, 0, 0) >= 0;
+    }
+
+    int enter(unsigned to_submit, unsigned min_complete, unsigned flags) noexcept {
+        return static_cast<int>(::syscall(__NR_io_uring_enter, m_fd, to_submit, min_complete,
+                                          flags, nullptr, 0));
+    }
+
+    int m_fd = -1;
+    void* m_sq_ptr = nullptr;
+    void* m_cq_ptr = nullptr;
+    size_t m_sq_size = 0;
+    size_t m_cq_size = 0;
+    size_t m_sqes_size = 0;
+    io_uring_sqe* m_sqes = nullptr;
+    unsigned* m_sq_tail = nullptr;
+    unsigned* m_sq_array = nullptr;
+    unsigned m_sq_mask = 0;
+    unsigned* m_cq_head = nullptr;
+    unsigned* m_cq_tail = nullptr;
+    unsigned m_cq_mask = 0;
+    io_uring_cqe* m_cqes = nullptr;
+};
+
+bool io_uring_queue::reap(bool wait, completion& out) noexcept {
+    for (;;) {
+        const unsigned head = std::atomic_ref<unsigned>(*m_cq_head).load(std::memory_order_relaxed);
+        const unsigned tail = std::atomic_ref<unsigned>(*m_cq_tail).load(std::memory_order_acquire);
+        if (head != tail) {
+            const io_uring_cqe& cqe = m_cqes[head & m_cq_mask];
+            out.user_data = cqe.user_data;
+            out.result = cqe.res;
+            std::atomic_ref<unsigned>(*m_cq_head).store(head + 1, std::memory_order_release);
+            return true;
+        }
+        if (!wait) return false;
+        if (enter(0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR) return false;
+    }
+}
+
+#else
+
+// io_uring is Linux-only: every instance reports itself unavailable
+class io_uring_queue {
+public:
+    struct completion {
+        unsigned long long user_data;
+        int result;
+    };
+
+    bool init(unsigned) noexcept { return false; }
+    bool submit_read(int, void*, size_t, size_t, unsigned long long) noexcept { return false; }
+    bool submit_write(int, const void*, size_t, size_t, unsigned long long) noexcept { return false; }
+    bool reap(bool, completion&) noexcept { return false; }
+};
+
+#endif
+
+bool io_uring_available() noexcept {
+    io_uring_queue queue;
+    return queue.init(2);
+}
+
+namespace {
+
+std::unique_ptr<io_uring_queue> make_queue(io_backend backend, unsigned queue_depth) {
+    if (backend != io_backend::IO_URING) return nullptr;
+    auto queue = std::make_unique<io_uring_queue>();
+    if (!queue->init(queue_depth)) return nullptr;
+    return queue;
+}
+
+}  // namespace
+
+// ---------------------------------------------------------------------------
+// async_file_reader
+
+async_file_reader::async_file_reader() noexcept = default;
+
+async_file_reader::~async_file_reader() {
+    close();
+}
+
+bool async_file_reader::open(const std::string& path, unsigned queue_depth, size_t block_bytes,
+                             io_backend backend) {
+    close();
+
+    m_fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (m_fd < 0) return false;
+
+    struct stat st;
+    if (::fstat(m_fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        close();
+        return false;
+    }
+#ifdef POSIX_FADV_SEQUENTIAL
+    ::posix_fadvise(m_fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+    queue_depth = std::clamp(queue_depth, 1u, 256u);
+    m_block_bytes = std::max<size_t>(4096, block_bytes);
+    m_file_size = static_cast<size_t>(st.st_size);
+    m_next_submit = 0;
+    m_next_deliver = 0;
+    m_failed = false;
+
+    m_queue = make_queue(backend, queue_depth);
+    m_backend = m_queue ? io_backend::IO_URING : io_backend::BLOCKING;
+    const size_t slot_count = m_queue ? queue_depth : 1;
+    m_slots.assign(slot_count, std::string());
+    m_results.assign(slot_count, -1);
+
+    submit_reads();
+    return true;
+}
+
+void async_file_reader::submit_reads() {
+    if (!m_queue) return;
+
+    const size_t block_count = (m_file_size + m_block_bytes - 1) / m_block_bytes;
+    while (m_next_submit < block_count && m_next_submit - m_next_deliver < m_slots.size()) {
+        const size_t slot = m_next_submit % m_slots.size();
+        const size_t offset = m_next_submit * m_block_bytes;
+        const size_t size = std::min(m_block_bytes, m_file_size - offset);
+
+        m_slots[slot].resize(size);
+        m_results[slot] = -1;
+        if (!m_queue->submit_read(m_fd, m_slots[slot].data(), size, offset, slot)) {
+            m_failed = true;
+            return;
+        }
+        ++m_next_submit;
+    }
+}
+
+bool async_file_reader::next_block(std::string& block) {
+    if (m_fd < 0 || m_failed) return false;
+
+    const size_t offset = m_next_deliver * m_block_bytes;
+    if (offset >= m_file_size) return false;
+    const size_t size = std::min(m_block_bytes, m_file_size - offset);
+
+    if (!m_queue) {
+        block.resize(size);
+        size_t done = 0;
+        while (done < size) {
+            const ssize_t n = ::pread(m_fd, block.data() + done, size - done, offset + done);
+            if (n <= 0) {
+                if (n < 0 && errno == EINTR) continue;
+                m_failed = true;
+                return false;
+            }
+            done += static_cast<size_t>(n);
+        }
+        ++m_next_deliver;
+        return true;
+    }
+
+    // Completions can arrive out of order; wait until this block's read is done
+    const size_t slot = m_next_deliver % m_slots.size();
+    while (m_results[slot] < 0) {
+        io_uring_queue::completion cqe;
+        if (!m_queue->reap(true, cqe)) {
+            m_failed = true;
+            return false;
+        }
+        m_results[cqe.user_data] = std::max(0, cqe.result);
+        if (cqe.result < 0) {
+            m_failed = true;
+            return false;
+        }
+    }
+
+    // SAFETY: Finish a short read synchronously rather than returning a hole
+    size_t done = static_cast<size_t>(m_results[slot]);
+    while (done < size) {
+        const ssize_t n = ::pread(m_fd, m_slots[slot].data() + done, size - done, offset + done);
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR) continue;
+            m_failed = true;
+            return false;
+        }
+        done += static_cast<size_t>(n);
+    }
+
+    // Hand the filled buffer out and recycle the caller's old one for the next read
+    block.swap(m_slots[slot]);
+    ++m_next_deliver;
+    submit_reads();
+    return true;
+}
+
+void async_file_reader::close() noexcept {
+    if (m_queue) {
+        // SAFETY: The kernel may still write into the slot buffers; drain first
+        size_t outstanding = 0;
+        for (size_t block = m_next_deliver; block < m_next_submit; ++block) {
+            outstanding += m_results[block % m_slots.size()] < 0 ? 1 : 0;
+        }
+        io_uring_queue::completion cqe;
+        while (outstanding > 0 && m_queue->reap(true, cqe)) {
+            m_results[cqe.user_data] = std::max(0, cqe.result);
+            --outstanding;
+        }
+        m_queue.reset();
+    }
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+    m_slots.clear();
+    m_results.clear();
+    m_next_submit = m_next_deliver = 0;
+}
+
+// ---------------------------------------------------------------------------
+// async_file_writer
+
+async_file_writer::async_file_writer() noexcept = default;
+
+async_file_writer::~async_file_writer() {
+    close();
+}
+
+bool async_file_writer::open(const std::string& path, unsigned queue_depth, size_t block_bytes,
+                             io_backend backend) {
+    close();
+
+    m_fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (m_fd < 0) return false;
+
+    queue_depth = std::clamp(queue_depth, 1u, 256u);
+    m_block_bytes = std::max<size_t>(4096, block_bytes);
+    m_offset = 0;
+    m_current = 0;
+    m_pending = 0;
+    m_failed = false;
+
+    m_queue = make_queue(backend, queue_depth);
+    m_backend = m_queue ? io_backend::IO_URING : io_backend::BLOCKING;
+    const size_t slot_count = m_queue ? queue_depth : 1;
+    m_slots.assign(slot_count, std::string());
+    m_slot_offsets.assign(slot_count, 0);
+    m_in_flight.assign(slot_count, 0);
+    m_slots[0].reserve(m_block_bytes);
+    return true;
+}
+
+bool async_file_writer::write_blocking(const char* data, size_t size, size_t offset) noexcept {
+    while (size > 0) {
+        const ssize_t n = ::pwrite(m_fd, data, size, static_cast<off_t>(offset));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += n;
+        size -= static_cast<size_t>(n);
+        offset += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+bool async_file_writer::write(const char* data, size_t size) {
+    if (m_fd < 0 || m_failed) return false;
+
+    while (size > 0) {
+        std::string& slot = m_slots[m_current];
+        const size_t take = std::min(size, m_block_bytes - slot.size());
+        slot.append(data, take);
+        data += take;
+        size -= take;
+
+        if (slot.size() == m_block_bytes) {
+            submit_current();
+            if (m_failed) return false;
+        }
+    }
+    return true;
+}
+
+void async_file_writer::submit_current() {
+    std::string& slot = m_slots[m_current];
+    if (slot.empty()) return;
+
+    if (!m_queue) {
+        m_failed |= !write_blocking(slot.data(), slot.size(), m_offset);
+        m_offset += slot.size();
+        slot.clear();
+        return;
+    }
+
+    m_slot_offsets[m_current] = m_offset;
+    m_in_flight[m_current] = 1;
+    ++m_pending;
+    if (!m_queue->submit_write(m_fd, slot.data(), slot.size(), m_offset, m_current)) {
+        m_in_flight[m_current] = 0;
+        --m_pending;
+        m_failed = true;
+        return;
+    }
+    m_offset += slot.size();
+
+    // Continue in the next slot once its previous write has completed
+    m_current = (m_current + 1) % m_slots.size();
+    while (m_in_flight[m_current]) {
+        reap(true);
+        if (m_failed) return;
+    }
+    m_slots[m_current].clear();
+    m_slots[m_current].reserve(m_block_bytes);
+}
+
+void async_file_writer::reap(bool wait) {
+    io_uring_queue::completion cqe;
+    while (m_pending > 0) {
+        if (!m_queue->reap(wait, cqe)) {
+            // A blocking reap only comes back empty on a ring error; nothing more will complete
+            m_failed |= wait;
+            return;
+        }
+        const size_t slot = cqe.user_data;
+        m_in_flight[slot] = 0;
+        --m_pending;
+
+        const std::string& data = m_slots[slot];
+        if (cqe.result < 0) {
+            m_failed = true;
+        } else if (static_cast<size_t>(cqe.result) < data.size()) {
+            // SAFETY: Short write; finish the remainder synchronously
+            const size_t done = static_cast<size_t>(cqe.result);
+            m_failed |= !write_blocking(data.data() + done, data.size() - done,
+                                        m_slot_offsets[slot] + done);
+        }
+        wait = false;  // one completion satisfies a blocking reap
+    }
+}
+
+bool async_file_writer::close() noexcept {
+    if (m_fd < 0) return !m_failed;
+
+    if (!m_failed) {
+        submit_current();
+    }
+    if (m_queue) {
+        while (m_pending > 0) {
+            const size_t before = m_pending;
+            reap(true);
+            if (m_pending == before) break;  // ring error; nothing more will complete
+        }
+        m_queue.reset();
+    }
+
+    m_failed |= ::close(m_fd) != 0;
+    m_fd = -1;
+    m_slots.clear();
+    return !m_failed;
+}
+
+// ---------------------------------------------------------------------------
+// async_ofstream
+
+async_ofstream::async_ofstream(const std::string& path, unsigned queue_depth, io_backend backend)
+    : std::ostream(&m_buffer) {
+    if (!m_buffer.writer.open(path, queue_depth, async_file_writer::DEFAULT_BLOCK_BYTES, backend)) {
+        setstate(std::ios::failbit);
+    }
+}
+
+void async_ofstream::close() {
+    if (!m_buffer.writer.close()) {
+        setstate(std::ios::failbit);
+    }
+}
+
+async_ofstream::writer_streambuf::int_type async_ofstream::writer_streambuf::overflow(int_type ch) {
+    if (traits_type::eq_int_type(ch, traits_type::eof())) {
+        return traits_type::not_eof(ch);
+    }
+    const char c = traits_type::to_char_type(ch);
+    return writer.write(&c, 1) ? ch : traits_type::eof();
+}
+
+std::streamsize async_ofstream::writer_streambuf::xsputn(const char* data, std::streamsize count) {
+    return writer.write(data, static_cast<size_t>(count)) ? count : 0;
+}
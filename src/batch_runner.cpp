@@ -0,0 +1,287 @@
+#include "batch_runner.h"
+#include "binary_item_file.h"
+#include "csv_ingest.h"
+#include "csv_scanner.h"
+#ifdef PACK_PLANNER_HAVE_ZLIB
+#include "gzip_stream.h"
+#endif
+#include "timer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <numeric>
+#include <set>
+#include <system_error>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+batch_runner::batch_runner(unsigned int worker_count) noexcept
+    : m_worker_count(worker_count) {
+    if (m_worker_count == 0) {
+        m_worker_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+}
+
+bool batch_runner::collect_jobs(const std::string& source, const std::string& output_dir,
+                                std::vector<batch_job>& jobs) {
+    jobs.clear();
+
+    std::error_code ec;
+    std::vector<std::string> inputs;
+    if (fs::is_directory(source, ec)) {
+        for (const auto& entry : fs::directory_iterator(source, ec)) {
+            const std::string name = entry.path().filename().string();
+            if (!name.empty() && name.front() != '.' && entry.is_regular_file(ec)) {
+                inputs.push_back(entry.path().string());
+            }
+        }
+        if (ec) return false;
+        std::sort(inputs.begin(), inputs.end());
+    } else {
+        std::ifstream list(source);
+        if (!list.is_open()) return false;
+        std::string line;
+        while (std::getline(list, line)) {
+            while (!line.empty() && std::isspace(static_cast<unsigned char>(line.back()))) line.pop_back();
+            if (!line.empty() && line.front() != '#') {
+                inputs.push_back(line);
+            }
+        }
+    }
+
+    fs::create_directories(output_dir, ec);
+    if (!fs::is_directory(output_dir, ec)) return false;
+
+    // Inputs from different directories may share a file name
+    std::set<std::string> used_names;
+    jobs.reserve(inputs.size());
+    for (auto& input : inputs) {
+        const std::string base = fs::path(input).filename().string();
+        std::string name = base + ".txt";
+        for (int suffix = 1; !used_names.insert(name).second; ++suffix) {
+            name = base + "-" + std::to_string(suffix) + ".txt";
+        }
+
+        batch_job job;
+        job.output_path = (fs::path(output_dir) / name).string();
+        const auto size = fs::file_size(input, ec);
+        job.input_bytes = ec ? 0 : static_cast<size_t>(size);
+        job.input_path = std::move(input);
+        jobs.push_back(std::move(job));
+    }
+    return true;
+}
+
+std::vector<size_t> batch_runner::schedule(const std::vector<batch_job>& jobs) {
+    std::vector<size_t> order(jobs.size());
+    std::iota(order.begin(), order.end(), size_t{0});
+    std::stable_sort(order.begin(), order.end(), [&jobs](size_t a, size_t b) {
+        return jobs[a].input_bytes > jobs[b].input_bytes;
+    });
+    return order;
+}
+
+batch_job_result batch_runner::run_job(const batch_job& job, const pack_planner_config& config) {
+    batch_job_result result;
+    timer job_timer;
+    job_timer.start();
+
+    pack_planner planner;
+    pack_planner_result plan;
+
+    if (binary_item_file::is_binary_item_file(job.input_path)) {
+        binary_item_file input;
+        if (!input.open(job.input_path)) {
+            result.error = "invalid binary item file";
+            result.run_time = job_timer.stop();
+            return result;
+        }
+        result.items = input.size();
+        plan = planner.plan_packs(config, input.columns());
+    } else {
+        std::vector<item> items;
+#ifdef PACK_PLANNER_HAVE_ZLIB
+        if (is_gzip_file(job.input_path)) {
+            gzip_reader reader;
+            if (!reader.open(job.input_path)) {
+                result.error = "cannot read input";
+                result.run_time = job_timer.stop();
+                return result;
+            }
+            csv_block_parser parser;
+            std::string block;
+            while (reader.next_block(block)) {
+                parser.feed(block.data(), block.size(), items);
+            }
+            parser.finish(items);
+            if (!reader.ok()) {
+                result.error = "corrupt gzip input";
+                result.run_time = job_timer.stop();
+                return result;
+            }
+        } else
+#endif
+        {
+            // Jobs already run side by side; a second level of threads would only contend
+            csv_ingest ingest(1);
+            // load() also fails for a readable file without items; that is "no items" below
+            if (!ingest.load(job.input_path, items) && !std::ifstream(job.input_path).is_open()) {
+                result.error = "cannot read input";
+                result.run_time = job_timer.stop();
+                return result;
+            }
+        }
+
+        if (items.empty()) {
+            result.error = "no items";
+            result.run_time = job_timer.stop();
+            return result;
+        }
+        result.items = items.size();
+        plan = planner.plan_packs(config, std::move(items));
+    }
+
+    for (const auto& p : plan.packs) {
+        if (!p.is_empty()) ++result.packs;
+    }
+    // The plan is still written; the job reports what it left out
+    result.unplaced_items = plan.unplaced_items;
+    result.error = plan.error;
+
+    bool written = false;
+#ifdef PACK_PLANNER_HAVE_ZLIB
+    if (has_gzip_extension(job.output_path)) {
+        gzip_ofstream file(job.output_path);
+        planner.output_results(plan.packs, file);
+        file.close();
+        written = static_cast<bool>(file);
+    } else
+#endif
+    {
+        std::ofstream file(job.output_path, std::ios::binary | std::ios::trunc);
+        if (file.is_open()) {
+            planner.output_results(plan.packs, file);
+            file.close();
+            written = static_cast<bool>(file);
+        }
+    }
+
+    result.ok = written;
+    if (!written) result.error = "cannot write output";
+    result.run_time = job_timer.stop();
+    return result;
+}
+
+std::vector<batch_job_result> batch_runner::run(const std::vector<batch_job>& jobs,
+                                                const pack_planner_config& config) {
+    timer batch_timer;
+    batch_timer.start();
+
+    std::vector<batch_job_result> results(jobs.size());
+    const std::vector<size_t> order = schedule(jobs);
+    std::atomic<size_t> next{0};
+
+    auto worker = [&](unsigned int worker_index) {
+        for (size_t slot = next.fetch_add(1, std::memory_order_relaxed); slot < order.size();
+             slot = next.fetch_add(1, std::memory_order_relaxed)) {
+            const size_t index = order[slot];
+            const double start_time = batch_timer.elapsed();
+            // SAFETY: Every job index is claimed by exactly one worker, so each
+            // result slot has a single writer
+            results[index] = run_job(jobs[index], config);
+            results[index].start_time = start_time;
+            results[index].worker = worker_index;
+        }
+    };
+
+    m_workers_used = static_cast<unsigned int>(
+        std::max<size_t>(1, std::min<size_t>(m_worker_count, jobs.size())));
+    std::vector<std::thread> threads;
+    threads.reserve(m_workers_used - 1);
+    for (unsigned int w = 1; w < m_workers_used; ++w) {
+        threads.emplace_back(worker, w);
+    }
+    worker(0);
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    m_total_time = batch_timer.stop();
+    return results;
+}
+
+batch_summary batch_runner::summarize(const std::vector<batch_job>& jobs,
+                                      const std::vector<batch_job_result>& results) const {
+    batch_summary summary;
+    summary.jobs = results.size();
+    summary.wall_time = m_total_time;
+
+    std::vector<double> run_times;
+    run_times.reserve(results.size());
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+        if (!r.ok) ++summary.failed;
+        summary.items += r.items;
+        summary.packs += r.packs;
+        summary.unplaced_items += r.unplaced_items;
+        if (i < jobs.size()) summary.input_bytes += jobs[i].input_bytes;
+        summary.latency_max = std::max(summary.latency_max, r.latency());
+        run_times.push_back(r.run_time);
+    }
+
+    if (!run_times.empty()) {
+        std::sort(run_times.begin(), run_times.end());
+        auto percentile = [&run_times](double p) {
+            const size_t rank = static_cast<size_t>(p * (run_times.size() - 1) + 0.5);
+            return run_times[std::min(rank, run_times.size() - 1)];
+        };
+        summary.run_time_p50 = percentile(0.50);
+        summary.run_time_p95 = percentile(0.95);
+        summary.run_time_max = run_times.back();
+    }
+    return summary;
+}
+
+void batch_runner::print_summary(const std::vector<batch_job>& jobs,
+                                 const std::vector<batch_job_result>& results,
+                                 std::ostream& output) const {
+    const batch_summary summary = summarize(jobs, results);
+
+    output << std::fixed << std::setprecision(3)
+           << "Batch: " << summary.jobs << " jobs (" << summary.failed << " failed) on "
+           << m_workers_used << " workers, " << summary.items << " items, "
+           << summary.packs << " packs, " << summary.unplaced_items << " unplaced pieces" << std::endl
+           << "  job time p50 " << summary.run_time_p50 << " ms, p95 " << summary.run_time_p95
+           << " ms, max " << summary.run_time_max << " ms" << std::endl
+           << "  wall " << summary.wall_time << " ms, last job done at " << summary.latency_max
+           << " ms" << std::endl
+           << std::setprecision(1) << "  throughput " << summary.jobs_per_second() << " jobs/s, "
+           << summary.megabytes_per_second() << " MB/s input" << std::endl;
+
+    for (size_t i = 0; i < results.size() && i < jobs.size(); ++i) {
+        if (!results[i].ok) {
+            output << "  FAILED " << jobs[i].input_path << ": " << results[i].error << std::endl;
+        } else if (results[i].unplaced_items > 0) {
+            output << "  UNPLACED " << jobs[i].input_path << ": " << results[i].error << std::endl;
+        }
+    }
+}
+
+void batch_runner::write_report(const std::vector<batch_job>& jobs,
+                                const std::vector<batch_job_result>& results,
+                                std::ostream& output) {
+    output << "input,output,bytes,items,packs,unplaced,worker,start_ms,run_ms,latency_ms,status\n";
+    output << std::fixed << std::setprecision(3);
+    for (size_t i = 0; i < results.size() && i < jobs.size(); ++i) {
+        const auto& r = results[i];
+        output << jobs[i].input_path << ',' << jobs[i].output_path << ',' << jobs[i].input_bytes
+               << ',' << r.items << ',' << r.packs << ',' << r.unplaced_items << ',' << r.worker << ',' << r.start_time
+               << ',' << r.run_time << ',' << r.latency() << ','
+               << (r.ok ? std::string("ok") : r.error) << '\n';
+    }
+}
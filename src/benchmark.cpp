@@ -1,8 +1,22 @@
 #include "benchmark.h"
+#include "blocking_pack_strategy.h"
+#include "cpu_features.h"
+#include "csv_ingest.h"
+#include "csv_scanner.h"
+#ifndef __EMSCRIPTEN__
+#include "async_file_io.h"
+#include "binary_item_file.h"
+#include <filesystem>
+#include <fstream>
+#endif
+#include <cstdio>
+#include <cstring>
 #include <iostream>
 #include <iomanip>
 #include <random>
 #include <map>
+#include <memory_resource>
+#include <sstream>
 
 const std::vector<int> benchmark::BENCHMARK_SIZES = {100000, 1000000, 5000000, 10000000, 20000000};
 const std::vector<sort_order> benchmark::SORT_ORDERS = {sort_order::NATURAL,
@@ -12,7 +26,10 @@ const std::vector<sort_order> benchmark::SORT_ORDERS = {sort_order::NATURAL,
 const std::vector<strategy_type> benchmark::PACKING_STRATEGIES = {  strategy_type::BLOCKING_FIRST_FIT,
                                                                     strategy_type::PARALLEL_FIRST_FIT,
                                                                     strategy_type::LOCKFREE_FIRST_FIT,
-                                                                    strategy_type::BLOCKING_NEXT_FIT
+                                                                    strategy_type::BLOCKING_NEXT_FIT,
+                                                                    strategy_type::FIRST_FIT,
+                                                                    strategy_type::BEST_FIT,
+                                                                    strategy_type::BOUNDED_BEST_FIT
 #ifdef HAS_OPENMP
                                                                     ,strategy_type::OPENMP_NEXT_FIT
                                                                     ,strategy_type::OPENMP_FIRST_FIT
@@ -40,10 +57,9 @@ void benchmark::run_benchmark_internal(const std::vector<unsigned int>& thread_c
     m_total_timer.start();
 
     for (strategy_type strategy : PACKING_STRATEGIES) {
-        // For blocking strategy, only use thread count 1
+        // For sequential strategies, only use thread count 1
         std::vector<unsigned int> strategy_thread_counts;
-        if (strategy == strategy_type::BLOCKING_FIRST_FIT  ||
-            strategy == strategy_type::BLOCKING_NEXT_FIT) {
+        if (!pack_strategy_factory::is_parallel_strategy(strategy)) {
             strategy_thread_counts.push_back(1);
         } else {
             strategy_thread_counts = thread_counts;
@@ -225,9 +241,8 @@ void benchmark::benchmark_single_threaded_sorts() {
             original_items.emplace_back(i, length_dist(gen), quantity_dist(gen), weight_dist(gen));
         }
 
-        // Lambda to benchmark a sorting algorithm
-        auto benchmark_sort = [&](const std::string& name, auto sort_func) {
-            auto items = original_items;
+        // Lambda to benchmark a sorting algorithm on a copy of the given input
+        auto benchmark_sort_input = [&](const std::string& name, auto items, auto sort_func) {
             auto start = std::chrono::high_resolution_clock::now();
             sort_func(items);
             auto end = std::chrono::high_resolution_clock::now();
@@ -247,6 +262,10 @@ void benchmark::benchmark_single_threaded_sorts() {
             std::cout << std::endl;
         };
 
+        auto benchmark_sort = [&](const std::string& name, auto sort_func) {
+            benchmark_sort_input(name, original_items, sort_func);
+        };
+
         // Test single-threaded algorithms
         benchmark_sort("std::sort", [](std::vector<item>& items) {
             std::sort(items.begin(), items.end());
@@ -279,6 +298,25 @@ void benchmark::benchmark_single_threaded_sorts() {
         benchmark_sort("std::stable_sort", [](std::vector<item>& items) {
             std::stable_sort(items.begin(), items.end());
         });
+
+        // Same ordering on column storage; the copy into columns is not timed
+        benchmark_sort_input("ColumnRadixSort", item_columns(original_items), [](item_columns& columns) {
+            optimized_sort::ColumnRadixSort::sort_by_length(columns, true);
+        });
+
+        // Radix passes move 8-byte (length, index) keys; the rows are gathered once
+        benchmark_sort("KeyIndexRadix", [](std::vector<item>& items) {
+            optimized_sort::KeyIndexRadixSort::sort_by_length(items, true);
+        });
+        benchmark_sort_input("KeyIndexRadix cols", item_columns(original_items), [](item_columns& columns) {
+            optimized_sort::KeyIndexRadixSort::sort_by_length(columns, true);
+        });
+
+        // Permutation only: the source rows stay where they are
+        benchmark_sort_input("KeyIndexRadix order", item_columns(original_items), [](item_columns& columns) {
+            [[maybe_unused]] const auto order =
+                optimized_sort::KeyIndexRadixSort::sort_permutation(columns.view(), true);
+        });
     }
 
     // Print summary with top 3 algorithms
@@ -538,6 +576,406 @@ void benchmark::benchmark_multi_threaded_sorts() {
     }
 }
 
+void benchmark::benchmark_parsers(int line_count) {
+    std::cout << "\n=== CSV PARSER BENCHMARKS ===\n";
+    std::cout << "Single-threaded parse of " << line_count << " item lines\n\n";
+
+    // Same shape as input.txt: id,length,quantity,weight with 3 decimals
+    std::string text = "NATURAL,100,200.0\n";
+    text.reserve(static_cast<size_t>(line_count) * 24);
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<> length_dist(500, 10000);
+    std::uniform_int_distribution<> quantity_dist(1, 100);
+    std::uniform_int_distribution<> weight_dist(500, 30000);
+    char line[64];
+    for (int i = 0; i < line_count; ++i) {
+        const int grams = weight_dist(gen);
+        const int n = std::snprintf(line, sizeof(line), "%d,%d,%d,%d.%03d\n", 1000 + i,
+                                    length_dist(gen), quantity_dist(gen), grams / 1000, grams % 1000);
+        text.append(line, n);
+    }
+
+    const double megabytes = text.size() / (1024.0 * 1024.0);
+    std::cout << "Input size: " << std::fixed << std::setprecision(1) << megabytes << " MB\n\n";
+
+    auto report = [&](const std::string& name, double ms, size_t count) {
+        std::cout << "  " << std::left << std::setw(26) << name
+                  << std::right << std::setw(10) << std::fixed << std::setprecision(2) << ms << " ms"
+                  << std::setw(10) << std::setprecision(2) << (megabytes / 1024.0) / (ms / 1000.0) << " GB/s"
+                  << "  (" << count << ")" << std::endl;
+    };
+
+    // Reference: the getline/istringstream loop load_items_from_file used to run
+    {
+        timer t;
+        t.start();
+        std::vector<item> items;
+        std::istringstream in(text);
+        std::string row;
+        while (std::getline(in, row)) {
+            if (row.empty()) continue;
+            std::istringstream iss(row);
+            int id, length;
+            std::int64_t quantity;
+            double weight;
+            char comma;
+            if (iss >> id >> comma >> length >> comma >> quantity >> comma >> weight) {
+                items.emplace_back(id, length, quantity, weight);
+            }
+        }
+        report("istringstream (legacy)", t.stop(), items.size());
+    }
+
+    {
+        timer t;
+        t.start();
+        std::vector<item> items;
+        items.reserve(line_count);
+        const char* first = text.data();
+        const char* last = first + text.size();
+        while (first < last) {
+            const char* eol = static_cast<const char*>(std::memchr(first, '\n', last - first));
+            if (eol == nullptr) eol = last;
+            int id, length;
+            std::int64_t quantity;
+            double weight;
+            if (csv_ingest::parse_line(first, eol, id, length, quantity, weight)) {
+                items.emplace_back(id, length, quantity, weight);
+            }
+            first = (eol == last) ? last : eol + 1;
+        }
+        report("from_chars per line", t.stop(), items.size());
+    }
+
+    // Stage 1 alone: structural index construction
+    std::vector<uint32_t> index(csv_scanner::WINDOW_BYTES + 32);
+    auto bench_stage1 = [&](const std::string& name, auto kernel) {
+        timer t;
+        t.start();
+        size_t structurals = 0;
+        for (size_t pos = 0; pos < text.size(); pos += csv_scanner::WINDOW_BYTES) {
+            const size_t window = std::min(csv_scanner::WINDOW_BYTES, text.size() - pos);
+            structurals += kernel(text.data() + pos, window, index.data());
+        }
+        report(name, t.stop(), structurals);
+    };
+
+    bench_stage1("stage 1 scalar", csv_scanner::find_structurals_scalar);
+    if (cpu_has_avx2()) {
+        bench_stage1("stage 1 AVX2", csv_scanner::find_structurals_avx2);
+    }
+
+    {
+        timer t;
+        t.start();
+        std::vector<item> items;
+        items.reserve(line_count);
+        csv_scanner::parse_range(text.data(), text.data() + text.size(), items);
+        report(cpu_has_avx2() ? "structural scanner (AVX2)" : "structural scanner", t.stop(), items.size());
+    }
+}
+
+namespace {
+
+// Forwards to an upstream resource and counts what reaches it
+class counting_resource : public std::pmr::memory_resource {
+public:
+    explicit counting_resource(std::pmr::memory_resource* upstream) noexcept : m_upstream(upstream) {}
+
+    [[nodiscard]] size_t allocations() const noexcept { return m_allocations; }
+    [[nodiscard]] size_t bytes() const noexcept { return m_bytes; }
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        ++m_allocations;
+        m_bytes += bytes;
+        return m_upstream->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        m_upstream->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    std::pmr::memory_resource* m_upstream;
+    size_t m_allocations = 0;
+    size_t m_bytes = 0;
+};
+
+} // namespace
+
+void benchmark::benchmark_plan_allocations(int item_count, int repetitions) {
+    std::cout << "\n=== PLAN ALLOCATION BENCHMARKS ===\n";
+    std::cout << "Blocking first-fit over " << item_count << " items, NATURAL order, "
+              << repetitions << " runs (plan + free)\n\n";
+
+    // Light pieces give ~30 rows per pack, well inside the strategy pack limits
+    item_columns columns;
+    columns.reserve(static_cast<size_t>(item_count));
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<> length_dist(500, 10000);
+    std::uniform_int_distribution<> quantity_dist(1, 4);
+    std::uniform_int_distribution<> weight_dist(500, 5000);
+    for (int i = 0; i < item_count; ++i) {
+        columns.push_back(1000 + i, length_dist(gen), quantity_dist(gen), weight_dist(gen) / 1000.0);
+    }
+
+    pack_planner_config config;
+    config.max_items_per_pack = MAX_ITEMS_PER_PACK;
+    config.max_weight_per_pack = MAX_WEIGHT_PER_PACK;
+    config.thread_count = 1;
+
+    auto report = [repetitions](const std::string& name, double ms, size_t allocations,
+                                size_t bytes, size_t packs) {
+        std::cout << "  " << std::left << std::setw(30) << name
+                  << std::right << std::setw(10) << std::fixed << std::setprecision(2)
+                  << ms / repetitions << " ms" << std::setw(12) << allocations / repetitions
+                  << " allocs" << std::setw(10) << bytes / repetitions / 1024 << " KiB"
+                  << "  (" << packs << " packs)" << std::endl;
+    };
+
+    pack_planner planner;
+    (void)planner.plan_packs(config, columns);  // warm up
+
+    // Pack item lists from the global allocator, counted through the default resource
+    {
+        counting_resource counter(std::pmr::new_delete_resource());
+        std::pmr::memory_resource* previous = std::pmr::set_default_resource(&counter);
+        size_t packs = 0;
+        timer t;
+        t.start();
+        for (int r = 0; r < repetitions; ++r) {
+            const auto result = planner.plan_packs(config, columns);
+            packs = result.packs.size();
+        }
+        const double ms = t.stop();
+        std::pmr::set_default_resource(previous);
+        report("global allocator", ms, counter.allocations(), counter.bytes(), packs);
+    }
+
+    // One monotonic arena per plan; the upstream sees only its growing chunks
+    {
+        counting_resource counter(std::pmr::new_delete_resource());
+        size_t packs = 0;
+        timer t;
+        t.start();
+        for (int r = 0; r < repetitions; ++r) {
+            std::pmr::monotonic_buffer_resource arena(&counter);
+            const auto result = planner.plan_packs(config, columns, &arena);
+            packs = result.packs.size();
+        }
+        const double ms = t.stop();
+        report("monotonic arena", ms, counter.allocations(), counter.bytes(), packs);
+    }
+}
+
+void benchmark::benchmark_packing_loop(int item_count, int repetitions) {
+    std::cout << "\n=== PACKING LOOP BENCHMARKS ===\n";
+    std::cout << "Blocking first-fit loop over " << item_count << " items, NATURAL order, "
+              << repetitions << " runs per plan\n\n";
+
+    // Same rows as the allocation benchmark: ~30 rows per pack
+    item_columns columns;
+    columns.reserve(static_cast<size_t>(item_count));
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<> length_dist(500, 10000);
+    std::uniform_int_distribution<> quantity_dist(1, 4);
+    std::uniform_int_distribution<> weight_dist(500, 5000);
+    for (int i = 0; i < item_count; ++i) {
+        columns.push_back(1000 + i, length_dist(gen), quantity_dist(gen), weight_dist(gen) / 1000.0);
+    }
+    const item_column_view view = columns.view();
+
+    auto run = [&](const std::string& name, auto make_plan, auto weights) {
+        size_t packs = 0;
+        double best_ms = 0.0;
+        for (int r = 0; r <= repetitions; ++r) {  // run 0 is the warm-up
+            auto plan = make_plan();
+            timer t;
+            t.start();
+            blocking_pack_strategy::pack_sequential(view, MAX_ITEMS_PER_PACK, MAX_WEIGHT_PER_PACK,
+                                                    plan, weights);
+            const double ms = t.stop();
+            packs = plan.size();
+            if (r == 1 || (r > 1 && ms < best_ms)) best_ms = ms;
+        }
+        std::cout << "  " << std::left << std::setw(30) << name
+                  << std::right << std::setw(10) << std::fixed << std::setprecision(2)
+                  << best_ms << " ms" << std::setw(12) << std::setprecision(1)
+                  << item_count / best_ms / 1000.0 << " M rows/s"
+                  << "  (" << packs << " packs)" << std::endl;
+    };
+
+    run("vector<pack>, floating", [] { return std::vector<pack>(); }, floating_weights{});
+    run("vector<pack>, fixed-point", [] { return std::vector<pack>(); }, fixed_weights{});
+    run("plan_arena, floating", [] { return plan_arena(); }, floating_weights{});
+    run("range_plan, floating", [] {
+        range_plan plan;
+        plan.set_weight_limit(MAX_WEIGHT_PER_PACK, weight_mode::FLOATING);
+        return plan;
+    }, floating_weights{});
+}
+
+#ifndef __EMSCRIPTEN__
+void benchmark::benchmark_item_load(int item_count) {
+    std::cout << "\n=== ITEM LOAD BENCHMARKS ===\n";
+    std::cout << "Time until " << item_count << " items are available to the planner\n\n";
+
+    const auto temp_dir = std::filesystem::temp_directory_path();
+    const std::string csv_path = (temp_dir / "pack_planner_load_bench.csv").string();
+    const std::string binary_path = (temp_dir / "pack_planner_load_bench.ppi").string();
+
+    {
+        std::ofstream out(csv_path, std::ios::binary);
+        out << "NATURAL,100,200.0\n";
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<> length_dist(500, 10000);
+        std::uniform_int_distribution<> quantity_dist(1, 100);
+        std::uniform_int_distribution<> weight_dist(500, 30000);
+        char line[64];
+        for (int i = 0; i < item_count; ++i) {
+            const int grams = weight_dist(gen);
+            const int n = std::snprintf(line, sizeof(line), "%d,%d,%d,%d.%03d\n", 1000 + i,
+                                        length_dist(gen), quantity_dist(gen), grams / 1000, grams % 1000);
+            out.write(line, n);
+        }
+    }
+
+    auto report = [](const std::string& name, double ms, size_t count) {
+        std::cout << "  " << std::left << std::setw(30) << name
+                  << std::right << std::setw(12) << std::fixed << std::setprecision(2) << ms << " ms"
+                  << "  (" << count << " items)" << std::endl;
+    };
+
+    std::vector<item> items;
+    {
+        timer t;
+        t.start();
+        csv_ingest ingest;
+        ingest.load(csv_path, items);
+        report("CSV ingest (mmap, parallel)", t.stop(), items.size());
+    }
+
+    {
+        timer t;
+        t.start();
+        binary_item_file::write(binary_path, items, true);
+        report("convert to binary", t.stop(), items.size());
+    }
+
+    {
+        timer t;
+        t.start();
+        binary_item_file file;
+        const bool opened = file.open(binary_path);
+        report("binary open (mmap)", t.stop(), opened ? file.size() : 0);
+    }
+
+    {
+        timer t;
+        t.start();
+        binary_item_file file;
+        const bool opened = file.open(binary_path, true);
+        report("binary open + checksum", t.stop(), opened ? file.size() : 0);
+    }
+
+    // Touching every row is what planning from the mapping costs on top of open()
+    {
+        timer t;
+        t.start();
+        binary_item_file file;
+        long long pieces = 0;
+        if (file.open(binary_path)) {
+            const item_column_view columns = file.columns();
+            for (size_t i = 0; i < columns.size(); ++i) {
+                pieces += columns.quantities[i];
+            }
+        }
+        report("binary open + column scan", t.stop(), file.size());
+        std::cout << "  Total pieces: " << pieces << std::endl;
+    }
+
+    std::filesystem::remove(csv_path);
+    std::filesystem::remove(binary_path);
+}
+
+void benchmark::benchmark_file_io(int megabytes) {
+    std::cout << "\n=== FILE I/O BENCHMARKS ===\n";
+    std::cout << "Sequential " << megabytes << " MB, 1 MB blocks (page cache is not dropped)\n";
+    std::cout << "io_uring available: " << (io_uring_available() ? "yes" : "no, async rows use blocking I/O")
+              << "\n\n";
+
+    const std::string path =
+        (std::filesystem::temp_directory_path() / "pack_planner_io_bench.bin").string();
+    const size_t block_bytes = 1 << 20;
+    const std::string block(block_bytes, 'x');
+    const double total_mb = megabytes;
+
+    auto report = [total_mb](const std::string& name, double ms) {
+        std::cout << "  " << std::left << std::setw(30) << name
+                  << std::right << std::setw(10) << std::fixed << std::setprecision(2) << ms << " ms"
+                  << std::setw(10) << std::setprecision(0) << total_mb / (ms / 1000.0) << " MB/s"
+                  << std::endl;
+    };
+
+    {
+        timer t;
+        t.start();
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        for (int i = 0; i < megabytes; ++i) {
+            out.write(block.data(), static_cast<std::streamsize>(block.size()));
+        }
+        out.close();
+        report("write std::ofstream", t.stop());
+    }
+
+    auto bench_writer = [&](const std::string& name, io_backend backend, unsigned depth) {
+        timer t;
+        t.start();
+        async_file_writer writer;
+        if (!writer.open(path, depth, block_bytes, backend)) return;
+        for (int i = 0; i < megabytes; ++i) {
+            writer.write(block.data(), block.size());
+        }
+        writer.close();
+        report(name, t.stop());
+    };
+    bench_writer("write pwrite (blocking)", io_backend::BLOCKING, 1);
+    bench_writer("write io_uring depth 8", io_backend::IO_URING, 8);
+    bench_writer("write io_uring depth 32", io_backend::IO_URING, 32);
+
+    std::cout << std::endl;
+
+    {
+        timer t;
+        t.start();
+        std::ifstream in(path, std::ios::binary);
+        std::string buffer(block_bytes, '\0');
+        while (in.read(buffer.data(), static_cast<std::streamsize>(buffer.size())) || in.gcount() > 0) {}
+        report("read std::ifstream", t.stop());
+    }
+
+    auto bench_reader = [&](const std::string& name, io_backend backend, unsigned depth) {
+        timer t;
+        t.start();
+        async_file_reader reader;
+        if (!reader.open(path, depth, block_bytes, backend)) return;
+        std::string buffer;
+        while (reader.next_block(buffer)) {}
+        report(name, t.stop());
+    };
+    bench_reader("read pread (blocking)", io_backend::BLOCKING, 1);
+    bench_reader("read io_uring depth 1", io_backend::IO_URING, 1);
+    bench_reader("read io_uring depth 8", io_backend::IO_URING, 8);
+    bench_reader("read io_uring depth 32", io_backend::IO_URING, 32);
+
+    std::filesystem::remove(path);
+}
+#endif
+
 std::string benchmark::format_throughput(double items_per_second) {
     std::stringstream ss;
 
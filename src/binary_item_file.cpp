@@ -0,0 +1,130 @@
+#include "binary_item_file.h"
+
+#include <cstring>
+#include <fstream>
+
+namespace {
+
+constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+size_t align_up(size_t value, size_t alignment) noexcept {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+}  // namespace
+
+size_t binary_item_file::layout(uint64_t count, binary_item_header& header) noexcept {
+    const size_t n = static_cast<size_t>(count);
+    header.id_offset = align_up(sizeof(binary_item_header), COLUMN_ALIGNMENT);
+    header.length_offset = align_up(header.id_offset + n * sizeof(int), COLUMN_ALIGNMENT);
+    header.quantity_offset = align_up(header.length_offset + n * sizeof(int), COLUMN_ALIGNMENT);
+    header.weight_offset = align_up(header.quantity_offset + n * sizeof(std::int64_t), COLUMN_ALIGNMENT);
+    return header.weight_offset + n * sizeof(double);
+}
+
+uint64_t binary_item_file::checksum(const void* data, size_t size) noexcept {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    uint64_t hash = FNV_OFFSET_BASIS;
+
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, bytes + i, sizeof(word));
+        hash = (hash ^ word) * FNV_PRIME;
+    }
+    for (; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+bool binary_item_file::write(const std::string& path, const std::vector<item>& items,
+                             bool with_checksum) {
+    binary_item_header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.flags = with_checksum ? FLAG_CHECKSUM : 0;
+    header.count = items.size();
+    const size_t file_size = layout(header.count, header);
+
+    mapped_file file;
+    if (!file.create(path, file_size)) {
+        return false;
+    }
+
+    // SAFETY: Freshly created mapping is zero-filled, so alignment padding is deterministic
+    char* base = file.data();
+    auto* ids = reinterpret_cast<int*>(base + header.id_offset);
+    auto* lengths = reinterpret_cast<int*>(base + header.length_offset);
+    auto* quantities = reinterpret_cast<std::int64_t*>(base + header.quantity_offset);
+    auto* weights = reinterpret_cast<double*>(base + header.weight_offset);
+
+    for (size_t i = 0; i < items.size(); ++i) {
+        ids[i] = items[i].get_id();
+        lengths[i] = items[i].get_length();
+        quantities[i] = items[i].get_quantity();
+        weights[i] = items[i].get_weight();
+    }
+
+    if (with_checksum) {
+        header.checksum = checksum(base + header.id_offset, file_size - header.id_offset);
+    }
+    std::memcpy(base, &header, sizeof(header));
+
+    file.close();
+    return true;
+}
+
+bool binary_item_file::open(const std::string& path, bool verify_checksum) {
+    close();
+
+    if (!m_file.open_read(path) || m_file.size() < sizeof(binary_item_header)) {
+        close();
+        return false;
+    }
+
+    binary_item_header header;
+    std::memcpy(&header, m_file.data(), sizeof(header));
+
+    // SAFETY: Reject foreign files and layouts that would read past the mapping
+    binary_item_header expected{};
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        header.version != VERSION ||
+        header.count > m_file.size() / (2 * sizeof(int) + sizeof(std::int64_t) + sizeof(double)) ||
+        layout(header.count, expected) != m_file.size() ||
+        header.id_offset != expected.id_offset ||
+        header.length_offset != expected.length_offset ||
+        header.quantity_offset != expected.quantity_offset ||
+        header.weight_offset != expected.weight_offset) {
+        close();
+        return false;
+    }
+
+    m_has_checksum = (header.flags & FLAG_CHECKSUM) != 0;
+    const char* base = m_file.data();
+    if (verify_checksum && m_has_checksum &&
+        checksum(base + header.id_offset, m_file.size() - header.id_offset) != header.checksum) {
+        close();
+        return false;
+    }
+
+    m_columns.ids = reinterpret_cast<const int*>(base + header.id_offset);
+    m_columns.lengths = reinterpret_cast<const int*>(base + header.length_offset);
+    m_columns.quantities = reinterpret_cast<const std::int64_t*>(base + header.quantity_offset);
+    m_columns.weights = reinterpret_cast<const double*>(base + header.weight_offset);
+    m_columns.count = static_cast<size_t>(header.count);
+    return true;
+}
+
+void binary_item_file::close() noexcept {
+    m_file.close();
+    m_columns = item_column_view{};
+    m_has_checksum = false;
+}
+
+bool binary_item_file::is_binary_item_file(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    char magic[sizeof(MAGIC)] = {};
+    return in.read(magic, sizeof(magic)) && std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
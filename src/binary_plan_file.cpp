@@ -0,0 +1,130 @@
+#include "binary_plan_file.h"
+
+#include <cstring>
+
+namespace {
+
+size_t align_up(size_t value, size_t alignment) noexcept {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+}  // namespace
+
+size_t binary_plan_file::layout(uint64_t pack_count, uint64_t placement_count,
+                                binary_plan_header& header) noexcept {
+    header.pack_offset = align_up(sizeof(binary_plan_header), TABLE_ALIGNMENT);
+    header.placement_offset = align_up(header.pack_offset + pack_count * sizeof(plan_pack_record),
+                                       TABLE_ALIGNMENT);
+    return header.placement_offset + placement_count * sizeof(plan_placement_record);
+}
+
+namespace {
+
+// Packs is std::vector<pack> or plan_arena
+template <typename Packs>
+bool write_plan(const std::string& path, const Packs& packs) {
+    binary_plan_header header{};
+    std::memcpy(header.magic, binary_plan_file::MAGIC, sizeof(binary_plan_file::MAGIC));
+    header.version = binary_plan_file::VERSION;
+
+    for (const auto& p : packs) {
+        if (!p.is_empty()) {
+            ++header.pack_count;
+            header.placement_count += p.get_items().size();
+        }
+    }
+    const size_t file_size = binary_plan_file::layout(header.pack_count, header.placement_count, header);
+
+    mapped_file file;
+    if (!file.create(path, file_size)) {
+        return false;
+    }
+
+    char* base = file.data();
+    auto* pack_table = reinterpret_cast<plan_pack_record*>(base + header.pack_offset);
+    auto* placement_table = reinterpret_cast<plan_placement_record*>(base + header.placement_offset);
+
+    uint64_t placement = 0;
+    for (const auto& p : packs) {
+        if (p.is_empty()) continue;
+
+        plan_pack_record& record = *pack_table++;
+        record.pack_number = p.get_pack_number();
+        record.total_items = p.get_total_items();
+        record.total_weight = p.get_total_weight();
+        record.max_length = p.get_pack_length();
+        record.first_placement = placement;
+        record.placement_count = p.get_items().size();
+
+        for (const auto& i : p.get_items()) {
+            placement_table[placement++] = {i.get_id(), i.get_quantity()};
+        }
+        header.total_items += static_cast<uint64_t>(p.get_total_items());
+    }
+
+    std::memcpy(base, &header, sizeof(header));
+    file.close();
+    return true;
+}
+
+}  // namespace
+
+bool binary_plan_file::write(const std::string& path, const std::vector<pack>& packs) {
+    return write_plan(path, packs);
+}
+
+bool binary_plan_file::write(const std::string& path, const plan_arena& packs) {
+    return write_plan(path, packs);
+}
+
+bool binary_plan_file::open(const std::string& path) {
+    close();
+
+    if (!m_file.open_read(path) || m_file.size() < sizeof(binary_plan_header)) {
+        close();
+        return false;
+    }
+
+    binary_plan_header header;
+    std::memcpy(&header, m_file.data(), sizeof(header));
+
+    // SAFETY: Reject foreign files and layouts that would read past the mapping
+    binary_plan_header expected{};
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION ||
+        header.pack_count > m_file.size() / sizeof(plan_pack_record) ||
+        header.placement_count > m_file.size() / sizeof(plan_placement_record) ||
+        layout(header.pack_count, header.placement_count, expected) != m_file.size() ||
+        header.pack_offset != expected.pack_offset ||
+        header.placement_offset != expected.placement_offset) {
+        close();
+        return false;
+    }
+
+    const char* base = m_file.data();
+    m_packs = reinterpret_cast<const plan_pack_record*>(base + header.pack_offset);
+    m_placements = reinterpret_cast<const plan_placement_record*>(base + header.placement_offset);
+    m_pack_count = static_cast<size_t>(header.pack_count);
+    m_placement_count = static_cast<size_t>(header.placement_count);
+
+    // SAFETY: Every pack's placement range must lie inside the placement table
+    for (size_t i = 0; i < m_pack_count; ++i) {
+        const plan_pack_record& record = m_packs[i];
+        if (record.first_placement > m_placement_count ||
+            record.placement_count > m_placement_count - record.first_placement) {
+            close();
+            return false;
+        }
+    }
+
+    m_total_items = header.total_items;
+    return true;
+}
+
+void binary_plan_file::close() noexcept {
+    m_file.close();
+    m_packs = nullptr;
+    m_placements = nullptr;
+    m_pack_count = 0;
+    m_placement_count = 0;
+    m_total_items = 0;
+}
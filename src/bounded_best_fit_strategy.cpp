@@ -0,0 +1,84 @@
+#include "bounded_best_fit_strategy.h"
+#include "cpu_features.h"
+
+#include <algorithm>
+#include <bit>
+
+#ifdef PACK_PLANNER_X86_DISPATCH
+#include <immintrin.h>
+#endif
+
+int bounded_best_fit_pack_strategy::find_best(const double* room, size_t lanes, double needed) noexcept {
+    return cpu_has_avx2() ? find_best_avx2(room, lanes, needed) : find_best_scalar(room, lanes, needed);
+}
+
+int bounded_best_fit_pack_strategy::find_best(const std::int64_t* room, size_t lanes,
+                                              std::int64_t needed) noexcept {
+    return cpu_has_avx2() ? find_best_avx2(room, lanes, needed) : find_best_scalar(room, lanes, needed);
+}
+
+#ifdef PACK_PLANNER_X86_DISPATCH
+__attribute__((target("avx2")))
+int bounded_best_fit_pack_strategy::find_best_avx2(const double* room, size_t lanes, double needed) noexcept {
+    const __m256d need = _mm256_set1_pd(needed);
+    const __m256d none = _mm256_set1_pd(std::numeric_limits<double>::infinity());
+    __m256d best = none;
+    __m256d any = _mm256_setzero_pd();
+    for (size_t lane = 0; lane < lanes; lane += 4) {
+        const __m256d r = _mm256_load_pd(room + lane);
+        const __m256d fits = _mm256_cmp_pd(r, need, _CMP_GE_OQ);
+        best = _mm256_min_pd(best, _mm256_blendv_pd(none, r, fits));
+        any = _mm256_or_pd(any, fits);
+    }
+    if (_mm256_movemask_pd(any) == 0) return -1;
+
+    __m128d low = _mm_min_pd(_mm256_castpd256_pd128(best), _mm256_extractf128_pd(best, 1));
+    low = _mm_min_sd(low, _mm_unpackhi_pd(low, low));
+    const __m256d least = _mm256_set1_pd(_mm_cvtsd_f64(low));
+    for (size_t lane = 0; lane < lanes; lane += 4) {
+        const __m256d r = _mm256_load_pd(room + lane);
+        const __m256d hit = _mm256_and_pd(_mm256_cmp_pd(r, least, _CMP_EQ_OQ),
+                                          _mm256_cmp_pd(r, need, _CMP_GE_OQ));
+        const int mask = _mm256_movemask_pd(hit);
+        if (mask != 0) return static_cast<int>(lane) + std::countr_zero(static_cast<unsigned>(mask));
+    }
+    return -1;
+}
+
+__attribute__((target("avx2")))
+int bounded_best_fit_pack_strategy::find_best_avx2(const std::int64_t* room, size_t lanes,
+                                                   std::int64_t needed) noexcept {
+    const __m256i need = _mm256_set1_epi64x(needed);
+    const __m256i none = _mm256_set1_epi64x(std::numeric_limits<std::int64_t>::max());
+    __m256i best = none;
+    __m256i any = _mm256_setzero_si256();
+    for (size_t lane = 0; lane < lanes; lane += 4) {
+        const __m256i r = _mm256_load_si256(reinterpret_cast<const __m256i*>(room + lane));
+        const __m256i fits = _mm256_andnot_si256(_mm256_cmpgt_epi64(need, r), _mm256_set1_epi64x(-1));
+        const __m256i masked = _mm256_blendv_epi8(none, r, fits);
+        best = _mm256_blendv_epi8(best, masked, _mm256_cmpgt_epi64(best, masked));
+        any = _mm256_or_si256(any, fits);
+    }
+    if (_mm256_testz_si256(any, any)) return -1;
+
+    alignas(32) std::int64_t lows[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lows), best);
+    const __m256i least = _mm256_set1_epi64x(std::min({lows[0], lows[1], lows[2], lows[3]}));
+    for (size_t lane = 0; lane < lanes; lane += 4) {
+        const __m256i r = _mm256_load_si256(reinterpret_cast<const __m256i*>(room + lane));
+        const __m256i hit = _mm256_andnot_si256(_mm256_cmpgt_epi64(need, r), _mm256_cmpeq_epi64(r, least));
+        const int mask = _mm256_movemask_pd(_mm256_castsi256_pd(hit));
+        if (mask != 0) return static_cast<int>(lane) + std::countr_zero(static_cast<unsigned>(mask));
+    }
+    return -1;
+}
+#else
+int bounded_best_fit_pack_strategy::find_best_avx2(const double* room, size_t lanes, double needed) noexcept {
+    return find_best_scalar(room, lanes, needed);
+}
+
+int bounded_best_fit_pack_strategy::find_best_avx2(const std::int64_t* room, size_t lanes,
+                                                   std::int64_t needed) noexcept {
+    return find_best_scalar(room, lanes, needed);
+}
+#endif
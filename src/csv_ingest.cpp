@@ -0,0 +1,165 @@
+#include "csv_ingest.h"
+#include "csv_scanner.h"
+#include "mapped_file.h"
+#include "timer.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <thread>
+
+csv_ingest::csv_ingest(unsigned int thread_count) noexcept
+    : m_thread_count(thread_count) {
+    if (m_thread_count == 0) {
+        m_thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+}
+
+bool csv_ingest::load(const std::string& filename, std::vector<item>& items) {
+    timer load_timer;
+    load_timer.start();
+
+    items.clear();
+    m_chunk_stats.clear();
+
+    mapped_file file;
+    if (file.open_read(filename)) {
+        file.advise_sequential();
+        parse(file.data(), file.size(), items);
+    } else {
+        // Not mappable (pipe, character device): read it into memory instead
+        std::ifstream in(filename, std::ios::binary);
+        if (!in.is_open()) {
+            m_total_time = load_timer.stop();
+            return false;
+        }
+        std::string buffer((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        parse(buffer.data(), buffer.size(), items);
+    }
+
+    m_total_time = load_timer.stop();
+    return !items.empty();
+}
+
+void csv_ingest::parse(const char* data, size_t size, std::vector<item>& items) {
+    timer parse_timer;
+    parse_timer.start();
+
+    items.clear();
+    m_chunk_stats.clear();
+
+    if (data == nullptr || size == 0) {
+        m_total_time = parse_timer.stop();
+        return;
+    }
+
+    const size_t chunk_count = std::clamp<size_t>(size / MIN_CHUNK_BYTES, 1, m_thread_count);
+    const std::vector<size_t> bounds = split_chunks(data, size, chunk_count);
+    const size_t actual_chunks = bounds.size() - 1;
+
+    std::vector<std::vector<item>> chunk_items(actual_chunks);
+    m_chunk_stats.resize(actual_chunks);
+
+    auto parse_chunk = [&](size_t c) {
+        timer chunk_timer;
+        chunk_timer.start();
+
+        const size_t bytes = bounds[c + 1] - bounds[c];
+        // Typical item lines are 15-25 bytes; over-reserving is cheaper than regrowing
+        chunk_items[c].reserve(bytes / 16 + 16);
+        const size_t lines = csv_scanner::parse_range(data + bounds[c], data + bounds[c + 1],
+                                                      chunk_items[c]);
+
+        ingest_chunk_stats& stats = m_chunk_stats[c];
+        stats.chunk_index = c;
+        stats.bytes = bytes;
+        stats.lines = lines;
+        stats.items = chunk_items[c].size();
+        stats.parse_time = chunk_timer.stop();
+    };
+
+    if (actual_chunks == 1) {
+        parse_chunk(0);
+        items = std::move(chunk_items[0]);
+        m_total_time = parse_timer.stop();
+        return;
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(actual_chunks);
+    for (size_t c = 0; c < actual_chunks; ++c) {
+        threads.emplace_back(parse_chunk, c);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Concatenate chunks in input order; copies run in parallel at their offsets
+    std::vector<size_t> offsets(actual_chunks + 1, 0);
+    for (size_t c = 0; c < actual_chunks; ++c) {
+        offsets[c + 1] = offsets[c] + chunk_items[c].size();
+    }
+
+    items.resize(offsets.back(), item(0, 0, 0, 0.0));
+
+    threads.clear();
+    for (size_t c = 0; c < actual_chunks; ++c) {
+        threads.emplace_back([&, c] {
+            std::copy(chunk_items[c].begin(), chunk_items[c].end(), items.begin() + offsets[c]);
+            std::vector<item>().swap(chunk_items[c]);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    m_total_time = parse_timer.stop();
+}
+
+std::vector<size_t> csv_ingest::split_chunks(const char* data, size_t size, size_t chunk_count) {
+    std::vector<size_t> bounds;
+    bounds.reserve(chunk_count + 1);
+    bounds.push_back(0);
+
+    chunk_count = std::max<size_t>(1, chunk_count);
+    const size_t target = size / chunk_count;
+
+    for (size_t c = 1; c < chunk_count; ++c) {
+        size_t pos = std::max(bounds.back(), c * target);
+        if (pos >= size) break;
+
+        // Advance to just past the next newline so no line straddles two chunks
+        const void* nl = std::memchr(data + pos, '\n', size - pos);
+        if (nl == nullptr) break;
+        pos = static_cast<size_t>(static_cast<const char*>(nl) - data) + 1;
+        if (pos >= size) break;
+        if (pos > bounds.back()) {
+            bounds.push_back(pos);
+        }
+    }
+
+    bounds.push_back(size);
+    return bounds;
+}
+
+size_t csv_ingest::parse_range(const char* first, const char* last, std::vector<item>& items) {
+    size_t lines = 0;
+
+    while (first < last) {
+        const char* eol = static_cast<const char*>(std::memchr(first, '\n', last - first));
+        if (eol == nullptr) eol = last;
+
+        ++lines;
+
+        int id, length;
+        std::int64_t quantity;
+        double weight;
+        if (parse_line(first, eol, id, length, quantity, weight)) {
+            items.emplace_back(id, length, quantity, weight);
+        }
+
+        first = (eol == last) ? last : eol + 1;
+    }
+
+    return lines;
+}
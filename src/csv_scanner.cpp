@@ -0,0 +1,49 @@
+#include "csv_scanner.h"
+#include "cpu_features.h"
+
+#ifdef PACK_PLANNER_X86_DISPATCH
+#include <immintrin.h>
+#endif
+
+size_t csv_scanner::find_structurals(const char* data, size_t size, uint32_t* out) noexcept {
+    return cpu_has_avx2() ? find_structurals_avx2(data, size, out)
+                          : find_structurals_scalar(data, size, out);
+}
+
+#ifdef PACK_PLANNER_X86_DISPATCH
+__attribute__((target("avx2")))
+size_t csv_scanner::find_structurals_avx2(const char* data, size_t size, uint32_t* out) noexcept {
+    const __m256i comma = _mm256_set1_epi8(',');
+    const __m256i newline = _mm256_set1_epi8('\n');
+
+    size_t n = 0;
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        const __m256i hits = _mm256_or_si256(_mm256_cmpeq_epi8(block, comma),
+                                             _mm256_cmpeq_epi8(block, newline));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(hits));
+
+        const int count = std::popcount(mask);
+        uint32_t* dst = out + n;
+        const uint32_t base = static_cast<uint32_t>(i);
+        for (int k = 0; k < count; k += 4) {
+            dst[k] = base + std::countr_zero(mask);
+            mask &= mask - 1;
+            dst[k + 1] = base + std::countr_zero(mask);
+            mask &= mask - 1;
+            dst[k + 2] = base + std::countr_zero(mask);
+            mask &= mask - 1;
+            dst[k + 3] = base + std::countr_zero(mask);
+            mask &= mask - 1;
+        }
+        n += count;
+    }
+
+    return n + find_structurals_scalar_tail(data, i, size, out + n);
+}
+#else
+size_t csv_scanner::find_structurals_avx2(const char* data, size_t size, uint32_t* out) noexcept {
+    return find_structurals_scalar(data, size, out);
+}
+#endif
@@ -0,0 +1,161 @@
+#include "gzip_stream.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <zlib.h>
+
+bool is_gzip_file(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    unsigned char magic[2] = {};
+    return in.read(reinterpret_cast<char*>(magic), sizeof(magic)) &&
+           magic[0] == 0x1f && magic[1] == 0x8b;
+}
+
+bool has_gzip_extension(const std::string& path) noexcept {
+    return path.size() > 3 && path.compare(path.size() - 3, 3, ".gz") == 0;
+}
+
+gzip_reader::~gzip_reader() {
+    close();
+}
+
+bool gzip_reader::open(const std::string& path) {
+    close();
+
+    m_file = gzopen(path.c_str(), "rb");
+    if (m_file == nullptr) {
+        return false;
+    }
+    gzbuffer(m_file, 256 * 1024);
+
+    m_blocks = std::make_unique<spsc_ring<std::string>>(RING_CAPACITY);
+    m_stop.store(false, std::memory_order_relaxed);
+    m_failed.store(false, std::memory_order_relaxed);
+    m_thread = std::thread(&gzip_reader::run, this);
+    return true;
+}
+
+void gzip_reader::run() {
+    for (;;) {
+        std::string block(BLOCK_BYTES, '\0');
+        const int n = gzread(m_file, block.data(), static_cast<unsigned>(block.size()));
+        if (n <= 0) {
+            // A truncated stream also returns 0, with Z_BUF_ERROR set
+            int err = Z_OK;
+            if (n == 0) gzerror(m_file, &err);
+            if (n < 0 || err != Z_OK) {
+                m_failed.store(true, std::memory_order_release);
+            }
+            break;
+        }
+        block.resize(static_cast<size_t>(n));
+
+        // SAFETY: Give up instead of blocking forever if the consumer went away
+        for (unsigned spins = 0; !m_blocks->try_push(block); ++spins) {
+            if (m_stop.load(std::memory_order_acquire)) {
+                m_blocks->close();
+                return;
+            }
+            if (spins >= 64) std::this_thread::yield();
+        }
+    }
+    m_blocks->close();
+}
+
+bool gzip_reader::next_block(std::string& block) {
+    return m_thread.joinable() && m_blocks->pop(block);
+}
+
+void gzip_reader::close() {
+    if (m_thread.joinable()) {
+        m_stop.store(true, std::memory_order_release);
+        m_thread.join();
+        m_blocks.reset();
+    }
+    if (m_file != nullptr) {
+        gzclose(m_file);
+        m_file = nullptr;
+    }
+}
+
+gzip_ostreambuf::~gzip_ostreambuf() {
+    close();
+}
+
+bool gzip_ostreambuf::open(const std::string& path, int level) {
+    close();
+
+    const std::string mode = "wb" + std::to_string(std::clamp(level, 1, 9));
+    m_file = gzopen(path.c_str(), mode.c_str());
+    if (m_file == nullptr) {
+        return false;
+    }
+    gzbuffer(m_file, BUFFER_BYTES);
+
+    m_buffer.resize(BUFFER_BYTES);
+    setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+    return true;
+}
+
+bool gzip_ostreambuf::close() {
+    if (m_file == nullptr) {
+        return true;
+    }
+    const bool flushed = flush_buffer();
+    const bool closed = gzclose(m_file) == Z_OK;
+    m_file = nullptr;
+    setp(nullptr, nullptr);
+    return flushed && closed;
+}
+
+bool gzip_ostreambuf::flush_buffer() {
+    const std::ptrdiff_t pending = pptr() - pbase();
+    if (pending > 0 &&
+        gzwrite(m_file, pbase(), static_cast<unsigned>(pending)) != static_cast<int>(pending)) {
+        return false;
+    }
+    setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+    return true;
+}
+
+gzip_ostreambuf::int_type gzip_ostreambuf::overflow(int_type ch) {
+    if (m_file == nullptr || !flush_buffer()) {
+        return traits_type::eof();
+    }
+    if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(ch);
+        pbump(1);
+    }
+    return traits_type::not_eof(ch);
+}
+
+std::streamsize gzip_ostreambuf::xsputn(const char* data, std::streamsize count) {
+    if (m_file == nullptr) {
+        return 0;
+    }
+
+    // Small writes are buffered; large ones (formatter blocks) go straight to zlib
+    if (count <= epptr() - pptr()) {
+        std::memcpy(pptr(), data, static_cast<size_t>(count));
+        pbump(static_cast<int>(count));
+        return count;
+    }
+    if (!flush_buffer()) {
+        return 0;
+    }
+
+    std::streamsize written = 0;
+    while (written < count) {
+        const unsigned chunk = static_cast<unsigned>(std::min<std::streamsize>(count - written, 1 << 30));
+        if (gzwrite(m_file, data + written, chunk) != static_cast<int>(chunk)) {
+            break;
+        }
+        written += chunk;
+    }
+    return written;
+}
+
+int gzip_ostreambuf::sync() {
+    return m_file != nullptr && flush_buffer() ? 0 : -1;
+}
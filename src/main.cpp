@@ -2,10 +2,25 @@
 #include <fstream>
 #include <vector>
 #include <string>
-#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <type_traits>
 #include <CLI/CLI.hpp>
 
 #include "item.h"
+#include "csv_ingest.h"
+#include "csv_scanner.h"
+#include "async_file_io.h"
+#include "batch_runner.h"
+#include "ndjson_service.h"
+#include "binary_item_file.h"
+#include "binary_plan_file.h"
+#include "parallel_output.h"
+#include "pipeline_planner.h"
+#ifdef PACK_PLANNER_HAVE_ZLIB
+#include "gzip_stream.h"
+#endif
+#include "streaming_packer.h"
 #include "pack_planner.h"
 #include "benchmark.h"
 
@@ -13,33 +28,336 @@ strategy_type parse_strategy_type(const std::string& str) {
     if (str == "BLOCKING_FIRST_FIT") return strategy_type::BLOCKING_FIRST_FIT;
     if (str == "PARALLEL_FIRST_FIT") return strategy_type::PARALLEL_FIRST_FIT;
     if (str == "LOCKFREE_FIRST_FIT") return strategy_type::LOCKFREE_FIRST_FIT;
+    if (str == "FIRST_FIT") return strategy_type::FIRST_FIT;
+    if (str == "BEST_FIT") return strategy_type::BEST_FIT;
+    if (str == "BOUNDED_BEST_FIT") return strategy_type::BOUNDED_BEST_FIT;
     return strategy_type::BLOCKING_FIRST_FIT;
 }
 
-bool load_items_from_file(const std::string& filename, std::vector<item>& items) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
+/**
+ * @brief File I/O settings from the command line
+ */
+struct io_options {
+    bool use_io_uring = false;
+    unsigned int queue_depth = async_file_reader::DEFAULT_QUEUE_DEPTH;
+};
+
+bool load_items_async(const std::string& filename, std::vector<item>& items,
+                      const io_options& io, bool print_stats) {
+    timer load_timer;
+    load_timer.start();
+
+    // Reads stay queued ahead of the parser while it works on the current block
+    async_file_reader reader;
+    if (!reader.open(filename, io.queue_depth)) {
+        return false;
+    }
+
+    csv_block_parser parser;
+    std::string block;
+    size_t bytes = 0;
+    while (reader.next_block(block)) {
+        bytes += block.size();
+        parser.feed(block.data(), block.size(), items);
+    }
+    parser.finish(items);
+
+    if (!reader.ok()) {
+        std::cerr << "Read error: " << filename << std::endl;
+        return false;
+    }
+
+    if (print_stats) {
+        std::cerr << "Async ingest (" << (reader.get_backend() == io_backend::IO_URING ? "io_uring" : "blocking")
+                  << ", depth " << io.queue_depth << "): " << std::fixed << std::setprecision(3)
+                  << load_timer.stop() << " ms, " << bytes << " bytes, " << items.size() << " items"
+                  << std::endl;
+    }
+    return !items.empty();
+}
+
+#ifdef PACK_PLANNER_HAVE_ZLIB
+bool load_items_from_gzip(const std::string& filename, std::vector<item>& items, bool print_stats) {
+    timer load_timer;
+    load_timer.start();
+
+    // Inflating runs on the reader's thread while this thread parses
+    gzip_reader reader;
+    if (!reader.open(filename)) {
         return false;
     }
 
-    items.clear();
+    csv_block_parser parser;
+    std::string block;
+    size_t bytes = 0;
+    while (reader.next_block(block)) {
+        bytes += block.size();
+        parser.feed(block.data(), block.size(), items);
+    }
+    parser.finish(items);
+
+    if (!reader.ok()) {
+        std::cerr << "Corrupt gzip input: " << filename << std::endl;
+        return false;
+    }
+
+    if (print_stats) {
+        std::cerr << "Gzip ingest: " << std::fixed << std::setprecision(3) << load_timer.stop()
+                  << " ms, " << bytes << " bytes inflated, " << items.size() << " items" << std::endl;
+    }
+    return !items.empty();
+}
+#endif
+
+bool load_items_from_file(const std::string& filename, std::vector<item>& items,
+                          unsigned int thread_count, bool print_stats, const io_options& io) {
+#ifdef PACK_PLANNER_HAVE_ZLIB
+    if (is_gzip_file(filename)) {
+        return load_items_from_gzip(filename, items, print_stats);
+    }
+#endif
+
+    if (io.use_io_uring) {
+        return load_items_async(filename, items, io, print_stats);
+    }
+
+    csv_ingest ingest(thread_count);
+    const bool loaded = ingest.load(filename, items);
+
+    if (print_stats) {
+        std::cerr << "Chunk  Bytes        Lines       Items       Parse(ms)   MB/s" << std::endl;
+        std::cerr << "------------------------------------------------------------------" << std::endl;
+        for (const auto& stats : ingest.get_chunk_stats()) {
+            std::cerr << std::left << std::setw(7) << stats.chunk_index
+                      << std::setw(13) << stats.bytes
+                      << std::setw(12) << stats.lines
+                      << std::setw(12) << stats.items
+                      << std::fixed << std::setprecision(3)
+                      << std::setw(12) << stats.parse_time
+                      << std::setprecision(1) << stats.megabytes_per_second() << std::endl;
+        }
+        std::cerr << "Ingest total: " << std::fixed << std::setprecision(3)
+                  << ingest.get_total_time() << " ms, " << items.size() << " items" << std::endl;
+    }
+
+    return loaded;
+}
+
+int run_stdin_mode(pack_planner_config config) {
+    std::ios::sync_with_stdio(false);
+
     std::string line;
+    if (!std::getline(std::cin, line) || !parse_config_header(line, config)) {
+        std::cerr << "Expected header: [sort order],[max pieces],[max weight]" << std::endl;
+        return 1;
+    }
 
-    while (std::getline(file, line)) {
-        if (line.empty()) continue;
+    auto next_item_line = [&line]() {
+        // Input ends at an empty line or at end of stream
+        return std::getline(std::cin, line) && !line.empty() && line != "\r";
+    };
 
-        std::istringstream iss(line);
-        int id, length, quantity;
-        double weight;
-        char comma;
+    // NATURAL order needs no look-ahead: pack and emit while reading
+    if (config.order == sort_order::NATURAL && config.weights == weight_mode::FLOATING &&
+        pack_strategy_factory::is_streaming_strategy(config.type)) {
+        pack_formatter formatter(std::cout);
+        streaming_packer packer(config.max_items_per_pack, config.max_weight_per_pack,
+                                [&formatter](const pack& p) { formatter.write_pack(p); });
+
+        while (next_item_line()) {
+            int id, length;
+            std::int64_t quantity;
+            double weight;
+            if (csv_ingest::parse_line(line.data(), line.data() + line.size(),
+                                       id, length, quantity, weight)) {
+                packer.add_item(item(id, length, quantity, weight));
+            }
+        }
+
+        packer.finish();
+        formatter.flush();
+        if (packer.get_unplaced_items() > 0) {
+            std::cerr << "Warning: " << packer.get_unplaced_items()
+                      << " pieces were not packed: they weigh more than a pack's weight limit" << std::endl;
+        }
+        return 0;
+    }
 
-        if (iss >> id >> comma >> length >> comma >> quantity >> comma >> weight) {
+    std::vector<item> items;
+    while (next_item_line()) {
+        int id, length;
+        std::int64_t quantity;
+        double weight;
+        if (csv_ingest::parse_line(line.data(), line.data() + line.size(),
+                                   id, length, quantity, weight)) {
             items.emplace_back(id, length, quantity, weight);
         }
     }
 
-    file.close();
-    return !items.empty();
+    pack_planner planner;
+    auto result = planner.plan_packs(config, std::move(items));
+    if (!result.error.empty()) {
+        std::cerr << "Warning: " << result.error << std::endl;
+    }
+    planner.output_results(result.packs, std::cout);
+    return 0;
+}
+
+int run_pipeline_mode(const std::string& input_file, const std::string& output_file,
+                      const pack_planner_config& config, bool print_stats, const io_options& io) {
+    pipeline_planner pipeline;
+    pipeline_stats stats;
+
+    auto run_into = [&](std::ostream& output) -> int {
+#ifdef PACK_PLANNER_HAVE_ZLIB
+        if (is_gzip_file(input_file)) {
+            // Decompression is a fourth stage on the reader's own thread
+            gzip_reader reader;
+            if (!reader.open(input_file)) {
+                std::cerr << "Cannot read input file: " << input_file << std::endl;
+                return 1;
+            }
+            stats = pipeline.run_blocks([&reader](std::string& block) { return reader.next_block(block); },
+                                        config, output);
+            if (!reader.ok()) {
+                std::cerr << "Corrupt gzip input: " << input_file << std::endl;
+                return 1;
+            }
+            return 0;
+        }
+#endif
+        if (io.use_io_uring) {
+            async_file_reader reader;
+            if (!reader.open(input_file, io.queue_depth)) {
+                std::cerr << "Cannot read input file: " << input_file << std::endl;
+                return 1;
+            }
+            stats = pipeline.run_blocks([&reader](std::string& block) { return reader.next_block(block); },
+                                        config, output);
+            if (!reader.ok()) {
+                std::cerr << "Read error: " << input_file << std::endl;
+                return 1;
+            }
+            return 0;
+        }
+        if (!pipeline.run_file(input_file, config, output, stats)) {
+            std::cerr << "Cannot read input file: " << input_file << std::endl;
+            return 1;
+        }
+        return 0;
+    };
+
+    // The file streams report write errors only from close(), so close explicitly and check
+    auto write_to = [&](auto& output) -> int {
+        if (!output) {
+            std::cerr << "Cannot open output file: " << output_file << std::endl;
+            return 1;
+        }
+        const int status = run_into(output);
+        output.close();
+        if (status == 0 && !output) {
+            std::cerr << "Failed to write output: " << output_file << std::endl;
+            return 1;
+        }
+        return status;
+    };
+
+    int status = 0;
+#ifdef PACK_PLANNER_HAVE_ZLIB
+    if (has_gzip_extension(output_file)) {
+        gzip_ofstream output(output_file);
+        status = write_to(output);
+    } else
+#endif
+    if (io.use_io_uring) {
+        async_ofstream output(output_file, io.queue_depth);
+        status = write_to(output);
+    } else {
+        std::ofstream output(output_file, std::ios::binary | std::ios::trunc);
+        status = write_to(output);
+    }
+    if (status != 0) {
+        return status;
+    }
+
+    if (stats.unplaced_pieces > 0) {
+        std::cerr << "Warning: " << stats.unplaced_pieces
+                  << " pieces were not packed: they weigh more than a pack's weight limit" << std::endl;
+    }
+    if (print_stats) {
+        std::cerr << std::fixed << std::setprecision(3)
+                  << "Pipeline: " << stats.items << " items, " << stats.pieces << " pieces, "
+                  << stats.packs << " packs" << std::endl
+                  << "  parse " << stats.parse_time << " ms, pack " << stats.pack_time
+                  << " ms, write " << stats.write_time << " ms, wall " << stats.total_time
+                  << " ms" << std::endl;
+    }
+    return 0;
+}
+
+int run_batch_mode(const std::string& source, const std::string& output_dir,
+                   const std::string& report_file, const pack_planner_config& config,
+                   unsigned int worker_count) {
+    std::vector<batch_job> jobs;
+    if (!batch_runner::collect_jobs(source, output_dir, jobs)) {
+        std::cerr << "Cannot read batch source " << source << " or create " << output_dir << std::endl;
+        return 1;
+    }
+
+    batch_runner runner(worker_count);
+    const auto results = runner.run(jobs, config);
+    runner.print_summary(jobs, results, std::cerr);
+
+    if (!report_file.empty()) {
+        std::ofstream report(report_file);
+        batch_runner::write_report(jobs, results, report);
+        if (!report) {
+            std::cerr << "Failed to write batch report: " << report_file << std::endl;
+            return 1;
+        }
+    }
+
+    const bool all_ok = std::all_of(results.begin(), results.end(),
+                                    [](const batch_job_result& r) { return r.ok; });
+    return all_ok ? 0 : 1;
+}
+
+int run_ndjson_mode(const std::string& input_path, const std::string& output_path,
+                    const pack_planner_config& defaults, unsigned int worker_count,
+                    bool ordered, bool print_stats) {
+    std::ios::sync_with_stdio(false);
+
+    std::ifstream input_file;
+    if (input_path != "-") {
+        input_file.open(input_path, std::ios::binary);
+        if (!input_file.is_open()) {
+            std::cerr << "Cannot read input file: " << input_path << std::endl;
+            return 1;
+        }
+    }
+    std::ofstream output_file;
+    if (output_path != "-") {
+        output_file.open(output_path, std::ios::binary | std::ios::trunc);
+        if (!output_file.is_open()) {
+            std::cerr << "Cannot open output file: " << output_path << std::endl;
+            return 1;
+        }
+    }
+
+    ndjson_service service(defaults, worker_count, ordered);
+    service.run(input_path == "-" ? std::cin : input_file,
+                output_path == "-" ? std::cout : output_file);
+
+    if (print_stats) {
+        const double seconds = service.get_total_time() / 1000.0;
+        std::cerr << std::fixed << std::setprecision(3)
+                  << "NDJSON: " << service.get_requests() << " requests ("
+                  << service.get_failed() << " failed) in " << service.get_total_time() << " ms, "
+                  << std::setprecision(1)
+                  << (seconds > 0.0 ? service.get_requests() / seconds : 0.0) << " requests/s"
+                  << std::endl;
+    }
+    return 0;
 }
 
 int main(int argc, char* argv[]) {
@@ -55,11 +373,33 @@ int main(int argc, char* argv[]) {
     bool run_benchmark = false;
     bool run_sort_benchmark = false;
     bool run_thread_benchmark = false;
+    bool run_parse_benchmark = false;
+    bool print_ingest_stats = false;
+    bool read_stdin = false;
+    bool run_load_benchmark = false;
+    bool run_alloc_benchmark = false;
+    bool run_packing_benchmark = false;
+    bool print_pipeline_stats = false;
+    bool run_io_benchmark = false;
+    io_options io;
+    bool verify_checksum = false;
+    std::string binary_output_file;
+    std::string plan_output_file;
+    std::string batch_source;
+    std::string batch_output_dir = "batch_output";
+    std::string batch_report_file;
+    std::string ndjson_input;
+    std::string ndjson_output = "-";
+    bool ndjson_unordered = false;
+    bool print_ndjson_stats = false;
+    bool use_arena = false;
+    bool use_fixed_weights = false;
     std::vector<unsigned int> thread_counts = {1, 4, 8, 12, 16, 24};
 
-    app.add_option("-i,--input", input_file, "Input CSV file path");
-    app.add_option("-o,--output", output_file, "Output file path");
-    app.add_option("-s,--strategy", strategy_str, "Packing strategy");
+    app.add_option("-i,--input", input_file, "Input CSV file path (.gz and binary item files are detected)");
+    app.add_flag("--stdin", read_stdin, "Read spec-format input from stdin and write packs to stdout");
+    app.add_option("-o,--output", output_file, "Output file path (gzip-compressed if it ends in .gz)");
+    app.add_option("-s,--strategy", strategy_str, "Packing strategy (or PIPELINE for streamed NATURAL order)");
     app.add_option("--sort", sort_order_str, "Sort order");
     app.add_option("-m,--max-items", max_items_per_pack, "Maximum items per pack");
     app.add_option("-w,--max-weight", max_weight_per_pack, "Maximum weight per pack");
@@ -67,7 +407,35 @@ int main(int argc, char* argv[]) {
     app.add_flag("-b,--benchmark", run_benchmark, "Run performance benchmarks");
     app.add_flag("--benchmark-sort", run_sort_benchmark, "Run sorting algorithm benchmarks");
     app.add_flag("--benchmark-threads", run_thread_benchmark, "Run thread scaling benchmarks");
+    app.add_flag("--benchmark-parse", run_parse_benchmark, "Run CSV parser benchmarks");
     app.add_option("--thread-counts", thread_counts, "Thread counts for benchmark");
+    app.add_flag("--ingest-stats", print_ingest_stats, "Print per-chunk ingest throughput to stderr");
+    app.add_option("--to-binary", binary_output_file, "Convert the input CSV to a binary item file and exit");
+    app.add_option("--plan-output", plan_output_file, "Also write the plan as a binary plan file");
+    app.add_flag("--verify-checksum", verify_checksum, "Verify the checksum of a binary item input file");
+    app.add_flag("--pipeline-stats", print_pipeline_stats, "Print pipeline stage times to stderr");
+    app.add_flag("--io-uring", io.use_io_uring,
+                 "Use io_uring for file input/output (falls back to blocking I/O if unavailable)");
+    app.add_option("--queue-depth", io.queue_depth, "Reads/writes kept in flight with --io-uring");
+    app.add_flag("--benchmark-io", run_io_benchmark, "Run blocking vs. io_uring file I/O benchmarks");
+    app.add_flag("--benchmark-load", run_load_benchmark, "Run CSV vs. binary item load benchmarks");
+    app.add_flag("--benchmark-alloc", run_alloc_benchmark,
+                 "Run plan allocation benchmarks (global allocator vs. pmr arena)");
+    app.add_flag("--benchmark-packing", run_packing_benchmark,
+                 "Run packing loop benchmarks for each plan type");
+    app.add_option("--batch", batch_source,
+                   "Plan every file in a directory, or every path listed in a file, using -t workers");
+    app.add_option("--batch-output-dir", batch_output_dir, "Directory receiving one output file per batch job");
+    app.add_option("--batch-report", batch_report_file, "Write per-job batch timings as CSV");
+    app.add_option("--ndjson", ndjson_input,
+                   "Answer newline-delimited JSON planning requests from a file (- = stdin)");
+    app.add_option("--ndjson-output", ndjson_output, "NDJSON response file (- = stdout)");
+    app.add_flag("--ndjson-unordered", ndjson_unordered,
+                 "Write NDJSON responses as they complete instead of in request order");
+    app.add_flag("--ndjson-stats", print_ndjson_stats, "Print NDJSON request throughput to stderr");
+    app.add_flag("--arena", use_arena, "Build the plan in one flat arena instead of per-pack vectors");
+    app.add_flag("--fixed-weights", use_fixed_weights,
+                 "Round weights to thousandths and check pack capacity with exact integer arithmetic");
 
     CLI11_PARSE(app, argc, argv);
 
@@ -76,6 +444,31 @@ int main(int argc, char* argv[]) {
         return 0;
     }
 
+    if (run_parse_benchmark) {
+        benchmark::benchmark_parsers();
+        return 0;
+    }
+
+    if (run_io_benchmark) {
+        benchmark::benchmark_file_io();
+        return 0;
+    }
+
+    if (run_alloc_benchmark) {
+        benchmark::benchmark_plan_allocations();
+        return 0;
+    }
+
+    if (run_packing_benchmark) {
+        benchmark::benchmark_packing_loop();
+        return 0;
+    }
+
+    if (run_load_benchmark) {
+        benchmark::benchmark_item_load();
+        return 0;
+    }
+
     if (run_thread_benchmark) {
         benchmark bench;
         bench.run_benchmark_with_threads(thread_counts);
@@ -88,13 +481,14 @@ int main(int argc, char* argv[]) {
         return 0;
     }
 
-    if (input_file.empty()) {
-        return 1;
-    }
-
-    std::vector<item> items;
-    if (!load_items_from_file(input_file, items)) {
-        return 1;
+    if (read_stdin) {
+        pack_planner_config config;
+        config.type = parse_strategy_type(strategy_str);
+        config.max_items_per_pack = max_items_per_pack;
+        config.max_weight_per_pack = max_weight_per_pack;
+        config.thread_count = thread_count;
+        config.weights = use_fixed_weights ? weight_mode::FIXED_POINT : weight_mode::FLOATING;
+        return run_stdin_mode(config);
     }
 
     pack_planner_config config;
@@ -103,15 +497,125 @@ int main(int argc, char* argv[]) {
     config.max_items_per_pack = max_items_per_pack;
     config.max_weight_per_pack = max_weight_per_pack;
     config.thread_count = thread_count;
+    config.weights = use_fixed_weights ? weight_mode::FIXED_POINT : weight_mode::FLOATING;
+
+    if (!ndjson_input.empty()) {
+        // -s/--sort/-m/-w/-t are the defaults for fields a request leaves out
+        return run_ndjson_mode(ndjson_input, ndjson_output, config,
+                               static_cast<unsigned int>(std::max(1, thread_count)),
+                               !ndjson_unordered, print_ndjson_stats);
+    }
+
+    if (!batch_source.empty()) {
+        return run_batch_mode(batch_source, batch_output_dir, batch_report_file, config,
+                              static_cast<unsigned int>(std::max(1, thread_count)));
+    }
+
+    if (input_file.empty()) {
+        return 1;
+    }
+
+    // The pipeline renders while it parses, so it writes the text output itself
+    if (strategy_str == "PIPELINE") {
+        if (config.order == sort_order::NATURAL && config.weights == weight_mode::FLOATING &&
+            binary_output_file.empty() && plan_output_file.empty() &&
+            !binary_item_file::is_binary_item_file(input_file)) {
+            return run_pipeline_mode(input_file, output_file, config, print_pipeline_stats, io);
+        }
+        std::cerr << "PIPELINE needs NATURAL order, floating weights, CSV input and text-only output; "
+                  << "using BLOCKING_FIRST_FIT" << std::endl;
+    }
 
     pack_planner planner;
-    auto result = planner.plan_packs(config, items);
+    pack_planner_result result;
+    plan_arena arena;
+
+    // Binary item files are mapped and planned from their columns directly
+    binary_item_file binary_input;
+    if (binary_item_file::is_binary_item_file(input_file)) {
+        if (!binary_input.open(input_file, verify_checksum)) {
+            std::cerr << "Invalid or corrupt binary item file: " << input_file << std::endl;
+            return 1;
+        }
+        result = use_arena ? planner.plan_packs(config, item_columns(binary_input.columns()), arena)
+                           : planner.plan_packs(config, binary_input.columns());
+    } else {
+        std::vector<item> items;
+        if (!load_items_from_file(input_file, items,
+                                  static_cast<unsigned int>(std::max(1, thread_count)),
+                                  print_ingest_stats, io)) {
+            return 1;
+        }
 
-    std::ofstream file(output_file);
-    if (file.is_open()) {
-        planner.output_results(result.packs, file);
-        file.close();
+        if (!binary_output_file.empty()) {
+            if (!binary_item_file::write(binary_output_file, items)) {
+                std::cerr << "Failed to write binary item file: " << binary_output_file << std::endl;
+                return 1;
+            }
+            return 0;
+        }
+
+        result = use_arena ? planner.plan_packs(config, item_columns(items), arena)
+                           : planner.plan_packs(config, items);
     }
 
-    return 0;
+    // Pieces that could not be packed are reported, never dropped silently
+    if (!result.error.empty()) {
+        std::cerr << "Warning: " << result.error << std::endl;
+    }
+
+    // packs is result.packs or the arena; both render identically
+    auto write_plan = [&](const auto& packs) -> int {
+        if (!plan_output_file.empty() && !binary_plan_file::write(plan_output_file, packs)) {
+            std::cerr << "Failed to write binary plan file: " << plan_output_file << std::endl;
+            return 1;
+        }
+
+#ifdef PACK_PLANNER_HAVE_ZLIB
+        if (has_gzip_extension(output_file)) {
+            gzip_ofstream file(output_file);
+            planner.output_results(packs, file);
+            file.close();
+            if (!file) {
+                std::cerr << "Failed to write compressed output: " << output_file << std::endl;
+                return 1;
+            }
+            return 0;
+        }
+#endif
+
+        if (io.use_io_uring) {
+            async_ofstream file(output_file, io.queue_depth);
+            planner.output_results(packs, file);
+            file.close();
+            if (!file) {
+                std::cerr << "Failed to write output: " << output_file << std::endl;
+                return 1;
+            }
+            return 0;
+        }
+
+        parallel_output writer(static_cast<unsigned int>(std::max(1, thread_count)));
+        bool written = false;
+        if constexpr (std::is_same_v<std::decay_t<decltype(packs)>, plan_arena>) {
+            written = writer.write_arena_file(packs, output_file);
+        } else {
+            written = writer.write_file(packs, output_file);
+        }
+        if (!written) {
+            // Not mappable (e.g. /dev/stdout or a FIFO): use the stream writer
+            std::ofstream file(output_file);
+            if (file.is_open()) {
+                planner.output_results(packs, file);
+            }
+            file.close();
+            if (!file) {
+                std::cerr << "Failed to write output: " << output_file << std::endl;
+                return 1;
+            }
+        }
+        return 0;
+    };
+
+    return use_arena ? write_plan(arena) : write_plan(result.packs);
 }
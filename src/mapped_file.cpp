@@ -0,0 +1,109 @@
+#include "mapped_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <utility>
+
+mapped_file::~mapped_file() {
+    close();
+}
+
+mapped_file::mapped_file(mapped_file&& other) noexcept
+    : m_data(std::exchange(other.m_data, nullptr)),
+      m_size(std::exchange(other.m_size, 0)),
+      m_fd(std::exchange(other.m_fd, -1)) {}
+
+mapped_file& mapped_file::operator=(mapped_file&& other) noexcept {
+    if (this != &other) {
+        close();
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+        m_fd = std::exchange(other.m_fd, -1);
+    }
+    return *this;
+}
+
+bool mapped_file::open_read(const std::string& path) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st {};
+    if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        ::close(fd);
+        return false;
+    }
+
+    m_fd = fd;
+    m_size = static_cast<size_t>(st.st_size);
+
+    // mmap() rejects zero-length mappings; an empty file is still a valid open
+    if (m_size == 0) {
+        return true;
+    }
+
+    void* addr = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr == MAP_FAILED) {
+        close();
+        return false;
+    }
+
+    m_data = static_cast<char*>(addr);
+    return true;
+}
+
+bool mapped_file::create(const std::string& path, size_t size) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+
+    // Reserve the blocks now: running out of space later, while writing
+    // through the mapping, raises SIGBUS instead of failing here
+    if (size > 0 && ::posix_fallocate(fd, 0, static_cast<off_t>(size)) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    m_fd = fd;
+    m_size = size;
+
+    if (m_size == 0) {
+        return true;
+    }
+
+    void* addr = ::mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED) {
+        close();
+        return false;
+    }
+
+    m_data = static_cast<char*>(addr);
+    return true;
+}
+
+void mapped_file::close() noexcept {
+    if (m_data != nullptr) {
+        ::munmap(m_data, m_size);
+        m_data = nullptr;
+    }
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+    m_size = 0;
+}
+
+void mapped_file::advise_sequential() const noexcept {
+    if (m_data != nullptr) {
+        ::madvise(m_data, m_size, MADV_SEQUENTIAL);
+    }
+}
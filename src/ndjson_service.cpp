@@ -0,0 +1,607 @@
+#include "ndjson_service.h"
+#include "timer.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <condition_variable>
+#include <deque>
+#include <limits>
+#include <map>
+#include <memory_resource>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+/**
+ * @brief Forward-only reader over one JSON document
+ * Just enough JSON for planning requests: members the request does not
+ * know are skipped whatever their type, numbers are decoded with
+ * std::from_chars.
+ */
+class json_cursor {
+public:
+    explicit json_cursor(std::string_view text) noexcept
+        : m_pos(text.data()), m_begin(text.data()), m_end(text.data() + text.size()) {}
+
+    void skip_ws() noexcept {
+        while (m_pos != m_end && (*m_pos == ' ' || *m_pos == '\t' || *m_pos == '\r' || *m_pos == '\n')) ++m_pos;
+    }
+
+    // Consume c (after whitespace) if it is next
+    bool consume(char c) noexcept {
+        skip_ws();
+        if (m_pos != m_end && *m_pos == c) {
+            ++m_pos;
+            return true;
+        }
+        return false;
+    }
+
+    [[nodiscard]] char peek() noexcept {
+        skip_ws();
+        return m_pos != m_end ? *m_pos : '\0';
+    }
+
+    [[nodiscard]] bool at_end() noexcept {
+        skip_ws();
+        return m_pos == m_end;
+    }
+
+    [[nodiscard]] size_t offset() const noexcept { return static_cast<size_t>(m_pos - m_begin); }
+
+    [[nodiscard]] const char* position() const noexcept { return m_pos; }
+
+    bool parse_string(std::string& out) {
+        out.clear();
+        if (!consume('"')) return false;
+        while (m_pos != m_end) {
+            const char c = *m_pos++;
+            if (c == '"') return true;
+            if (static_cast<unsigned char>(c) < 0x20) return false;
+            if (c != '\\') {
+                out += c;
+                continue;
+            }
+            if (m_pos == m_end) return false;
+            switch (*m_pos++) {
+            case '"': out += '"'; break;
+            case '\\': out += '\\'; break;
+            case '/': out += '/'; break;
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'n': out += '\n'; break;
+            case 'r': out += '\r'; break;
+            case 't': out += '\t'; break;
+            case 'u': {
+                unsigned code = 0;
+                if (!parse_hex4(code)) return false;
+                if (code >= 0xD800 && code < 0xDC00) {
+                    unsigned low = 0;
+                    if (m_end - m_pos < 2 || m_pos[0] != '\\' || m_pos[1] != 'u') return false;
+                    m_pos += 2;
+                    if (!parse_hex4(low) || low < 0xDC00 || low >= 0xE000) return false;
+                    code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                }
+                append_utf8(out, code);
+                break;
+            }
+            default:
+                return false;
+            }
+        }
+        return false;
+    }
+
+    bool parse_double(double& value) noexcept {
+        skip_ws();
+        const char* last = number_end();
+        if (last == m_pos) return false;
+        auto [ptr, ec] = std::from_chars(m_pos, last, value);
+        if (ec != std::errc() || ptr != last || !std::isfinite(value)) return false;
+        m_pos = last;
+        return true;
+    }
+
+    // Integers may be written as 5, 5.0 or 5e0, but must be integral and fit in Int
+    template <typename Int>
+    bool parse_int(Int& value) noexcept {
+        skip_ws();
+        const char* last = number_end();
+        if (last == m_pos) return false;
+        auto [ptr, ec] = std::from_chars(m_pos, last, value);
+        if (ec == std::errc() && ptr == last) {
+            m_pos = last;
+            return true;
+        }
+        double d = 0.0;
+        auto [dptr, dec] = std::from_chars(m_pos, last, d);
+        // The bounds are -2^(N-1) and 2^(N-1), both exact as doubles
+        constexpr double lowest = static_cast<double>(std::numeric_limits<Int>::min());
+        if (dec != std::errc() || dptr != last || d != std::floor(d) || d < lowest || d >= -lowest) {
+            return false;
+        }
+        value = static_cast<Int>(d);
+        m_pos = last;
+        return true;
+    }
+
+    bool skip_value(int depth = 0) {
+        if (depth > 64) return false;
+        switch (peek()) {
+        case '"': {
+            std::string ignored;
+            return parse_string(ignored);
+        }
+        case '{':
+            ++m_pos;
+            if (consume('}')) return true;
+            do {
+                std::string key;
+                if (!parse_string(key) || !consume(':') || !skip_value(depth + 1)) return false;
+            } while (consume(','));
+            return consume('}');
+        case '[':
+            ++m_pos;
+            if (consume(']')) return true;
+            do {
+                if (!skip_value(depth + 1)) return false;
+            } while (consume(','));
+            return consume(']');
+        case 't': return consume_literal("true");
+        case 'f': return consume_literal("false");
+        case 'n': return consume_literal("null");
+        default: {
+            double ignored;
+            return parse_double(ignored);
+        }
+        }
+    }
+
+private:
+    const char* number_end() const noexcept {
+        const char* p = m_pos;
+        while (p != m_end && ((*p >= '0' && *p <= '9') || *p == '-' || *p == '+' ||
+                              *p == '.' || *p == 'e' || *p == 'E')) {
+            ++p;
+        }
+        return p;
+    }
+
+    bool consume_literal(std::string_view literal) noexcept {
+        if (static_cast<size_t>(m_end - m_pos) < literal.size() ||
+            std::string_view(m_pos, literal.size()) != literal) {
+            return false;
+        }
+        m_pos += literal.size();
+        return true;
+    }
+
+    bool parse_hex4(unsigned& code) noexcept {
+        if (m_end - m_pos < 4) return false;
+        auto [ptr, ec] = std::from_chars(m_pos, m_pos + 4, code, 16);
+        if (ec != std::errc() || ptr != m_pos + 4) return false;
+        m_pos += 4;
+        return true;
+    }
+
+    static void append_utf8(std::string& out, unsigned code) {
+        if (code < 0x80) {
+            out += static_cast<char>(code);
+        } else if (code < 0x800) {
+            out += static_cast<char>(0xC0 | (code >> 6));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        } else if (code < 0x10000) {
+            out += static_cast<char>(0xE0 | (code >> 12));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (code >> 18));
+            out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        }
+    }
+
+    const char* m_pos;
+    const char* m_begin;
+    const char* m_end;
+};
+
+void append_int(std::string& out, long long value) {
+    char buffer[24];
+    out.append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), value).ptr);
+}
+
+// Shortest round-trip representation; JSON has no NaN/Infinity
+void append_double(std::string& out, double value) {
+    if (!std::isfinite(value)) {
+        out += "null";
+        return;
+    }
+    char buffer[32];
+    out.append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), value).ptr);
+}
+
+void append_string(std::string& out, std::string_view text) {
+    static constexpr char hex[] = "0123456789abcdef";
+    out += '"';
+    for (const char c : text) {
+        switch (c) {
+        case '"': out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                out += "\\u00";
+                out += hex[(c >> 4) & 0xF];
+                out += hex[c & 0xF];
+            } else {
+                out += c;
+            }
+        }
+    }
+    out += '"';
+}
+
+bool parse_item(json_cursor& cursor, std::vector<item>& items) {
+    int id = 0, length = 0;
+    std::int64_t quantity = 0;
+    double weight = 0.0;
+
+    if (cursor.consume('[')) {
+        // Compact form: [id, length, quantity, weight]
+        if (!cursor.parse_int(id) || !cursor.consume(',') || !cursor.parse_int(length) ||
+            !cursor.consume(',') || !cursor.parse_int(quantity) || !cursor.consume(',') ||
+            !cursor.parse_double(weight) || !cursor.consume(']')) {
+            return false;
+        }
+        items.emplace_back(id, length, quantity, weight);
+        return true;
+    }
+
+    if (!cursor.consume('{')) return false;
+    unsigned seen = 0;
+    if (!cursor.consume('}')) {
+        std::string key;
+        do {
+            if (!cursor.parse_string(key) || !cursor.consume(':')) return false;
+            bool ok;
+            if (key == "id") { ok = cursor.parse_int(id); seen |= 1; }
+            else if (key == "length") { ok = cursor.parse_int(length); seen |= 2; }
+            else if (key == "quantity") { ok = cursor.parse_int(quantity); seen |= 4; }
+            else if (key == "weight") { ok = cursor.parse_double(weight); seen |= 8; }
+            else ok = cursor.skip_value();
+            if (!ok) return false;
+        } while (cursor.consume(','));
+        if (!cursor.consume('}')) return false;
+    }
+    if (seen != 15) return false;
+    items.emplace_back(id, length, quantity, weight);
+    return true;
+}
+
+bool parse_configuration(json_cursor& cursor, pack_planner_config& config) {
+    if (!cursor.consume('{')) return false;
+    if (cursor.consume('}')) return true;
+
+    std::string key;
+    std::string text;
+    do {
+        if (!cursor.parse_string(key) || !cursor.consume(':')) return false;
+        bool ok;
+        if (key == "sortOrder") {
+            ok = cursor.parse_string(text);
+            config.order = parse_sort_order(text);
+        } else if (key == "strategyType") {
+            ok = cursor.parse_string(text);
+            config.type = pack_strategy_factory::parse_strategy_type(text);
+        } else if (key == "maxItemsPerPack") {
+            ok = cursor.parse_int(config.max_items_per_pack);
+        } else if (key == "maxWeightPerPack") {
+            ok = cursor.parse_double(config.max_weight_per_pack);
+        } else if (key == "threadCount") {
+            ok = cursor.parse_int(config.thread_count);
+        } else {
+            ok = cursor.skip_value();
+        }
+        if (!ok) return false;
+    } while (cursor.consume(','));
+    return cursor.consume('}');
+}
+
+}  // namespace
+
+ndjson_service::ndjson_service(const pack_planner_config& defaults, unsigned int worker_count,
+                               bool ordered) noexcept
+    : m_defaults(defaults), m_worker_count(worker_count), m_ordered(ordered) {
+    if (m_worker_count == 0) {
+        m_worker_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+}
+
+bool ndjson_service::parse_request(std::string_view line, ndjson_request& request,
+                                   std::string& error) const {
+    request.id.clear();
+    request.config = m_defaults;
+    request.items.clear();
+
+    json_cursor cursor(line);
+    auto fail = [&](const char* what) {
+        error = std::string(what) + " at offset " + std::to_string(cursor.offset());
+        return false;
+    };
+
+    if (!cursor.consume('{')) return fail("expected a JSON object");
+    if (!cursor.consume('}')) {
+        std::string key;
+        do {
+            if (!cursor.parse_string(key) || !cursor.consume(':')) return fail("expected a member name");
+            if (key == "id") {
+                const char c = cursor.peek();
+                const char* first = cursor.position();
+                if ((c != '"' && c != '-' && (c < '0' || c > '9')) || !cursor.skip_value()) {
+                    return fail("id must be a string or number");
+                }
+                request.id.assign(first, cursor.position());
+            } else if (key == "items") {
+                if (!cursor.consume('[')) return fail("items must be an array");
+                if (!cursor.consume(']')) {
+                    do {
+                        if (!parse_item(cursor, request.items)) {
+                            return fail("items need id, length, quantity and weight");
+                        }
+                    } while (cursor.consume(','));
+                    if (!cursor.consume(']')) return fail("unterminated items array");
+                }
+            } else if (key == "configuration") {
+                if (!parse_configuration(cursor, request.config)) return fail("invalid configuration");
+            } else if (!cursor.skip_value()) {
+                return fail("invalid value");
+            }
+        } while (cursor.consume(','));
+        if (!cursor.consume('}')) return fail("expected '}'");
+    }
+    if (!cursor.at_end()) return fail("trailing characters");
+    return true;
+}
+
+void ndjson_service::render_response(std::string_view id, const pack_planner_config& config,
+                                     const pack_planner_result& result, std::string& out) {
+    out += "{\"id\":";
+    out += id;
+    out += ",\"success\":true,\"packs\":[";
+
+    // Only non-empty packs are listed; strategies may leave reserved empty ones behind
+    int pack_count = 0;
+    for (const auto& p : result.packs) {
+        if (p.is_empty()) continue;
+        if (pack_count++ > 0) out += ',';
+        out += "{\"packNumber\":";
+        append_int(out, p.get_pack_number());
+        out += ",\"items\":[";
+        bool first = true;
+        for (const auto& i : p.get_items()) {
+            if (!first) out += ',';
+            first = false;
+            out += "{\"id\":";
+            append_int(out, i.get_id());
+            out += ",\"length\":";
+            append_int(out, i.get_length());
+            out += ",\"quantity\":";
+            append_int(out, i.get_quantity());
+            out += ",\"weight\":";
+            append_double(out, i.get_weight());
+            out += ",\"totalWeight\":";
+            append_double(out, i.get_total_weight());
+            out += '}';
+        }
+        out += "],\"totalItems\":";
+        append_int(out, p.get_total_items());
+        out += ",\"totalWeight\":";
+        append_double(out, p.get_total_weight());
+        out += ",\"packLength\":";
+        append_int(out, p.get_pack_length());
+        out += ",\"isEmpty\":false}";
+    }
+
+    out += "],\"metrics\":{\"sortingTimeMs\":";
+    append_double(out, result.sorting_time);
+    out += ",\"packingTimeMs\":";
+    append_double(out, result.packing_time);
+    out += ",\"totalTimeMs\":";
+    append_double(out, result.total_time);
+    out += ",\"totalItems\":";
+    append_int(out, result.total_items);
+    out += ",\"unplacedItems\":";
+    append_int(out, result.unplaced_items);
+    out += ",\"utilizationPercent\":";
+    append_double(out, result.utilization_percent);
+    out += ",\"strategyUsed\":";
+    append_string(out, result.strategy_name);
+    out += ",\"packCount\":";
+    append_int(out, pack_count);
+
+    out += "},\"configuration\":{\"sortOrder\":";
+    append_string(out, sort_order_to_string(config.order));
+    out += ",\"maxItemsPerPack\":";
+    append_int(out, config.max_items_per_pack);
+    out += ",\"maxWeightPerPack\":";
+    append_double(out, config.max_weight_per_pack);
+    out += ",\"strategyType\":";
+    append_string(out, pack_strategy_factory::strategy_type_to_string(config.type));
+    out += ",\"threadCount\":";
+    append_int(out, config.thread_count);
+    out += "}}";
+}
+
+void ndjson_service::render_error(std::string_view id, std::string_view error,
+                                  std::string_view details, std::string& out) {
+    out += "{\"id\":";
+    out += id;
+    out += ",\"success\":false,\"error\":";
+    append_string(out, error);
+    out += ",\"details\":";
+    append_string(out, details);
+    out += '}';
+}
+
+bool ndjson_service::process(std::string_view line, size_t line_number, pack_planner& planner,
+                             std::string& response) const {
+    response.clear();
+    ndjson_request request;
+    std::string error;
+
+    const bool parsed = parse_request(line, request, error);
+    if (request.id.empty()) {
+        request.id = std::to_string(line_number);
+    }
+
+    if (!parsed) {
+        render_error(request.id, "Invalid request", error, response);
+        return false;
+    }
+    if (request.items.empty()) {
+        render_error(request.id, "Items list cannot be null or empty",
+                     "At least one item must be provided for pack planning", response);
+        return false;
+    }
+
+    // The plan only lives until it is rendered: bump-allocate it and drop it in one release
+    std::pmr::monotonic_buffer_resource arena;
+    const pack_planner_config config = request.config;
+    const auto result = planner.plan_packs(config, item_columns(request.items), &arena);
+    render_response(request.id, config, result, response);
+    return true;
+}
+
+void ndjson_service::run(std::istream& input, std::ostream& output) {
+    timer run_timer;
+    run_timer.start();
+
+    struct job {
+        size_t sequence;
+        size_t line_number;
+        std::string line;
+    };
+
+    std::mutex mutex;
+    std::condition_variable jobs_ready;
+    std::condition_variable responses_ready;
+    std::condition_variable space_ready;
+    std::deque<job> jobs;
+    std::map<size_t, std::string> responses;  // by sequence number
+    bool input_done = false;
+    size_t read_count = 0;
+    size_t written_count = 0;
+    size_t failed = 0;
+
+    const size_t max_in_flight = m_worker_count * IN_FLIGHT_PER_WORKER;
+
+    auto worker = [&]() {
+        pack_planner planner;
+        for (;;) {
+            job next;
+            {
+                std::unique_lock lock(mutex);
+                jobs_ready.wait(lock, [&] { return !jobs.empty() || input_done; });
+                if (jobs.empty()) return;
+                next = std::move(jobs.front());
+                jobs.pop_front();
+            }
+
+            std::string response;
+            const bool ok = process(next.line, next.line_number, planner, response);
+
+            std::lock_guard lock(mutex);
+            if (!ok) ++failed;
+            responses.emplace(next.sequence, std::move(response));
+            responses_ready.notify_one();
+        }
+    };
+
+    auto writer = [&]() {
+        std::string buffer;
+        for (;;) {
+            {
+                std::unique_lock lock(mutex);
+                auto ready = [&] {
+                    if (responses.empty()) return false;
+                    return !m_ordered || responses.begin()->first == written_count;
+                };
+                if (!ready()) {
+                    // Nothing to add right now: hand what we have to the stream
+                    if (!buffer.empty()) {
+                        lock.unlock();
+                        output.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                        output.flush();
+                        buffer.clear();
+                        lock.lock();
+                    }
+                    responses_ready.wait(lock, [&] {
+                        return ready() || (input_done && written_count == read_count);
+                    });
+                    if (!ready()) return;
+                }
+
+                const size_t before = written_count;
+                while (ready()) {
+                    auto first = responses.begin();
+                    buffer += first->second;
+                    buffer += '\n';
+                    responses.erase(first);
+                    ++written_count;
+                }
+                if (written_count != before) space_ready.notify_one();
+            }
+
+            if (buffer.size() >= (1 << 20)) {
+                output.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                buffer.clear();
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(m_worker_count);
+    for (unsigned int w = 0; w < m_worker_count; ++w) {
+        workers.emplace_back(worker);
+    }
+    std::thread writer_thread(writer);
+
+    std::string line;
+    size_t line_number = 0;
+    while (std::getline(input, line)) {
+        ++line_number;
+        if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+
+        std::unique_lock lock(mutex);
+        space_ready.wait(lock, [&] { return read_count - written_count < max_in_flight; });
+        jobs.push_back({read_count++, line_number, std::move(line)});
+        jobs_ready.notify_one();
+    }
+
+    {
+        std::lock_guard lock(mutex);
+        input_done = true;
+    }
+    jobs_ready.notify_all();
+    for (auto& t : workers) {
+        t.join();
+    }
+    {
+        // Wake the writer in case it is waiting on the last response
+        std::lock_guard lock(mutex);
+        responses_ready.notify_all();
+    }
+    writer_thread.join();
+    output.flush();
+
+    m_requests = written_count;
+    m_failed = failed;
+    m_total_time = run_timer.stop();
+}
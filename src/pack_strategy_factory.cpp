@@ -3,31 +3,56 @@
 #include "parallel_pack_strategy.h"
 #include "lockfree_pack_strategy.h"
 #include "blocking_next_fit_strategy.h"
+#include "first_fit_pack_strategy.h"
+#include "best_fit_pack_strategy.h"
+#include "bounded_best_fit_strategy.h"
 
 #include <algorithm>
 #include <cctype>
 
 std::unique_ptr<pack_strategy> pack_strategy_factory::create_strategy(
     strategy_type type,
-    int thread_count) {
+    int thread_count,
+    weight_mode weights) {
 
+    std::unique_ptr<pack_strategy> strategy;
     switch (type) {
     case strategy_type::BLOCKING_FIRST_FIT:
-        return std::make_unique<blocking_pack_strategy>();
+        strategy = std::make_unique<blocking_pack_strategy>();
+        break;
 
     case strategy_type::BLOCKING_NEXT_FIT:
-        return std::make_unique<next_fit_pack_strategy>();
+        strategy = std::make_unique<next_fit_pack_strategy>();
+        break;
 
     case strategy_type::PARALLEL_FIRST_FIT:
-        return std::make_unique<parallel_pack_strategy>(thread_count);
+        strategy = std::make_unique<parallel_pack_strategy>(thread_count);
+        break;
 
     case strategy_type::LOCKFREE_FIRST_FIT:
-        return std::make_unique<lockfree_pack_strategy>(thread_count);
+        strategy = std::make_unique<lockfree_pack_strategy>(thread_count);
+        break;
+
+    case strategy_type::FIRST_FIT:
+        strategy = std::make_unique<first_fit_pack_strategy>();
+        break;
+
+    case strategy_type::BEST_FIT:
+        strategy = std::make_unique<best_fit_pack_strategy>();
+        break;
+
+    case strategy_type::BOUNDED_BEST_FIT:
+        strategy = std::make_unique<bounded_best_fit_pack_strategy>();
+        break;
 
     default:
         // Default to blocking next-fit (fastest)
-        return std::make_unique<next_fit_pack_strategy>();
+        strategy = std::make_unique<next_fit_pack_strategy>();
+        break;
     }
+
+    strategy->set_weight_mode(weights);
+    return strategy;
 }
 
 strategy_type pack_strategy_factory::parse_strategy_type(const std::string& str) {
@@ -37,11 +62,23 @@ strategy_type pack_strategy_factory::parse_strategy_type(const std::string& str)
                    [](unsigned char c){ return std::tolower(c); });
 
     // Check for various string representations
-    if (lower_str == "blocking" || lower_str == "blocking_first_fit" ||
-        lower_str == "first_fit" || lower_str == "firstfit") {
+    if (lower_str == "blocking" || lower_str == "blocking_first_fit") {
         return strategy_type::BLOCKING_FIRST_FIT;
     }
 
+    if (lower_str == "first_fit" || lower_str == "firstfit" || lower_str == "first-fit") {
+        return strategy_type::FIRST_FIT;
+    }
+
+    if (lower_str == "best_fit" || lower_str == "bestfit" || lower_str == "best-fit") {
+        return strategy_type::BEST_FIT;
+    }
+
+    if (lower_str == "bounded_best_fit" || lower_str == "bounded-best-fit" ||
+        lower_str == "boundedbestfit" || lower_str == "best_fit_k") {
+        return strategy_type::BOUNDED_BEST_FIT;
+    }
+
     if (lower_str == "next_fit" || lower_str == "nextfit" ||
         lower_str == "next-fit" || lower_str == "blocking_next_fit") {
         return strategy_type::BLOCKING_NEXT_FIT;
@@ -75,6 +112,15 @@ std::string pack_strategy_factory::strategy_type_to_string(strategy_type type) {
     case strategy_type::LOCKFREE_FIRST_FIT:
         return "Lock-free";
 
+    case strategy_type::FIRST_FIT:
+        return "First-Fit";
+
+    case strategy_type::BEST_FIT:
+        return "Best-Fit";
+
+    case strategy_type::BOUNDED_BEST_FIT:
+        return "Bounded Best-Fit";
+
     default:
         return "Unknown";
     }
@@ -85,7 +131,10 @@ std::vector<strategy_type> pack_strategy_factory::get_all_strategies() {
         strategy_type::BLOCKING_FIRST_FIT,
         strategy_type::BLOCKING_NEXT_FIT,
         strategy_type::PARALLEL_FIRST_FIT,
-        strategy_type::LOCKFREE_FIRST_FIT
+        strategy_type::LOCKFREE_FIRST_FIT,
+        strategy_type::FIRST_FIT,
+        strategy_type::BEST_FIT,
+        strategy_type::BOUNDED_BEST_FIT
     };
 }
 
@@ -104,6 +153,16 @@ bool pack_strategy_factory::is_parallel_strategy(strategy_type type) {
     }
 }
 
+bool pack_strategy_factory::is_streaming_strategy(strategy_type type) {
+    switch (type) {
+    case strategy_type::BLOCKING_FIRST_FIT:
+    case strategy_type::BLOCKING_NEXT_FIT:
+        return true;
+    default:
+        return false;
+    }
+}
+
 int pack_strategy_factory::get_default_thread_count(strategy_type type) {
     if (is_parallel_strategy(type)) {
         return std::thread::hardware_concurrency();
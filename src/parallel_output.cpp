@@ -0,0 +1,157 @@
+#include "parallel_output.h"
+#include "mapped_file.h"
+#include "pack_formatter.h"
+#include "timer.h"
+
+#include <algorithm>
+#include <fstream>
+#include <thread>
+
+parallel_output::parallel_output(unsigned int thread_count) noexcept
+    : m_thread_count(thread_count) {
+    if (m_thread_count == 0) {
+        m_thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+}
+
+namespace {
+
+// Packs is std::vector<pack> or plan_arena
+template <typename Packs>
+std::vector<size_t> split_pack_ranges(const Packs& packs, size_t range_count) {
+    size_t total_lines = 0;
+    for (const auto& p : packs) {
+        total_lines += p.get_items().size() + 2;
+    }
+
+    range_count = std::max<size_t>(1, range_count);
+    const size_t target = total_lines / range_count + 1;
+
+    std::vector<size_t> bounds;
+    bounds.reserve(range_count + 1);
+    bounds.push_back(0);
+
+    size_t lines = 0;
+    for (size_t i = 0; i < packs.size() && bounds.size() < range_count; ++i) {
+        lines += packs[i].get_items().size() + 2;
+        if (lines >= target) {
+            bounds.push_back(i + 1);
+            lines = 0;
+        }
+    }
+
+    if (bounds.size() == 1 || bounds.back() != packs.size()) {
+        bounds.push_back(packs.size());
+    }
+    return bounds;
+}
+
+}  // namespace
+
+std::vector<size_t> parallel_output::split_ranges(const std::vector<pack>& packs,
+                                                  size_t range_count) {
+    return split_pack_ranges(packs, range_count);
+}
+
+bool parallel_output::write_file(const std::vector<pack>& packs, const std::string& path) {
+    return write_packs(packs, path);
+}
+
+bool parallel_output::write_arena_file(const plan_arena& packs, const std::string& path) {
+    return write_packs(packs, path);
+}
+
+template <typename Packs>
+bool parallel_output::write_packs(const Packs& packs, const std::string& path) {
+    timer output_timer;
+    output_timer.start();
+
+    m_bytes_written = 0;
+
+    size_t total_lines = 0;
+    for (const auto& p : packs) {
+        total_lines += p.get_items().size();
+    }
+
+    const size_t thread_count = std::clamp<size_t>(total_lines / MIN_LINES_PER_THREAD, 1, m_thread_count);
+    const std::vector<size_t> bounds = split_pack_ranges(packs, thread_count);
+    const size_t range_count = bounds.size() - 1;
+    m_threads_used = range_count;
+
+    if (range_count == 1) {
+        // One worker gains nothing from measuring first: stream it instead
+        std::ofstream output(path, std::ios::binary | std::ios::trunc);
+        if (!output.is_open()) {
+            m_total_time = output_timer.stop();
+            return false;
+        }
+        pack_formatter formatter(output);
+        for (const auto& p : packs) {
+            if (!p.is_empty()) {
+                formatter.write_pack(p);
+            }
+        }
+        formatter.flush();
+        m_bytes_written = static_cast<size_t>(output.tellp());
+        m_total_time = output_timer.stop();
+        return output.good();
+    }
+
+    auto run = [range_count](auto&& work) {
+        std::vector<std::thread> workers;
+        workers.reserve(range_count - 1);
+        for (size_t r = 1; r < range_count; ++r) {
+            workers.emplace_back(work, r);
+        }
+        work(0);
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    };
+
+    // Pass 1: exact rendered size of every range
+    std::vector<size_t> offsets(range_count + 1, 0);
+    run([&](size_t r) {
+        size_t bytes = 0;
+        for (size_t i = bounds[r]; i < bounds[r + 1]; ++i) {
+            if (!packs[i].is_empty()) {
+                bytes += pack_formatter::measure_pack(packs[i]);
+            }
+        }
+        offsets[r + 1] = bytes;
+    });
+
+    for (size_t r = 0; r < range_count; ++r) {
+        offsets[r + 1] += offsets[r];
+    }
+
+    mapped_file file;
+    if (!file.create(path, offsets.back())) {
+        m_total_time = output_timer.stop();
+        return false;
+    }
+
+    // Pass 2: every range renders into its own slice of the mapping
+    std::vector<char> complete(range_count, 0);
+    char* const base = file.data();
+    run([&](size_t r) {
+        char* out = base + offsets[r];
+        const char* const end = base + offsets[r + 1];
+        for (size_t i = bounds[r]; i < bounds[r + 1]; ++i) {
+            if (!packs[i].is_empty()) {
+                out = pack_formatter::render_pack(out, end, packs[i]);
+            }
+        }
+        complete[r] = out == end;
+    });
+
+    file.close();
+    m_total_time = output_timer.stop();
+
+    if (!std::all_of(complete.begin(), complete.end(), [](char done) { return done != 0; })) {
+        return false;
+    }
+
+    m_bytes_written = offsets.back();
+    return true;
+}
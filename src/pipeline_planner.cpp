@@ -0,0 +1,158 @@
+#include "pipeline_planner.h"
+#include "csv_ingest.h"
+#include "csv_scanner.h"
+#include "mapped_file.h"
+#include "pack_formatter.h"
+#include "streaming_packer.h"
+#include "timer.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+pipeline_planner::pipeline_planner(size_t slice_bytes, size_t pack_batch,
+                                   size_t ring_capacity) noexcept
+    : m_slice_bytes(std::max<size_t>(1024, slice_bytes)),
+      m_pack_batch(std::max<size_t>(1, pack_batch)),
+      m_ring_capacity(std::max<size_t>(2, ring_capacity)) {}
+
+pipeline_stats pipeline_planner::run(const char* data, size_t size,
+                                     const pack_planner_config& config, std::ostream& output) {
+    // Stage 1: parse newline-aligned slices into item batches
+    return run_stages([&](item_ring& items, pipeline_stats& stats) {
+        const std::vector<size_t> bounds =
+            size == 0 ? std::vector<size_t>{0} : csv_ingest::split_chunks(data, size, size / m_slice_bytes + 1);
+        for (size_t s = 0; s + 1 < bounds.size(); ++s) {
+            timer slice_timer;
+            slice_timer.start();
+            std::vector<item> batch;
+            batch.reserve((bounds[s + 1] - bounds[s]) / 16 + 16);
+            csv_scanner::parse_range(data + bounds[s], data + bounds[s + 1], batch);
+            stats.parse_time += slice_timer.stop();
+
+            if (!batch.empty()) {
+                items.push(std::move(batch));
+            }
+        }
+    }, config, output);
+}
+
+pipeline_stats pipeline_planner::run_blocks(const std::function<bool(std::string&)>& next_block,
+                                            const pack_planner_config& config, std::ostream& output) {
+    // Stage 1: parse blocks as they arrive; partial lines carry over
+    return run_stages([&](item_ring& items, pipeline_stats& stats) {
+        csv_block_parser parser;
+        std::string block;
+        while (next_block(block)) {
+            timer block_timer;
+            block_timer.start();
+            std::vector<item> batch;
+            batch.reserve(block.size() / 16 + 16);
+            parser.feed(block.data(), block.size(), batch);
+            stats.parse_time += block_timer.stop();
+
+            if (!batch.empty()) {
+                items.push(std::move(batch));
+            }
+        }
+
+        std::vector<item> tail;
+        parser.finish(tail);
+        if (!tail.empty()) {
+            items.push(std::move(tail));
+        }
+    }, config, output);
+}
+
+pipeline_stats pipeline_planner::run_stages(
+    const std::function<void(item_ring&, pipeline_stats&)>& parse_stage,
+    const pack_planner_config& config, std::ostream& output) {
+    pipeline_stats stats;
+    timer total_timer;
+    total_timer.start();
+
+    item_ring item_batches(m_ring_capacity);
+    spsc_ring<std::vector<pack>> pack_batches(m_ring_capacity);
+
+    std::thread parser([&]() {
+        parse_stage(item_batches, stats);
+        item_batches.close();
+    });
+
+    // Stage 3: render pack batches
+    std::thread writer([&]() {
+        pack_formatter formatter(output);
+        std::vector<pack> batch;
+        while (pack_batches.pop(batch)) {
+            timer batch_timer;
+            batch_timer.start();
+            for (const auto& p : batch) {
+                formatter.write_pack(p);
+            }
+            stats.write_time += batch_timer.stop();
+        }
+        timer flush_timer;
+        flush_timer.start();
+        formatter.flush();
+        stats.write_time += flush_timer.stop();
+    });
+
+    // Stage 2 (calling thread): next-fit packing
+    std::vector<pack> sealed;
+    sealed.reserve(m_pack_batch);
+    streaming_packer packer(config.max_items_per_pack, config.max_weight_per_pack,
+                            [&](const pack& p) {
+                                sealed.push_back(p);
+                                if (sealed.size() >= m_pack_batch) {
+                                    pack_batches.push(std::move(sealed));
+                                    sealed = std::vector<pack>();
+                                    sealed.reserve(m_pack_batch);
+                                }
+                            });
+
+    std::vector<item> batch;
+    while (item_batches.pop(batch)) {
+        timer batch_timer;
+        batch_timer.start();
+        stats.items += batch.size();
+        for (const auto& i : batch) {
+            packer.add_item(i);
+        }
+        stats.pack_time += batch_timer.stop();
+    }
+    packer.finish();
+    if (!sealed.empty()) {
+        pack_batches.push(std::move(sealed));
+    }
+    pack_batches.close();
+
+    parser.join();
+    writer.join();
+
+    stats.packs = packer.get_emitted_packs();
+    stats.pieces = packer.get_total_items();
+    stats.unplaced_pieces = packer.get_unplaced_items();
+    stats.total_time = total_timer.stop();
+    return stats;
+}
+
+bool pipeline_planner::run_file(const std::string& input_path, const pack_planner_config& config,
+                                std::ostream& output, pipeline_stats& stats) {
+    mapped_file file;
+    if (file.open_read(input_path)) {
+        file.advise_sequential();
+        stats = run(file.data(), file.size(), config, output);
+        return true;
+    }
+
+    // Not mappable (pipe, character device): read it into memory instead
+    std::ifstream in(input_path, std::ios::binary);
+    if (!in.is_open()) {
+        return false;
+    }
+    std::string buffer((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    stats = run(buffer.data(), buffer.size(), config, output);
+    return true;
+}
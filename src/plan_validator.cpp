@@ -0,0 +1,479 @@
+#include "plan_validator.h"
+#include "csv_ingest.h"
+#include "mapped_file.h"
+#include "timer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string_view>
+#include <thread>
+
+namespace {
+
+constexpr std::string_view PACK_HEADER = "Pack Number: ";
+constexpr std::string_view PACK_FOOTER = "Pack Length: ";
+constexpr std::string_view FOOTER_WEIGHT = ", Pack Weight: ";
+
+// Text output rounds item weights to 3 and pack weights to 2 decimals
+constexpr double ITEM_WEIGHT_TOLERANCE = 0.0005;
+constexpr double PACK_WEIGHT_TOLERANCE = 0.005;
+
+// Below this many packs or items per thread the work stays on fewer threads
+constexpr size_t MIN_RECORDS_PER_TASK = 1 << 16;
+
+bool starts_with(const char* first, const char* last, std::string_view prefix) noexcept {
+    return static_cast<size_t>(last - first) >= prefix.size() &&
+           std::memcmp(first, prefix.data(), prefix.size()) == 0;
+}
+
+bool near(double a, double b, double tolerance) noexcept {
+    return std::fabs(a - b) <= tolerance + 1e-9 * std::max(std::fabs(a), std::fabs(b));
+}
+
+const char* kind_name(violation_kind kind) noexcept {
+    switch (kind) {
+    case violation_kind::TOO_MANY_ITEMS: return "too many items";
+    case violation_kind::TOO_HEAVY: return "too heavy";
+    case violation_kind::COUNT_MISMATCH: return "pack item count mismatch";
+    case violation_kind::LENGTH_MISMATCH: return "pack length mismatch";
+    case violation_kind::WEIGHT_MISMATCH: return "pack weight mismatch";
+    case violation_kind::UNKNOWN_ITEM: return "unknown item";
+    case violation_kind::ITEM_MISMATCH: return "item differs from input";
+    case violation_kind::MISSING_PIECES: return "missing pieces";
+    case violation_kind::EXTRA_PIECES: return "extra pieces";
+    case violation_kind::MALFORMED: return "malformed plan";
+    }
+    return "unknown";
+}
+
+}  // namespace
+
+std::string plan_violation::to_string() const {
+    std::ostringstream out;
+    if (pack_number >= 0) out << "pack " << pack_number << ": ";
+    out << kind_name(kind);
+    if (item_id >= 0) out << " (item " << item_id << ")";
+    if (kind == violation_kind::MALFORMED) {
+        out << " at byte " << offset;
+    } else if (kind != violation_kind::UNKNOWN_ITEM) {
+        out << ": expected " << expected << ", got " << actual;
+    }
+    return out.str();
+}
+
+struct plan_validator::range_result {
+    size_t packs = 0;
+    size_t placements = 0;
+    long long pieces = 0;
+    size_t violation_count = 0;
+    std::vector<plan_violation> violations;
+};
+
+plan_validator::plan_validator(int max_items, double max_weight, unsigned int thread_count,
+                               size_t max_reported) noexcept
+    : m_max_items(std::max(1, max_items)),
+      m_max_weight(std::max(0.1, max_weight)),
+      m_thread_count(thread_count),
+      m_max_reported(max_reported) {
+    if (m_thread_count == 0) {
+        m_thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+}
+
+template <typename Fn>
+void plan_validator::run_tasks(size_t task_count, Fn&& fn) {
+    if (task_count == 0) return;
+    std::vector<std::thread> threads;
+    threads.reserve(task_count - 1);
+    for (size_t t = 1; t < task_count; ++t) {
+        threads.emplace_back([&fn, t] { fn(t); });
+    }
+    fn(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+template <typename Row>
+void plan_validator::build_index(size_t count, Row&& row) {
+    m_ids.clear();
+    m_lengths.clear();
+    m_weights.clear();
+    m_expected.clear();
+    m_ambiguous.clear();
+    m_dense_slots.clear();
+    m_sparse.clear();
+
+    int64_t min_id = 0;
+    int64_t max_id = -1;
+    for (size_t i = 0; i < count; ++i) {
+        const int64_t id = row(i).get_id();
+        if (i == 0 || id < min_id) min_id = id;
+        if (i == 0 || id > max_id) max_id = id;
+    }
+    m_min_id = min_id;
+
+    // Dense ids (the common case) index a flat table; sparse ones are binary searched
+    const bool dense = count > 0 && static_cast<uint64_t>(max_id - min_id) <= 4 * count + 1024;
+    if (dense) {
+        m_dense_slots.assign(static_cast<size_t>(max_id - min_id) + 1, -1);
+    }
+
+    auto add_row = [&](const item& it, int32_t& slot) {
+        if (slot < 0) {
+            slot = static_cast<int32_t>(m_ids.size());
+            m_ids.push_back(it.get_id());
+            m_lengths.push_back(it.get_length());
+            m_weights.push_back(it.get_weight());
+            m_expected.push_back(0);
+            m_ambiguous.push_back(0);
+        } else if (m_lengths[slot] != it.get_length() || m_weights[slot] != it.get_weight()) {
+            m_ambiguous[slot] = 1;
+        }
+        if (it.get_quantity() > 0 && it.get_weight() <= m_max_weight) {
+            m_expected[slot] += it.get_quantity();
+        }
+    };
+
+    if (dense) {
+        for (size_t i = 0; i < count; ++i) {
+            const item it = row(i);
+            add_row(it, m_dense_slots[static_cast<size_t>(it.get_id() - min_id)]);
+        }
+    } else {
+        // Sort row numbers by id so duplicates are adjacent and slots follow id order
+        std::vector<std::pair<int64_t, uint32_t>> order(count);
+        for (size_t i = 0; i < count; ++i) {
+            order[i] = {row(i).get_id(), static_cast<uint32_t>(i)};
+        }
+        std::sort(order.begin(), order.end());
+        int32_t slot = -1;
+        for (size_t k = 0; k < order.size(); ++k) {
+            if (k > 0 && order[k].first != order[k - 1].first) slot = -1;
+            const bool fresh = slot < 0;
+            add_row(row(order[k].second), slot);
+            if (fresh) m_sparse.emplace_back(order[k].first, slot);
+        }
+    }
+
+    m_placed.assign(m_ids.size(), 0);
+}
+
+void plan_validator::set_items(const std::vector<item>& items) {
+    build_index(items.size(), [&items](size_t i) -> const item& { return items[i]; });
+}
+
+void plan_validator::set_items(const item_column_view& columns) {
+    build_index(columns.size(), [&columns](size_t i) { return columns.at(i); });
+}
+
+int64_t plan_validator::find_slot(int64_t id) const noexcept {
+    if (!m_dense_slots.empty()) {
+        const int64_t index = id - m_min_id;
+        if (index < 0 || index >= static_cast<int64_t>(m_dense_slots.size())) return -1;
+        return m_dense_slots[static_cast<size_t>(index)];
+    }
+    auto it = std::lower_bound(m_sparse.begin(), m_sparse.end(), id,
+                               [](const auto& entry, int64_t value) { return entry.first < value; });
+    return it != m_sparse.end() && it->first == id ? it->second : -1;
+}
+
+void plan_validator::record(range_result& out, const plan_violation& violation) const {
+    ++out.violation_count;
+    if (out.violations.size() < m_max_reported) {
+        out.violations.push_back(violation);
+    }
+}
+
+void plan_validator::check_pack(int64_t pack_number, long long pieces, double weight,
+                                range_result& out) const {
+    if (pieces > m_max_items) {
+        record(out, {violation_kind::TOO_MANY_ITEMS, pack_number, -1,
+                     static_cast<double>(m_max_items), static_cast<double>(pieces)});
+    }
+    if (weight > m_max_weight + 1e-9 * std::max(1.0, m_max_weight)) {
+        record(out, {violation_kind::TOO_HEAVY, pack_number, -1, m_max_weight, weight});
+    }
+}
+
+std::vector<size_t> plan_validator::split_packs(const char* data, size_t size, size_t range_count) {
+    std::vector<size_t> bounds;
+    bounds.push_back(0);
+    range_count = std::max<size_t>(1, range_count);
+
+    const std::string_view text(data, size);
+    const std::string needle = "\n" + std::string(PACK_HEADER);
+    const size_t target = size / range_count;
+    for (size_t c = 1; c < range_count; ++c) {
+        const size_t from = std::max(bounds.back() + 1, c * target);
+        if (from >= size) break;
+        // Cut just after the newline that precedes the next pack header
+        const size_t found = text.find(needle, from - 1);
+        if (found == std::string_view::npos) break;
+        bounds.push_back(found + 1);
+    }
+    bounds.push_back(size);
+    return bounds;
+}
+
+void plan_validator::check_text_range(const char* first, const char* last, range_result& out) {
+    const char* const base = first;
+    int64_t pack_number = -1;
+    bool in_pack = false;
+    long long pieces = 0;
+    double weight = 0.0;
+    int max_length = 0;
+
+    auto malformed = [&](const char* line) {
+        plan_violation v;
+        v.kind = violation_kind::MALFORMED;
+        v.pack_number = in_pack ? pack_number : -1;
+        v.offset = static_cast<size_t>(line - base);
+        record(out, v);
+    };
+
+    while (first < last) {
+        const char* eol = static_cast<const char*>(std::memchr(first, '\n', last - first));
+        if (eol == nullptr) eol = last;
+        const char* line = first;
+        const char* line_end = (eol > line && eol[-1] == '\r') ? eol - 1 : eol;
+        first = eol + 1;
+
+        if (line == line_end) continue;
+
+        if (starts_with(line, line_end, PACK_HEADER)) {
+            if (in_pack) {
+                malformed(line);  // previous pack has no footer
+                check_pack(pack_number, pieces, weight, out);
+            }
+            const char* number = line + PACK_HEADER.size();
+            auto [ptr, ec] = std::from_chars(number, line_end, pack_number);
+            in_pack = true;
+            pieces = 0;
+            weight = 0.0;
+            max_length = 0;
+            ++out.packs;
+            if (ec != std::errc() || ptr != line_end) {
+                pack_number = -1;
+                malformed(line);
+            }
+            continue;
+        }
+
+        if (starts_with(line, line_end, PACK_FOOTER)) {
+            int reported_length = 0;
+            double reported_weight = 0.0;
+            const char* p = line + PACK_FOOTER.size();
+            auto [length_end, length_ec] = std::from_chars(p, line_end, reported_length);
+            const bool parsed = length_ec == std::errc() && starts_with(length_end, line_end, FOOTER_WEIGHT) &&
+                                std::from_chars(length_end + FOOTER_WEIGHT.size(), line_end,
+                                                reported_weight).ec == std::errc();
+            if (!in_pack || !parsed) {
+                malformed(line);
+            } else {
+                if (reported_length != max_length) {
+                    record(out, {violation_kind::LENGTH_MISMATCH, pack_number, -1,
+                                 static_cast<double>(max_length), static_cast<double>(reported_length)});
+                }
+                if (!near(reported_weight, weight, PACK_WEIGHT_TOLERANCE)) {
+                    record(out, {violation_kind::WEIGHT_MISMATCH, pack_number, -1, weight, reported_weight});
+                }
+                check_pack(pack_number, pieces, weight, out);
+            }
+            in_pack = false;
+            continue;
+        }
+
+        int id, length;
+        std::int64_t quantity;
+        double line_weight;
+        if (!in_pack || !csv_ingest::parse_line(line, line_end, id, length, quantity, line_weight) ||
+            quantity <= 0) {
+            malformed(line);
+            continue;
+        }
+
+        ++out.placements;
+        out.pieces += quantity;
+        pieces += quantity;
+
+        const int64_t slot = find_slot(id);
+        if (slot < 0) {
+            record(out, {violation_kind::UNKNOWN_ITEM, pack_number, id, 0.0, 0.0});
+        } else {
+            std::atomic_ref<long long>(m_placed[slot]).fetch_add(quantity, std::memory_order_relaxed);
+            if (!m_ambiguous[slot]) {
+                if (length != m_lengths[slot]) {
+                    record(out, {violation_kind::ITEM_MISMATCH, pack_number, id,
+                                 static_cast<double>(m_lengths[slot]), static_cast<double>(length)});
+                } else if (!near(line_weight, m_weights[slot], ITEM_WEIGHT_TOLERANCE)) {
+                    record(out, {violation_kind::ITEM_MISMATCH, pack_number, id, m_weights[slot], line_weight});
+                }
+                // Totals use the exact input values, not the rounded text
+                length = m_lengths[slot];
+                line_weight = m_weights[slot];
+            }
+        }
+        weight += quantity * line_weight;
+        max_length = std::max(max_length, length);
+    }
+
+    if (in_pack) {
+        malformed(last);
+        check_pack(pack_number, pieces, weight, out);
+    }
+}
+
+validation_report plan_validator::merge(std::vector<range_result>& ranges) {
+    // Item-level accounting: every expected piece placed exactly once
+    const size_t slot_count = m_ids.size();
+    const size_t tasks = std::clamp<size_t>(slot_count / MIN_RECORDS_PER_TASK, 1, m_thread_count);
+    std::vector<range_result> sweeps(tasks);
+    run_tasks(tasks, [&](size_t t) {
+        const size_t begin = slot_count * t / tasks;
+        const size_t end = slot_count * (t + 1) / tasks;
+        for (size_t s = begin; s < end; ++s) {
+            if (m_placed[s] == m_expected[s]) continue;
+            record(sweeps[t], {m_placed[s] < m_expected[s] ? violation_kind::MISSING_PIECES :
+                                                              violation_kind::EXTRA_PIECES,
+                               -1, m_ids[s], static_cast<double>(m_expected[s]),
+                               static_cast<double>(m_placed[s])});
+        }
+    });
+
+    validation_report report;
+    for (auto* group : {&ranges, &sweeps}) {
+        for (auto& r : *group) {
+            report.packs += r.packs;
+            report.placements += r.placements;
+            report.pieces += r.pieces;
+            report.violation_count += r.violation_count;
+            report.violations.insert(report.violations.end(),
+                                     std::make_move_iterator(r.violations.begin()),
+                                     std::make_move_iterator(r.violations.end()));
+        }
+    }
+
+    // Pack findings in pack order first, item accounting last
+    std::stable_sort(report.violations.begin(), report.violations.end(),
+                     [](const plan_violation& a, const plan_violation& b) {
+                         const bool a_item = a.pack_number < 0;
+                         const bool b_item = b.pack_number < 0;
+                         if (a_item != b_item) return b_item;
+                         return a.pack_number < b.pack_number;
+                     });
+    if (report.violations.size() > m_max_reported) {
+        report.violations.resize(m_max_reported);
+    }
+    return report;
+}
+
+validation_report plan_validator::validate_text(const char* data, size_t size) {
+    timer validate_timer;
+    validate_timer.start();
+    std::fill(m_placed.begin(), m_placed.end(), 0);
+
+    const size_t tasks = std::clamp<size_t>(size / (MIN_RECORDS_PER_TASK * 32), 1, m_thread_count);
+    const std::vector<size_t> bounds = split_packs(data, size, tasks);
+    std::vector<range_result> ranges(bounds.size() - 1);
+
+    run_tasks(ranges.size(), [&](size_t t) {
+        check_text_range(data + bounds[t], data + bounds[t + 1], ranges[t]);
+        // Offsets are relative to the range; make them file offsets
+        for (auto& v : ranges[t].violations) {
+            v.offset += bounds[t];
+        }
+    });
+
+    validation_report report = merge(ranges);
+    report.total_time = validate_timer.stop();
+    return report;
+}
+
+validation_report plan_validator::validate_binary(const binary_plan_file& plan) {
+    timer validate_timer;
+    validate_timer.start();
+    std::fill(m_placed.begin(), m_placed.end(), 0);
+
+    const auto packs = plan.packs();
+    const size_t tasks = std::clamp<size_t>(packs.size() / MIN_RECORDS_PER_TASK, 1, m_thread_count);
+    std::vector<range_result> ranges(tasks);
+
+    run_tasks(tasks, [&](size_t t) {
+        range_result& out = ranges[t];
+        const size_t begin = packs.size() * t / tasks;
+        const size_t end = packs.size() * (t + 1) / tasks;
+        for (size_t p = begin; p < end; ++p) {
+            const plan_pack_record& entry = packs[p];
+            long long pieces = 0;
+            double weight = 0.0;
+            int max_length = 0;
+
+            for (const auto& placement : plan.placements_of(p)) {
+                ++out.placements;
+                pieces += placement.quantity;
+                const int64_t slot = find_slot(placement.item_id);
+                if (slot < 0 || placement.quantity <= 0) {
+                    record(out, {slot < 0 ? violation_kind::UNKNOWN_ITEM : violation_kind::MALFORMED,
+                                 entry.pack_number, placement.item_id});
+                    continue;
+                }
+                std::atomic_ref<long long>(m_placed[slot]).fetch_add(placement.quantity,
+                                                                     std::memory_order_relaxed);
+                weight += placement.quantity * m_weights[slot];
+                max_length = std::max(max_length, m_lengths[slot]);
+            }
+
+            ++out.packs;
+            out.pieces += pieces;
+            if (entry.total_items != pieces) {
+                record(out, {violation_kind::COUNT_MISMATCH, entry.pack_number, -1,
+                             static_cast<double>(pieces), static_cast<double>(entry.total_items)});
+            }
+            if (entry.max_length != max_length) {
+                record(out, {violation_kind::LENGTH_MISMATCH, entry.pack_number, -1,
+                             static_cast<double>(max_length), static_cast<double>(entry.max_length)});
+            }
+            // Binary totals are exact; only summation order may differ
+            if (!near(entry.total_weight, weight, 1e-6)) {
+                record(out, {violation_kind::WEIGHT_MISMATCH, entry.pack_number, -1, weight,
+                             entry.total_weight});
+            }
+            check_pack(entry.pack_number, pieces, weight, out);
+        }
+    });
+
+    validation_report report = merge(ranges);
+    report.total_time = validate_timer.stop();
+    return report;
+}
+
+bool plan_validator::validate_file(const std::string& path, validation_report& report) {
+    mapped_file file;
+    if (file.open_read(path)) {
+        if (file.size() >= sizeof(binary_plan_file::MAGIC) &&
+            std::memcmp(file.data(), binary_plan_file::MAGIC, sizeof(binary_plan_file::MAGIC)) == 0) {
+            file.close();
+            binary_plan_file plan;
+            if (!plan.open(path)) return false;
+            report = validate_binary(plan);
+            return true;
+        }
+        file.advise_sequential();
+        report = validate_text(file.data(), file.size());
+        return true;
+    }
+
+    // Empty files and pipes cannot be mapped
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) return false;
+    const std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    report = validate_text(text.data(), text.size());
+    return true;
+}
@@ -0,0 +1,93 @@
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <CLI/CLI.hpp>
+
+#include "binary_item_file.h"
+#include "csv_ingest.h"
+#include "pack_planner.h"
+#include "plan_validator.h"
+#include "timer.h"
+
+int main(int argc, char* argv[]) {
+    CLI::App app{"Pack Plan Validator"};
+
+    std::string input_file;
+    std::string plan_file;
+    int max_items_per_pack = 0;
+    double max_weight_per_pack = 0.0;
+    int thread_count = 0;
+    size_t max_reported = plan_validator::DEFAULT_MAX_REPORTED;
+
+    app.add_option("-i,--input", input_file, "Input items (CSV or binary item file)")->required();
+    app.add_option("-p,--plan", plan_file, "Plan to check (text output or binary plan file)")->required();
+    app.add_option("-m,--max-items", max_items_per_pack,
+                   "Maximum items per pack (default: CSV header, else 100)");
+    app.add_option("-w,--max-weight", max_weight_per_pack,
+                   "Maximum weight per pack (default: CSV header, else 200)");
+    app.add_option("-t,--threads", thread_count, "Number of threads (0 = all cores)");
+    app.add_option("--max-violations", max_reported, "Violations to list (all are counted)");
+
+    CLI11_PARSE(app, argc, argv);
+
+    // Limits not given on the command line come from the spec header line
+    pack_planner_config limits;
+    if (!binary_item_file::is_binary_item_file(input_file)) {
+        std::ifstream header_stream(input_file);
+        std::string header;
+        if (std::getline(header_stream, header) && !parse_config_header(header, limits)) {
+            limits = pack_planner_config{};
+        }
+    }
+    if (max_items_per_pack > 0) limits.max_items_per_pack = max_items_per_pack;
+    if (max_weight_per_pack > 0.0) limits.max_weight_per_pack = max_weight_per_pack;
+
+    const unsigned int threads = static_cast<unsigned int>(std::max(0, thread_count));
+    plan_validator validator(limits.max_items_per_pack, limits.max_weight_per_pack, threads,
+                             max_reported);
+
+    timer load_timer;
+    load_timer.start();
+    binary_item_file binary_input;
+    if (binary_item_file::is_binary_item_file(input_file)) {
+        if (!binary_input.open(input_file)) {
+            std::cerr << "Invalid or corrupt binary item file: " << input_file << std::endl;
+            return 1;
+        }
+        validator.set_items(binary_input.columns());
+    } else {
+        std::vector<item> items;
+        csv_ingest ingest(threads);
+        if (!ingest.load(input_file, items)) {
+            std::cerr << "Cannot read input file: " << input_file << std::endl;
+            return 1;
+        }
+        validator.set_items(items);
+    }
+    const double load_time = load_timer.stop();
+
+    validation_report report;
+    if (!validator.validate_file(plan_file, report)) {
+        std::cerr << "Cannot read plan file: " << plan_file << std::endl;
+        return 1;
+    }
+
+    for (const auto& violation : report.violations) {
+        std::cout << violation.to_string() << '\n';
+    }
+    if (report.violation_count > report.violations.size()) {
+        std::cout << "... " << (report.violation_count - report.violations.size())
+                  << " more violations" << '\n';
+    }
+
+    std::cout << (report.ok() ? "VALID" : "INVALID") << ": " << report.packs << " packs, "
+              << report.placements << " placements, " << report.pieces << " pieces, "
+              << report.violation_count << " violations (max items " << limits.max_items_per_pack
+              << ", max weight " << limits.max_weight_per_pack << ")" << std::endl;
+    std::cerr << std::fixed << std::setprecision(3) << "Load " << load_time << " ms, validate "
+              << report.total_time << " ms" << std::endl;
+
+    return report.ok() ? 0 : 2;
+}
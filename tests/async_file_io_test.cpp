@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "async_file_io.h"
+
+// Async File I/O Tests
+class AsyncFileIoTest : public ::testing::TestWithParam<io_backend> {
+protected:
+    void TearDown() override {
+        std::remove(path.c_str());
+    }
+
+    static std::string generate_bytes(size_t size) {
+        std::string data(size, '\0');
+        for (size_t i = 0; i < size; ++i) {
+            data[i] = static_cast<char>('a' + (i * 7 + i / 4096) % 26);
+        }
+        return data;
+    }
+
+    std::string read_file() const {
+        std::ifstream in(path, std::ios::binary);
+        return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    }
+
+    std::string path = ::testing::TempDir() + "async_file_io_test.bin";
+};
+
+TEST_P(AsyncFileIoTest, WriterMatchesInput) {
+    const std::string data = generate_bytes(5 * 65536 + 123);  // partial last block
+
+    async_file_writer writer;
+    ASSERT_TRUE(writer.open(path, 4, 65536, GetParam()));
+    // Uneven chunk sizes cross block boundaries
+    for (size_t pos = 0; pos < data.size(); pos += 10007) {
+        ASSERT_TRUE(writer.write(data.data() + pos, std::min<size_t>(10007, data.size() - pos)));
+    }
+    ASSERT_TRUE(writer.close());
+
+    EXPECT_EQ(read_file(), data);
+}
+
+TEST_P(AsyncFileIoTest, ReaderDeliversBlocksInOrder) {
+    const std::string data = generate_bytes(9 * 4096 + 17);
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << data;
+    }
+
+    async_file_reader reader;
+    ASSERT_TRUE(reader.open(path, 3, 4096, GetParam()));
+    std::string text;
+    std::string block;
+    while (reader.next_block(block)) {
+        text += block;
+    }
+    EXPECT_TRUE(reader.ok());
+    EXPECT_EQ(text, data);
+}
+
+TEST_P(AsyncFileIoTest, ReaderCloseWithReadsInFlight) {
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << generate_bytes(64 * 4096);
+    }
+
+    async_file_reader reader;
+    ASSERT_TRUE(reader.open(path, 16, 4096, GetParam()));
+    std::string block;
+    ASSERT_TRUE(reader.next_block(block));
+    reader.close();
+    EXPECT_FALSE(reader.next_block(block));
+}
+
+TEST_P(AsyncFileIoTest, StreamAdapter) {
+    {
+        async_ofstream out(path, 2, GetParam());
+        out << "Pack Number: " << 1 << '\n';
+        out.close();
+        EXPECT_TRUE(out);
+    }
+    EXPECT_EQ(read_file(), "Pack Number: 1\n");
+}
+
+TEST_P(AsyncFileIoTest, StreamAdapterReportsWriteFailures) {
+    // Every write to /dev/full fails with ENOSPC; the error surfaces from close()
+    async_ofstream out("/dev/full", 2, GetParam());
+    ASSERT_TRUE(out);
+    out << generate_bytes(3 * 65536);
+    out.close();
+    EXPECT_FALSE(out);
+}
+
+TEST_P(AsyncFileIoTest, MissingFilesFail) {
+    async_file_reader reader;
+    EXPECT_FALSE(reader.open("/nonexistent/input.csv", 4, 4096, GetParam()));
+    async_file_writer writer;
+    EXPECT_FALSE(writer.open("/nonexistent/dir/output.txt", 4, 4096, GetParam()));
+}
+
+// IO_URING silently degrades to BLOCKING where io_uring is unavailable
+INSTANTIATE_TEST_SUITE_P(Backends, AsyncFileIoTest,
+                         ::testing::Values(io_backend::BLOCKING, io_backend::IO_URING));
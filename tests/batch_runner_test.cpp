@@ -0,0 +1,203 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "batch_runner.h"
+#include "binary_item_file.h"
+#include "csv_ingest.h"
+#include "pack_planner.h"
+
+namespace fs = std::filesystem;
+
+// Batch Runner Tests
+class BatchRunnerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        root = fs::path(::testing::TempDir()) / "batch_runner_test";
+        fs::remove_all(root);
+        fs::create_directories(root / "in");
+    }
+
+    void TearDown() override {
+        fs::remove_all(root);
+    }
+
+    static std::string generate_lines(int count, int seed) {
+        std::string text = "NATURAL,40,500.0\n";
+        for (int i = 0; i < count; ++i) {
+            text += std::to_string(seed + i) + "," + std::to_string(500 + i % 9500) + "," +
+                    std::to_string(1 + (i + seed) % 70) + "," + std::to_string(0.5 + (i % 300) / 10.0) + "\n";
+        }
+        return text;
+    }
+
+    std::string write_input(const std::string& name, const std::string& text) {
+        const std::string path = (root / "in" / name).string();
+        std::ofstream(path, std::ios::binary) << text;
+        return path;
+    }
+
+    static std::string read_file(const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    }
+
+    static std::string reference_output(const std::string& text, const pack_planner_config& config) {
+        std::vector<item> items;
+        csv_ingest::parse_range(text.data(), text.data() + text.size(), items);
+        pack_planner planner;
+        auto result = planner.plan_packs(config, std::move(items));
+        std::ostringstream output;
+        planner.output_results(result.packs, output);
+        return output.str();
+    }
+
+    fs::path root;
+};
+
+TEST_F(BatchRunnerTest, ScheduleStartsLargestFirst) {
+    std::vector<batch_job> jobs(5);
+    const size_t sizes[] = {10, 500, 10, 2000, 7};
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        jobs[i].input_bytes = sizes[i];
+    }
+
+    const auto order = batch_runner::schedule(jobs);
+    EXPECT_EQ(order, (std::vector<size_t>{3, 1, 0, 2, 4}));  // equal sizes keep list order
+}
+
+TEST_F(BatchRunnerTest, CollectFromDirectorySkipsHiddenFiles) {
+    write_input("b.csv", "1,2,3,4.0\n");
+    write_input("a.csv", "1,2,3,4.0\n1,2,3,4.0\n");
+    write_input(".hidden", "1,2,3,4.0\n");
+
+    std::vector<batch_job> jobs;
+    ASSERT_TRUE(batch_runner::collect_jobs((root / "in").string(), (root / "out").string(), jobs));
+    ASSERT_EQ(jobs.size(), 2);
+    EXPECT_EQ(fs::path(jobs[0].input_path).filename(), "a.csv");
+    EXPECT_EQ(jobs[0].output_path, (root / "out" / "a.csv.txt").string());
+    EXPECT_EQ(jobs[0].input_bytes, 20);
+    EXPECT_TRUE(fs::is_directory(root / "out"));
+}
+
+TEST_F(BatchRunnerTest, CollectFromListDeduplicatesOutputNames) {
+    const std::string first = write_input("orders.csv", "1,2,3,4.0\n");
+    fs::create_directories(root / "in" / "sub");
+    const std::string second = write_input("sub/orders.csv", "1,2,3,4.0\n");
+
+    const std::string list = (root / "jobs.txt").string();
+    std::ofstream(list) << "# nightly\n" << first << "\n\n" << second << "\r\n";
+
+    std::vector<batch_job> jobs;
+    ASSERT_TRUE(batch_runner::collect_jobs(list, (root / "out").string(), jobs));
+    ASSERT_EQ(jobs.size(), 2);
+    EXPECT_EQ(jobs[1].input_path, second);
+    EXPECT_NE(jobs[0].output_path, jobs[1].output_path);
+
+    EXPECT_FALSE(batch_runner::collect_jobs((root / "missing.txt").string(),
+                                            (root / "out").string(), jobs));
+}
+
+TEST_F(BatchRunnerTest, RunMatchesSingleFilePlanning) {
+    pack_planner_config config;
+    config.max_items_per_pack = 40;
+    config.max_weight_per_pack = 500.0;
+
+    std::vector<std::string> texts;
+    for (int i = 0; i < 6; ++i) {
+        texts.push_back(generate_lines(200 + i * 700, 1000 * i));
+        write_input("job" + std::to_string(i) + ".csv", texts.back());
+    }
+
+    std::vector<batch_job> jobs;
+    ASSERT_TRUE(batch_runner::collect_jobs((root / "in").string(), (root / "out").string(), jobs));
+    ASSERT_EQ(jobs.size(), texts.size());
+
+    batch_runner runner(3);
+    const auto results = runner.run(jobs, config);
+    EXPECT_EQ(runner.get_workers_used(), 3);
+    ASSERT_EQ(results.size(), jobs.size());
+
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        ASSERT_TRUE(results[i].ok) << results[i].error;
+        EXPECT_EQ(results[i].items, static_cast<size_t>(200 + i * 700));
+        EXPECT_EQ(read_file(jobs[i].output_path), reference_output(texts[i], config)) << i;
+    }
+
+    const batch_summary summary = runner.summarize(jobs, results);
+    EXPECT_EQ(summary.jobs, jobs.size());
+    EXPECT_EQ(summary.failed, 0);
+    EXPECT_LE(summary.run_time_p50, summary.run_time_p95);
+    EXPECT_LE(summary.run_time_p95, summary.run_time_max);
+    EXPECT_LE(summary.latency_max, runner.get_total_time() + 1.0);
+}
+
+TEST_F(BatchRunnerTest, UnplacedPiecesAreReported) {
+    pack_planner_config config;
+    config.max_items_per_pack = 40;
+    config.max_weight_per_pack = 20.0;
+    write_input("heavy.csv", "NATURAL,40,20.0\n1,100,3,5.0\n2,100,4,50.0\n");
+
+    std::vector<batch_job> jobs;
+    ASSERT_TRUE(batch_runner::collect_jobs((root / "in").string(), (root / "out").string(), jobs));
+    batch_runner runner(1);
+    const auto results = runner.run(jobs, config);
+    ASSERT_EQ(results.size(), 1);
+
+    // The plan is written, but the job says what it left out
+    EXPECT_TRUE(results[0].ok);
+    EXPECT_EQ(results[0].unplaced_items, 4);
+    EXPECT_NE(results[0].error.find("4 pieces were not packed"), std::string::npos);
+    EXPECT_EQ(runner.summarize(jobs, results).unplaced_items, 4);
+
+    std::ostringstream summary;
+    runner.print_summary(jobs, results, summary);
+    EXPECT_NE(summary.str().find("UNPLACED"), std::string::npos);
+
+    std::ostringstream report;
+    batch_runner::write_report(jobs, results, report);
+    EXPECT_NE(report.str().find(",2,1,4,0,"), std::string::npos);  // items, packs, unplaced, worker
+}
+
+TEST_F(BatchRunnerTest, FailedJobsAreReportedNotFatal) {
+    pack_planner_config config;
+    write_input("good.csv", generate_lines(100, 1));
+    write_input("empty.csv", "NATURAL,40,500.0\n");
+
+    std::vector<item> items = {item(1, 100, 5, 2.0), item(2, 200, 7, 3.0)};
+    ASSERT_TRUE(binary_item_file::write((root / "in" / "columns.bin").string(), items));
+
+    std::vector<batch_job> jobs;
+    ASSERT_TRUE(batch_runner::collect_jobs((root / "in").string(), (root / "out").string(), jobs));
+    jobs.push_back({(root / "in" / "missing.csv").string(), (root / "out" / "missing.txt").string(), 0});
+
+    batch_runner runner(2);
+    const auto results = runner.run(jobs, config);
+    ASSERT_EQ(results.size(), 4);
+
+    // Directory order: columns.bin, empty.csv, good.csv
+    EXPECT_TRUE(results[0].ok);
+    EXPECT_EQ(results[0].items, 2);
+    EXPECT_FALSE(results[1].ok);
+    EXPECT_EQ(results[1].error, "no items");
+    EXPECT_TRUE(results[2].ok);
+    EXPECT_FALSE(results[3].ok);
+    EXPECT_EQ(results[3].error, "cannot read input");
+    EXPECT_EQ(runner.summarize(jobs, results).failed, 2);
+
+    std::ostringstream summary;
+    runner.print_summary(jobs, results, summary);
+    EXPECT_NE(summary.str().find("FAILED"), std::string::npos);
+
+    std::ostringstream report;
+    batch_runner::write_report(jobs, results, report);
+    std::string line;
+    size_t lines = 0;
+    std::istringstream rows(report.str());
+    while (std::getline(rows, line)) ++lines;
+    EXPECT_EQ(lines, jobs.size() + 1);
+}
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "binary_item_file.h"
+#include "pack_planner.h"
+#include "test_support.h"
+
+// Binary Item File Tests
+class BinaryItemFileTest : public ::testing::Test {
+protected:
+    // Every column varies from row to row, so a swapped or misaligned column shows up
+    std::vector<item> items = generate_test_items(5000, 60, 43.0);
+    temp_file output{"binary_item_file_test.ppi"};
+    const std::string& path = output.path();
+};
+
+TEST_F(BinaryItemFileTest, RoundTrip) {
+    items[7].set_quantity(3'000'000'000);  // needs the 64-bit quantity column
+    ASSERT_TRUE(binary_item_file::write(path, items));
+    ASSERT_TRUE(binary_item_file::is_binary_item_file(path));
+
+    binary_item_file file;
+    ASSERT_TRUE(file.open(path, true));
+    EXPECT_TRUE(file.has_checksum());
+    ASSERT_EQ(file.size(), items.size());
+
+    const item_column_view columns = file.columns();
+    for (size_t i = 0; i < items.size(); ++i) {
+        ASSERT_EQ(columns.ids[i], items[i].get_id());
+        ASSERT_EQ(columns.lengths[i], items[i].get_length());
+        ASSERT_EQ(columns.quantities[i], items[i].get_quantity());
+        ASSERT_EQ(columns.weights[i], items[i].get_weight());
+    }
+
+    // Columns start on 64-byte boundaries
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(columns.ids) % binary_item_file::COLUMN_ALIGNMENT, 0);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(columns.weights) % binary_item_file::COLUMN_ALIGNMENT, 0);
+}
+
+TEST_F(BinaryItemFileTest, EmptyFile) {
+    ASSERT_TRUE(binary_item_file::write(path, {}, false));
+
+    binary_item_file file;
+    ASSERT_TRUE(file.open(path, true));
+    EXPECT_FALSE(file.has_checksum());
+    EXPECT_TRUE(file.columns().empty());
+}
+
+TEST_F(BinaryItemFileTest, ChecksumDetectsCorruption) {
+    ASSERT_TRUE(binary_item_file::write(path, items));
+    {
+        std::fstream f(path, std::ios::in | std::ios::out | std::ios::binary);
+        f.seekp(200);
+        f.put('\x7f');
+    }
+
+    binary_item_file file;
+    EXPECT_TRUE(file.open(path, false));   // header still valid
+    EXPECT_FALSE(file.open(path, true));
+}
+
+TEST_F(BinaryItemFileTest, RejectsForeignAndTruncatedFiles) {
+    {
+        std::ofstream f(path, std::ios::binary);
+        f << "NATURAL,40,500.0\n1001,6200,30,9.653\n";
+    }
+    binary_item_file file;
+    EXPECT_FALSE(binary_item_file::is_binary_item_file(path));
+    EXPECT_FALSE(file.open(path));
+
+    ASSERT_TRUE(binary_item_file::write(path, items));
+    std::ifstream in(path, std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+    {
+        std::ofstream f(path, std::ios::binary | std::ios::trunc);
+        f.write(bytes.data(), static_cast<std::streamsize>(bytes.size() - 8));
+    }
+    EXPECT_FALSE(file.open(path));
+
+    binary_item_header header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    header.version = binary_item_file::VERSION + 1;
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    {
+        std::ofstream f(path, std::ios::binary | std::ios::trunc);
+        f.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+    EXPECT_FALSE(file.open(path));
+}
+
+TEST_F(BinaryItemFileTest, PlanFromColumnsMatchesVectorPath) {
+    ASSERT_TRUE(binary_item_file::write(path, items));
+    binary_item_file file;
+    ASSERT_TRUE(file.open(path));
+
+    pack_planner_config config;
+    config.max_items_per_pack = 1000;
+    config.max_weight_per_pack = 5000.0;
+
+    for (sort_order order : {sort_order::NATURAL, sort_order::SHORT_TO_LONG}) {
+        config.order = order;
+        pack_planner vector_planner;
+        pack_planner column_planner;
+        const auto expected = vector_planner.plan_packs(config, items);
+        const auto actual = column_planner.plan_packs(config, file.columns());
+
+        EXPECT_EQ(actual.total_items, expected.total_items);
+        EXPECT_EQ(actual.strategy_name, expected.strategy_name);
+        std::ostringstream expected_text;
+        std::ostringstream actual_text;
+        vector_planner.output_results(expected.packs, expected_text);
+        column_planner.output_results(actual.packs, actual_text);
+        EXPECT_EQ(actual_text.str(), expected_text.str());
+    }
+}
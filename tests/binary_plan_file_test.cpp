@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "binary_plan_file.h"
+#include "pack_planner.h"
+#include "test_support.h"
+
+// Binary Plan File Tests
+class BinaryPlanFileTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // Rows split across packs give packs with several placements each
+        items = generate_test_items(500, 45, 32.0);
+        config.max_items_per_pack = 40;
+        config.max_weight_per_pack = 500.0;
+    }
+
+    std::vector<item> items;
+    pack_planner_config config;
+    temp_file output{"binary_plan_file_test.ppp"};
+    const std::string& path = output.path();
+};
+
+TEST_F(BinaryPlanFileTest, RoundTripMatchesResult) {
+    pack_planner planner;
+    const auto result = planner.plan_packs(config, items);
+    ASSERT_TRUE(binary_plan_file::write(path, result));
+
+    binary_plan_file plan;
+    ASSERT_TRUE(plan.open(path));
+    ASSERT_EQ(plan.packs().size(), result.packs.size());
+    EXPECT_EQ(plan.get_total_items(), static_cast<uint64_t>(result.total_items));
+
+    size_t placements = 0;
+    for (size_t i = 0; i < result.packs.size(); ++i) {
+        const pack& expected = result.packs[i];
+        const plan_pack_record& record = plan.packs()[i];
+        EXPECT_EQ(record.pack_number, expected.get_pack_number());
+        EXPECT_EQ(record.total_items, expected.get_total_items());
+        EXPECT_EQ(record.total_weight, expected.get_total_weight());  // bit-exact
+        EXPECT_EQ(record.max_length, expected.get_pack_length());
+
+        const auto pack_placements = plan.placements_of(i);
+        ASSERT_EQ(pack_placements.size(), expected.get_items().size());
+        for (size_t j = 0; j < pack_placements.size(); ++j) {
+            EXPECT_EQ(pack_placements[j].item_id, expected.get_items()[j].get_id());
+            EXPECT_EQ(pack_placements[j].quantity, expected.get_items()[j].get_quantity());
+        }
+        placements += pack_placements.size();
+    }
+    EXPECT_EQ(plan.placements().size(), placements);
+}
+
+TEST_F(BinaryPlanFileTest, SkipsEmptyPacks) {
+    std::vector<pack> packs;
+    packs.emplace_back(1);
+    pack filled(2);
+    (void)filled.add_partial_item(7, 100, 3, 1.5, 10, 100.0);
+    packs.push_back(filled);
+
+    ASSERT_TRUE(binary_plan_file::write(path, packs));
+    binary_plan_file plan;
+    ASSERT_TRUE(plan.open(path));
+    ASSERT_EQ(plan.packs().size(), 1);
+    EXPECT_EQ(plan.packs()[0].pack_number, 2);
+    EXPECT_EQ(plan.placements_of(0)[0].quantity, 3);
+}
+
+TEST_F(BinaryPlanFileTest, RejectsForeignAndCorruptFiles) {
+    {
+        std::ofstream f(path, std::ios::binary);
+        f << "Pack Number: 1\n1001,6200,30,9.653\n";
+    }
+    binary_plan_file plan;
+    EXPECT_FALSE(plan.open(path));
+
+    pack_planner planner;
+    ASSERT_TRUE(binary_plan_file::write(path, planner.plan_packs(config, items)));
+    {
+        // Point the first pack's placement range past the table
+        std::fstream f(path, std::ios::in | std::ios::out | std::ios::binary);
+        f.seekp(64 + offsetof(plan_pack_record, first_placement));
+        const uint64_t bogus = 1ull << 40;
+        f.write(reinterpret_cast<const char*>(&bogus), sizeof(bogus));
+    }
+    EXPECT_FALSE(plan.open(path));
+}
@@ -0,0 +1,207 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "cpu_features.h"
+#include "csv_ingest.h"
+#include "csv_scanner.h"
+
+// CSV Ingest Tests
+class CsvIngestTest : public ::testing::Test {
+protected:
+    // Build a buffer large enough to be split across several chunks
+    std::string generate_lines(int count) {
+        std::string text = "NATURAL,100,200.0\n";
+        for (int i = 0; i < count; ++i) {
+            text += std::to_string(1000 + i) + "," + std::to_string(500 + i % 9500) + "," +
+                    std::to_string(1 + i % 100) + "," + std::to_string(0.5 + (i % 300) / 10.0) + "\n";
+        }
+        return text;
+    }
+};
+
+TEST_F(CsvIngestTest, ParseLine) {
+    const std::string line = "1001,6200,30,9.653";
+    int id, length;
+    std::int64_t quantity;
+    double weight;
+
+    ASSERT_TRUE(csv_ingest::parse_line(line.data(), line.data() + line.size(),
+                                       id, length, quantity, weight));
+    EXPECT_EQ(id, 1001);
+    EXPECT_EQ(length, 6200);
+    EXPECT_EQ(quantity, 30);
+    EXPECT_DOUBLE_EQ(weight, 9.653);
+}
+
+TEST_F(CsvIngestTest, ParseLineReadsQuantitiesPastInt) {
+    const std::string line = "1001,6200,9000000000,0.001";
+    int id, length;
+    std::int64_t quantity;
+    double weight;
+
+    ASSERT_TRUE(csv_ingest::parse_line(line.data(), line.data() + line.size(),
+                                       id, length, quantity, weight));
+    EXPECT_EQ(quantity, 9'000'000'000);
+
+    const std::string too_long = "1001,6200,99999999999999999999,0.001";
+    EXPECT_FALSE(csv_ingest::parse_line(too_long.data(), too_long.data() + too_long.size(),
+                                        id, length, quantity, weight));
+}
+
+TEST_F(CsvIngestTest, ParseLineRejectsMalformed) {
+    int id, length;
+    std::int64_t quantity;
+    double weight;
+
+    for (const std::string line : {"NATURAL,40,500.0", "1,2,3", "", "1;2;3;4.0", "a,2,3,4.0"}) {
+        EXPECT_FALSE(csv_ingest::parse_line(line.data(), line.data() + line.size(),
+                                            id, length, quantity, weight)) << line;
+    }
+}
+
+TEST_F(CsvIngestTest, ParseSkipsHeaderAndBlankLines) {
+    const std::string text = "NATURAL,40,500.0\n1001,6200,30,9.653\n\n2001, 7200, 50, 11.21\r\n";
+    std::vector<item> items;
+
+    csv_ingest ingest(1);
+    ingest.parse(text.data(), text.size(), items);
+
+    ASSERT_EQ(items.size(), 2);
+    EXPECT_EQ(items[0].get_id(), 1001);
+    EXPECT_EQ(items[1].get_id(), 2001);
+    EXPECT_EQ(items[1].get_length(), 7200);
+    EXPECT_DOUBLE_EQ(items[1].get_weight(), 11.21);
+}
+
+TEST_F(CsvIngestTest, SplitChunksAlignsToNewlines) {
+    const std::string text = generate_lines(1000);
+    auto bounds = csv_ingest::split_chunks(text.data(), text.size(), 7);
+
+    ASSERT_GE(bounds.size(), 2);
+    EXPECT_EQ(bounds.front(), 0);
+    EXPECT_EQ(bounds.back(), text.size());
+    for (size_t i = 1; i + 1 < bounds.size(); ++i) {
+        EXPECT_EQ(text[bounds[i] - 1], '\n');
+    }
+}
+
+TEST_F(CsvIngestTest, MultiChunkParseKeepsInputOrder) {
+    const int count = 200000;  // ~4MB, enough for several chunks
+    const std::string text = generate_lines(count);
+    std::vector<item> items;
+
+    csv_ingest ingest(4);
+    ingest.parse(text.data(), text.size(), items);
+
+    EXPECT_GT(ingest.get_chunk_stats().size(), 1);
+    ASSERT_EQ(items.size(), static_cast<size_t>(count));
+    for (int i = 0; i < count; ++i) {
+        ASSERT_EQ(items[i].get_id(), 1000 + i);
+    }
+
+    size_t lines = 0;
+    size_t parsed = 0;
+    for (const auto& stats : ingest.get_chunk_stats()) {
+        lines += stats.lines;
+        parsed += stats.items;
+    }
+    EXPECT_EQ(lines, static_cast<size_t>(count) + 1);  // header line is counted but skipped
+    EXPECT_EQ(parsed, static_cast<size_t>(count));
+}
+
+TEST_F(CsvIngestTest, LoadMissingFileFails) {
+    std::vector<item> items;
+    csv_ingest ingest;
+    EXPECT_FALSE(ingest.load("/nonexistent/items.csv", items));
+    EXPECT_TRUE(items.empty());
+}
+
+TEST_F(CsvIngestTest, ScannerFindsStructurals) {
+    const std::string text = "1001,6200,30,9.653\n2001,7200,50,11.21\n";
+    std::vector<uint32_t> index(text.size() + 32);
+
+    const size_t count = csv_scanner::find_structurals(text.data(), text.size(), index.data());
+    ASSERT_EQ(count, 8);
+    EXPECT_EQ(index[0], 4);
+    EXPECT_EQ(index[3], 18);
+    EXPECT_EQ(text[index[7]], '\n');
+
+    std::vector<uint32_t> scalar(text.size() + 32);
+    ASSERT_EQ(csv_scanner::find_structurals_scalar(text.data(), text.size(), scalar.data()), count);
+    for (size_t i = 0; i < count; ++i) {
+        EXPECT_EQ(index[i], scalar[i]);
+    }
+}
+
+TEST_F(CsvIngestTest, ScannerAvx2MatchesScalar) {
+    if (!cpu_has_avx2()) {
+        GTEST_SKIP() << "CPU has no AVX2";
+    }
+    std::string text = generate_lines(500);
+    text += "1,2,3\n\n,,,\n4,5,6,7.0";  // dense structurals and no final newline
+    for (const size_t size : {text.size(), text.size() - 1, size_t{31}, size_t{32}, size_t{33}, size_t{0}}) {
+        std::vector<uint32_t> simd(size + 32);
+        std::vector<uint32_t> scalar(size + 32);
+        const size_t count = csv_scanner::find_structurals_avx2(text.data(), size, simd.data());
+        ASSERT_EQ(count, csv_scanner::find_structurals_scalar(text.data(), size, scalar.data())) << size;
+        for (size_t i = 0; i < count; ++i) {
+            ASSERT_EQ(simd[i], scalar[i]) << size;
+        }
+        EXPECT_EQ(csv_scanner::find_structurals(text.data(), size, simd.data()), count);
+    }
+}
+
+TEST_F(CsvIngestTest, ScannerMatchesReferenceReader) {
+    std::string text = generate_lines(20000);
+    // Irregular lines that must take the fallback path
+    text += " 7, 8 ,9,1.5\n-3,4,5,-2.25\n1,2,3,1e2\n1,2,3\n\n4,5,6,7.0,extra\n9,9,9,0.1\r\n";
+    text += "8,9,3000000000,0.5\n";  // 64-bit quantity
+    text += "12345678901,1,1,1.0\n5,6,7,8.125";  // overflowing id, no trailing newline
+
+    std::vector<item> expected;
+    std::vector<item> actual;
+    const size_t expected_lines = csv_ingest::parse_range(text.data(), text.data() + text.size(), expected);
+    const size_t actual_lines = csv_scanner::parse_range(text.data(), text.data() + text.size(), actual);
+
+    EXPECT_EQ(actual_lines, expected_lines);
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(actual[i].get_id(), expected[i].get_id()) << i;
+        ASSERT_EQ(actual[i].get_length(), expected[i].get_length()) << i;
+        ASSERT_EQ(actual[i].get_quantity(), expected[i].get_quantity()) << i;
+        ASSERT_EQ(actual[i].get_weight(), expected[i].get_weight()) << i;
+    }
+}
+
+TEST_F(CsvIngestTest, ScannerDecodeWeightIsExact) {
+    for (const std::string text : {"9.653", "11.21", "0.1", "30.000", "123456.789012345", "7"}) {
+        double fast = 0.0;
+        double reference = 0.0;
+        ASSERT_TRUE(csv_scanner::decode_weight(text.data(), text.data() + text.size(), fast));
+        std::from_chars(text.data(), text.data() + text.size(), reference);
+        EXPECT_EQ(fast, reference) << text;
+    }
+}
+
+TEST_F(CsvIngestTest, BlockParserMatchesWholeBuffer) {
+    const std::string text = generate_lines(5000) + "5,6,7,8.125";  // no trailing newline
+    std::vector<item> expected;
+    csv_scanner::parse_range(text.data(), text.data() + text.size(), expected);
+
+    // Odd block sizes split lines (and the header) at every possible offset
+    for (size_t block : {1, 7, 64, 4093, 1 << 20}) {
+        csv_block_parser parser;
+        std::vector<item> actual;
+        for (size_t pos = 0; pos < text.size(); pos += block) {
+            parser.feed(text.data() + pos, std::min(block, text.size() - pos), actual);
+        }
+        parser.finish(actual);
+
+        ASSERT_EQ(actual.size(), expected.size()) << block;
+        for (size_t i = 0; i < expected.size(); ++i) {
+            ASSERT_EQ(actual[i].get_id(), expected[i].get_id()) << block;
+            ASSERT_EQ(actual[i].get_weight(), expected[i].get_weight()) << block;
+        }
+    }
+}
@@ -0,0 +1,253 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "best_fit_pack_strategy.h"
+#include "bounded_best_fit_strategy.h"
+#include "cpu_features.h"
+#include "first_fit_pack_strategy.h"
+#include "pack_planner.h"
+#include "test_support.h"
+
+// Fit Strategy Tests
+class FitStrategyTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // Pieces of up to 30 against 60 per pack leave gaps of every size
+        // behind, which later, lighter pieces can fill
+        items = generate_test_items(1200, 40, 30.0);
+        items.emplace_back(1, 700, 0, 1.0);     // skipped: no pieces
+        items.emplace_back(2, 800, 4, 900.0);   // skipped: heavier than any pack
+    }
+
+    // Scan every pack: the O(P) definitions of first-fit and best-fit
+    template <typename Weights>
+    static std::vector<pack> reference_fit(const std::vector<item>& items, int max_items,
+                                           double max_weight, bool best) {
+        const auto limit = Weights::convert(max_weight);
+        std::vector<pack> packs;
+        packs.emplace_back(1);
+        for (const auto& i : items) {
+            const auto weight = Weights::convert(i.get_weight());
+            if (i.get_quantity() <= 0 || weight > limit) continue;
+            std::int64_t remaining = i.get_quantity();
+            while (remaining > 0) {
+                pack* target = nullptr;
+                for (auto& p : packs) {
+                    const auto room = Weights::remaining_weight(p, limit);
+                    if (p.get_total_items() >= max_items || room < weight) continue;
+                    if (target == nullptr || room < Weights::remaining_weight(*target, limit)) {
+                        target = &p;
+                    }
+                    if (!best) break;
+                }
+                if (target == nullptr) {
+                    packs.emplace_back(static_cast<std::int64_t>(packs.size()) + 1);
+                    target = &packs.back();
+                }
+                remaining -= Weights::add_partial_item(*target, i.get_id(), i.get_length(), remaining,
+                                                       weight, max_items, limit);
+            }
+        }
+        return packs;
+    }
+
+    template <typename Weights, typename Fill>
+    void expect_matches_reference(Fill fill, bool best) {
+        const item_columns columns(items);
+        for (const int max_items : {5, 40}) {
+            std::vector<pack> packs;
+            fill(columns.view(), max_items, 60.0, packs, Weights{});
+            const auto expected = reference_fit<Weights>(items, max_items, 60.0, best);
+            ASSERT_EQ(packs.size(), expected.size());
+            for (size_t k = 0; k < packs.size(); ++k) {
+                ASSERT_EQ(packs[k].to_string(), expected[k].to_string()) << k;
+                EXPECT_LE(packs[k].get_total_items(), max_items);
+                EXPECT_LE(packs[k].get_total_weight(), 60.0 + 1e-9);
+            }
+        }
+    }
+
+    std::vector<item> items;
+};
+
+TEST_F(FitStrategyTest, CapacityTreeFindsLowestPackWithRoom) {
+    capacity_tree<double> tree;
+    for (int i = 0; i < 200; ++i) {
+        tree.push_back(1.0);  // grows past its initial 64 leaves
+    }
+    tree.set(150, 5.0);
+    tree.set(70, 3.0);
+    tree.set(199, 9.0);
+
+    EXPECT_EQ(tree.size(), 200);
+    EXPECT_EQ(tree.find_first(0.5), 0);
+    EXPECT_EQ(tree.find_first(2.0), 70);
+    EXPECT_EQ(tree.find_first(4.0), 150);
+    EXPECT_EQ(tree.find_first(6.0), 199);
+    EXPECT_EQ(tree.find_first(10.0), capacity_tree<double>::npos);
+
+    tree.set(70, capacity_tree<double>::NONE);
+    EXPECT_EQ(tree.find_first(2.0), 150);
+}
+
+TEST_F(FitStrategyTest, FirstFitTopsUpEarlierPacks) {
+    const std::vector<item> rows = {item(1, 100, 1, 7.0), item(2, 100, 1, 7.0), item(3, 100, 2, 3.0)};
+    pack_planner_config config;
+    config.max_items_per_pack = 10;
+    config.max_weight_per_pack = 10.0;
+
+    config.type = strategy_type::BLOCKING_NEXT_FIT;
+    pack_planner planner;
+    EXPECT_EQ(planner.plan_packs(config, rows).packs.size(), 3);
+
+    config.type = strategy_type::FIRST_FIT;
+    const auto result = planner.plan_packs(config, rows);
+    ASSERT_EQ(result.packs.size(), 2);
+    EXPECT_EQ(result.strategy_name, "First-Fit");
+    for (const auto& p : result.packs) {
+        EXPECT_EQ(p.get_total_items(), 2);
+        EXPECT_DOUBLE_EQ(p.get_total_weight(), 10.0);
+    }
+}
+
+TEST_F(FitStrategyTest, FirstFitMatchesPackByPackScan) {
+    auto fill = [](const item_column_view& view, int max_items, double max_weight,
+                   std::vector<pack>& packs, auto weights) {
+        first_fit_pack_strategy::pack_first_fit(view, max_items, max_weight, packs, weights);
+    };
+    expect_matches_reference<floating_weights>(fill, false);
+    expect_matches_reference<fixed_weights>(fill, false);
+}
+
+TEST_F(FitStrategyTest, BestFitPicksTheTightestPack) {
+    const std::vector<item> rows = {item(1, 100, 1, 6.0), item(2, 100, 1, 8.0),
+                                    item(3, 100, 1, 2.0), item(4, 100, 1, 4.0)};
+    pack_planner_config config;
+    config.max_items_per_pack = 10;
+    config.max_weight_per_pack = 10.0;
+
+    // First-fit tops up pack 1 with the 2.0 piece and must open a pack for the 4.0 one
+    config.type = strategy_type::FIRST_FIT;
+    pack_planner planner;
+    EXPECT_EQ(planner.plan_packs(config, rows).packs.size(), 3);
+
+    config.type = strategy_type::BEST_FIT;
+    const auto result = planner.plan_packs(config, rows);
+    ASSERT_EQ(result.packs.size(), 2);
+    EXPECT_EQ(result.strategy_name, "Best-Fit");
+    EXPECT_DOUBLE_EQ(result.packs[0].get_total_weight(), 10.0);
+    EXPECT_DOUBLE_EQ(result.packs[1].get_total_weight(), 10.0);
+}
+
+TEST_F(FitStrategyTest, BestFitMatchesPackByPackScan) {
+    auto fill = [](const item_column_view& view, int max_items, double max_weight,
+                   std::vector<pack>& packs, auto weights) {
+        best_fit_pack_strategy::pack_best_fit(view, max_items, max_weight, packs, weights);
+    };
+    expect_matches_reference<floating_weights>(fill, true);
+    expect_matches_reference<fixed_weights>(fill, true);
+}
+
+TEST_F(FitStrategyTest, BoundedBestFitLaneScanPicksTightestLane) {
+    std::mt19937 gen(11);
+    std::uniform_int_distribution<> room_dist(0, 40);
+    std::uniform_int_distribution<> closed_dist(0, 3);
+    alignas(32) std::array<double, 64> room{};
+    alignas(32) std::array<std::int64_t, 64> fixed_room{};
+    for (int round = 0; round < 500; ++round) {
+        for (size_t lane = 0; lane < room.size(); ++lane) {
+            // Few distinct values, so ties are common
+            const bool closed = closed_dist(gen) == 0;
+            room[lane] = closed ? std::numeric_limits<double>::lowest() : room_dist(gen) / 2.0;
+            fixed_room[lane] = closed ? std::numeric_limits<std::int64_t>::lowest() : room_dist(gen) * 500;
+        }
+        for (const size_t lanes : {size_t{4}, size_t{16}, size_t{64}}) {
+            const double needed = room_dist(gen) / 2.0;
+            const int expected = bounded_best_fit_pack_strategy::find_best_scalar(room.data(), lanes, needed);
+            EXPECT_EQ(bounded_best_fit_pack_strategy::find_best(room.data(), lanes, needed), expected);
+            if (expected >= 0) {
+                for (size_t lane = 0; lane < static_cast<size_t>(expected); ++lane) {
+                    EXPECT_FALSE(room[lane] >= needed && room[lane] <= room[expected]);
+                }
+            }
+
+            const std::int64_t fixed_needed = room_dist(gen) * 500;
+            EXPECT_EQ(bounded_best_fit_pack_strategy::find_best(fixed_room.data(), lanes, fixed_needed),
+                      bounded_best_fit_pack_strategy::find_best_scalar(fixed_room.data(), lanes, fixed_needed));
+            if (cpu_has_avx2()) {
+                EXPECT_EQ(bounded_best_fit_pack_strategy::find_best_avx2(room.data(), lanes, needed), expected);
+                EXPECT_EQ(bounded_best_fit_pack_strategy::find_best_avx2(fixed_room.data(), lanes, fixed_needed),
+                          bounded_best_fit_pack_strategy::find_best_scalar(fixed_room.data(), lanes, fixed_needed));
+            }
+        }
+    }
+    EXPECT_EQ(bounded_best_fit_pack_strategy::find_best(room.data(), 64, 1000.0), -1);
+}
+
+TEST_F(FitStrategyTest, BoundedBestFitClosesTheFullestPack) {
+    // One open pack: bounded best-fit degenerates to next-fit
+    const std::vector<item> rows = {item(1, 100, 1, 6.0), item(2, 100, 1, 8.0),
+                                    item(3, 100, 1, 2.0), item(4, 100, 1, 4.0)};
+    const item_columns columns(rows);
+    std::vector<pack> packs;
+    bounded_best_fit_pack_strategy::pack_bounded_best_fit(columns.view(), 10, 10.0, 1, packs);
+    EXPECT_EQ(packs.size(), 3);
+
+    // Two open packs are enough to match best-fit here
+    pack_planner_config config;
+    config.max_items_per_pack = 10;
+    config.max_weight_per_pack = 10.0;
+    config.type = strategy_type::BOUNDED_BEST_FIT;
+    pack_planner planner;
+    const auto result = planner.plan_packs(config, rows);
+    ASSERT_EQ(result.packs.size(), 2);
+    EXPECT_EQ(result.strategy_name, "Bounded Best-Fit");
+    EXPECT_DOUBLE_EQ(result.packs[0].get_total_weight(), 10.0);
+    EXPECT_DOUBLE_EQ(result.packs[1].get_total_weight(), 10.0);
+}
+
+TEST_F(FitStrategyTest, BoundedBestFitStaysCloseToBestFit) {
+    const item_columns columns(items);
+    std::int64_t pieces = 0;
+    for (const auto& i : items) {
+        if (i.get_quantity() > 0 && i.get_weight() <= 60.0) pieces += i.get_quantity();
+    }
+    for (const int max_items : {5, 40}) {
+        std::vector<pack> best;
+        best_fit_pack_strategy::pack_best_fit(columns.view(), max_items, 60.0, best);
+        std::vector<pack> next;
+        bounded_best_fit_pack_strategy::pack_bounded_best_fit(columns.view(), max_items, 60.0, 1, next);
+
+        for (const int open_packs : {8, 16, 64}) {
+            std::vector<pack> packs;
+            bounded_best_fit_pack_strategy::pack_bounded_best_fit(columns.view(), max_items, 60.0,
+                                                                  open_packs, packs, fixed_weights{});
+            std::int64_t placed = 0;
+            for (size_t k = 0; k < packs.size(); ++k) {
+                EXPECT_EQ(packs[k].get_pack_number(), static_cast<std::int64_t>(k) + 1);
+                EXPECT_LE(packs[k].get_total_items(), max_items);
+                EXPECT_LE(packs[k].get_total_weight(), 60.0 + 1e-9);
+                placed += packs[k].get_total_items();
+            }
+            EXPECT_EQ(placed, pieces);
+            // Fewer packs than next-fit at any K; with 64 lanes, within 5% of full best-fit
+            EXPECT_LT(packs.size(), next.size()) << open_packs;
+            if (open_packs == bounded_best_fit_pack_strategy::MAX_OPEN_PACKS) {
+                EXPECT_LE(packs.size(), best.size() + best.size() / 20);
+            }
+        }
+    }
+}
+
+TEST_F(FitStrategyTest, SelectableByName) {
+    EXPECT_EQ(pack_strategy_factory::parse_strategy_type("first_fit"), strategy_type::FIRST_FIT);
+    EXPECT_EQ(pack_strategy_factory::parse_strategy_type("First-Fit"), strategy_type::FIRST_FIT);
+    EXPECT_EQ(pack_strategy_factory::parse_strategy_type("best_fit"), strategy_type::BEST_FIT);
+    EXPECT_EQ(pack_strategy_factory::parse_strategy_type("bounded_best_fit"), strategy_type::BOUNDED_BEST_FIT);
+    EXPECT_EQ(pack_strategy_factory::parse_strategy_type("best_fit_k"), strategy_type::BOUNDED_BEST_FIT);
+    EXPECT_EQ(pack_strategy_factory::parse_strategy_type("blocking"), strategy_type::BLOCKING_FIRST_FIT);
+    EXPECT_FALSE(pack_strategy_factory::is_streaming_strategy(strategy_type::FIRST_FIT));
+}
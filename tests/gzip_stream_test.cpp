@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+
+#ifdef PACK_PLANNER_HAVE_ZLIB
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+
+#include "gzip_stream.h"
+#include "pipeline_planner.h"
+
+// Gzip Stream Tests
+class GzipStreamTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        std::remove(gz_path.c_str());
+        std::remove(plain_path.c_str());
+    }
+
+    std::string generate_lines(int count) {
+        std::string text = "NATURAL,40,500.0\n";
+        for (int i = 0; i < count; ++i) {
+            text += std::to_string(1000 + i) + "," + std::to_string(500 + i % 9500) + "," +
+                    std::to_string(1 + i % 70) + "," + std::to_string(0.5 + (i % 300) / 10.0) + "\n";
+        }
+        return text;
+    }
+
+    std::string read_all(gzip_reader& reader) {
+        std::string text;
+        std::string block;
+        while (reader.next_block(block)) {
+            text += block;
+        }
+        return text;
+    }
+
+    std::string gz_path = ::testing::TempDir() + "gzip_stream_test.csv.gz";
+    std::string plain_path = ::testing::TempDir() + "gzip_stream_test.csv";
+};
+
+TEST_F(GzipStreamTest, RoundTrip) {
+    const std::string text = generate_lines(200000);  // several reader blocks
+    {
+        gzip_ofstream out(gz_path, 1);
+        ASSERT_TRUE(out.is_open());
+        out << text;
+        out.close();
+        ASSERT_TRUE(out);
+    }
+
+    EXPECT_TRUE(is_gzip_file(gz_path));
+    EXPECT_TRUE(has_gzip_extension(gz_path));
+
+    gzip_reader reader;
+    ASSERT_TRUE(reader.open(gz_path));
+    EXPECT_EQ(read_all(reader), text);
+    EXPECT_TRUE(reader.ok());
+}
+
+TEST_F(GzipStreamTest, TruncatedFileFails) {
+    const std::string text = generate_lines(200000);
+    {
+        gzip_ofstream out(gz_path, 1);
+        out << text;
+    }
+    std::string compressed;
+    {
+        std::ifstream in(gz_path, std::ios::binary);
+        compressed.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    ASSERT_GT(compressed.size(), 1000u);
+    {
+        std::ofstream out(gz_path, std::ios::binary | std::ios::trunc);
+        out.write(compressed.data(), static_cast<std::streamsize>(compressed.size() / 2));
+    }
+
+    gzip_reader reader;
+    ASSERT_TRUE(reader.open(gz_path));
+    EXPECT_LT(read_all(reader).size(), text.size());
+    EXPECT_FALSE(reader.ok());
+}
+
+TEST_F(GzipStreamTest, PlainFilesPassThrough) {
+    {
+        std::ofstream out(plain_path, std::ios::binary);
+        out << "1001,6200,30,9.653\n";
+    }
+    EXPECT_FALSE(is_gzip_file(plain_path));
+    EXPECT_FALSE(has_gzip_extension(plain_path));
+
+    gzip_reader reader;
+    ASSERT_TRUE(reader.open(plain_path));
+    EXPECT_EQ(read_all(reader), "1001,6200,30,9.653\n");
+    EXPECT_TRUE(reader.ok());
+}
+
+TEST_F(GzipStreamTest, EarlyCloseStopsReader) {
+    {
+        gzip_ofstream out(gz_path);
+        out << generate_lines(300000);
+    }
+
+    gzip_reader reader;
+    ASSERT_TRUE(reader.open(gz_path));
+    std::string block;
+    ASSERT_TRUE(reader.next_block(block));
+    reader.close();  // must not hang on a full ring
+    EXPECT_FALSE(reader.next_block(block));
+}
+
+TEST_F(GzipStreamTest, PipelineFromCompressedInput) {
+    const std::string text = generate_lines(50000);
+    {
+        gzip_ofstream out(gz_path);
+        out << text;
+    }
+
+    pack_planner_config config;
+    config.max_items_per_pack = 40;
+    config.max_weight_per_pack = 500.0;
+
+    pipeline_planner pipeline;
+    std::ostringstream expected;
+    pipeline.run(text.data(), text.size(), config, expected);
+
+    gzip_reader reader;
+    ASSERT_TRUE(reader.open(gz_path));
+    std::ostringstream actual;
+    const pipeline_stats stats = pipeline.run_blocks(
+        [&reader](std::string& block) { return reader.next_block(block); }, config, actual);
+
+    EXPECT_EQ(stats.items, 50000);
+    EXPECT_EQ(actual.str(), expected.str());
+}
+
+#endif
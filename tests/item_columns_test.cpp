@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+
+#include "item_columns.h"
+#include "optimized_sort.h"
+#include "pack_planner.h"
+#include "test_support.h"
+
+// Item Columns Tests
+class ItemColumnsTest : public ::testing::Test {
+protected:
+    // Lengths past 65535 make the radix sorts take a third byte pass
+    void SetUp() override {
+        items = generate_test_items(4000, 10, 30.0, 70000);
+    }
+
+    // Few distinct lengths so that ties are common, plus negative lengths
+    void use_tied_lengths() {
+        for (size_t i = 0; i < items.size(); ++i) {
+            items[i] = item(items[i].get_id(), static_cast<int>(i % 7) * 300 - 600,
+                            items[i].get_quantity(), items[i].get_weight());
+        }
+    }
+
+    static void expect_rows_equal(const std::vector<item>& expected, const item_columns& columns) {
+        ASSERT_EQ(columns.size(), expected.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            ASSERT_EQ(columns.ids()[i], expected[i].get_id()) << i;
+            ASSERT_EQ(columns.lengths()[i], expected[i].get_length()) << i;
+            ASSERT_EQ(columns.quantities()[i], expected[i].get_quantity()) << i;
+            ASSERT_EQ(columns.weights()[i], expected[i].get_weight()) << i;
+        }
+    }
+
+    std::vector<item> items;
+};
+
+TEST_F(ItemColumnsTest, AdapterRoundTrip) {
+    const item_columns columns(items);
+    expect_rows_equal(items, columns);
+
+    const item_column_view view = columns.view();
+    EXPECT_EQ(view.size(), items.size());
+    EXPECT_EQ(view.lengths, columns.lengths().data());
+
+    const item_columns copy(view);
+    expect_rows_equal(items, copy);
+    EXPECT_EQ(copy.to_items().back().to_string(), items.back().to_string());
+
+    long long pieces = 0;
+    for (const auto& i : items) pieces += i.get_quantity();
+    EXPECT_EQ(columns.total_quantity(), pieces);
+}
+
+TEST_F(ItemColumnsTest, ColumnRadixSortIsStable) {
+    use_tied_lengths();
+
+    for (const bool ascending : {true, false}) {
+        std::vector<item> expected = items;
+        std::stable_sort(expected.begin(), expected.end(), [ascending](const item& a, const item& b) {
+            return ascending ? a.get_length() < b.get_length() : a.get_length() > b.get_length();
+        });
+
+        item_columns columns(items);
+        optimized_sort::ColumnRadixSort::sort_by_length(columns, ascending);
+        expect_rows_equal(expected, columns);
+    }
+}
+
+TEST_F(ItemColumnsTest, ColumnRadixSortMatchesItemSort) {
+    std::vector<item> expected = items;
+    optimized_sort::RadixSort::sort_by_length(expected, false);
+
+    item_columns columns(items);
+    optimized_sort::ColumnRadixSort::sort_by_length(columns, false);
+    expect_rows_equal(expected, columns);
+}
+
+TEST_F(ItemColumnsTest, StrategiesGiveSamePacksForBothInputs) {
+    for (const auto type : {strategy_type::BLOCKING_FIRST_FIT, strategy_type::BLOCKING_NEXT_FIT,
+                            strategy_type::PARALLEL_FIRST_FIT, strategy_type::LOCKFREE_FIRST_FIT}) {
+        auto strategy = pack_strategy_factory::create_strategy(type, 1);
+        const item_columns columns(items);
+        const auto from_items = strategy->pack_items(items, 40, 500.0);
+        const auto from_columns = strategy->pack_items(columns.view(), 40, 500.0);
+
+        ASSERT_EQ(from_items.size(), from_columns.size());
+        ASSERT_GT(from_columns.size(), 1);
+        for (size_t p = 0; p < from_items.size(); ++p) {
+            EXPECT_EQ(from_items[p].to_string(), from_columns[p].to_string());
+        }
+    }
+}
+
+TEST_F(ItemColumnsTest, KeyIndexRadixSortIsStable) {
+    use_tied_lengths();
+
+    for (const bool ascending : {true, false}) {
+        std::vector<item> expected = items;
+        std::stable_sort(expected.begin(), expected.end(), [ascending](const item& a, const item& b) {
+            return ascending ? a.get_length() < b.get_length() : a.get_length() > b.get_length();
+        });
+
+        item_columns columns(items);
+        optimized_sort::KeyIndexRadixSort::sort_by_length(columns, ascending);
+        expect_rows_equal(expected, columns);
+
+        std::vector<item> sorted = items;
+        optimized_sort::KeyIndexRadixSort::sort_by_length(sorted, ascending);
+        expect_rows_equal(expected, item_columns(sorted));
+    }
+}
+
+TEST_F(ItemColumnsTest, PermutedViewPacksLikeSortedColumns) {
+    const item_columns source(items);
+    const auto order = optimized_sort::KeyIndexRadixSort::sort_permutation(source.view(), false);
+    ASSERT_EQ(order.size(), items.size());
+
+    item_column_view permuted = source.view();
+    permuted.order = order.data();
+    EXPECT_EQ(permuted.at(0).get_length(), *std::max_element(source.lengths().begin(), source.lengths().end()));
+
+    item_columns sorted(items);
+    optimized_sort::ColumnRadixSort::sort_by_length(sorted, false);
+    expect_rows_equal(sorted.to_items(), item_columns(permuted));
+
+    // Sorting an already permuted view composes the permutations
+    const auto ascending = optimized_sort::KeyIndexRadixSort::sort_permutation(permuted, true);
+    item_column_view reordered = source.view();
+    reordered.order = ascending.data();
+    item_columns expected(items);
+    optimized_sort::ColumnRadixSort::sort_by_length(expected, false);
+    optimized_sort::ColumnRadixSort::sort_by_length(expected, true);
+    expect_rows_equal(expected.to_items(), item_columns(reordered));
+
+    for (const auto type : {strategy_type::BLOCKING_FIRST_FIT, strategy_type::BLOCKING_NEXT_FIT}) {
+        auto strategy = pack_strategy_factory::create_strategy(type, 1);
+        const auto from_sorted = strategy->pack_items(sorted.view(), 40, 500.0);
+        const auto from_permuted = strategy->pack_items(permuted, 40, 500.0);
+        ASSERT_EQ(from_sorted.size(), from_permuted.size());
+        for (size_t p = 0; p < from_sorted.size(); ++p) {
+            EXPECT_EQ(from_sorted[p].to_string(), from_permuted[p].to_string());
+        }
+    }
+}
@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "ndjson_service.h"
+#include "pack_planner.h"
+
+// NDJSON Service Tests
+class NdjsonServiceTest : public ::testing::Test {
+protected:
+    static std::string make_request(int id, int item_count) {
+        std::string line = "{\"id\":" + std::to_string(id) + ",\"items\":[";
+        for (int i = 0; i < item_count; ++i) {
+            if (i > 0) line += ',';
+            line += "{\"id\":" + std::to_string(1000 + i) + ",\"length\":" + std::to_string(500 + i * 37 % 900) +
+                    ",\"quantity\":" + std::to_string(1 + i % 30) + ",\"weight\":" + std::to_string(0.5 + i % 20) + "}";
+        }
+        line += "],\"configuration\":{\"sortOrder\":\"LONG_TO_SHORT\",\"maxItemsPerPack\":40,"
+                "\"maxWeightPerPack\":500.0,\"strategyType\":\"BLOCKING\"}}";
+        return line;
+    }
+
+    static std::vector<std::string> split_lines(const std::string& text) {
+        std::vector<std::string> lines;
+        std::istringstream stream(text);
+        std::string line;
+        while (std::getline(stream, line)) lines.push_back(line);
+        return lines;
+    }
+};
+
+TEST_F(NdjsonServiceTest, ParseRequestReadsItemsAndConfiguration) {
+    ndjson_service service;
+    ndjson_request request;
+    std::string error;
+
+    const std::string line =
+        R"({"id": "order-7", "extra": {"nested": [1, true, null]}, "items": [)"
+        R"({"id": 1, "length": 6200, "quantity": 30, "weight": 9.653}, [2, 7200, 5.0, 11.21]],)"
+        R"( "configuration": {"sortOrder": "SHORT_TO_LONG", "maxItemsPerPack": 40,)"
+        R"( "maxWeightPerPack": 500, "strategyType": "next_fit", "threadCount": 2}})";
+    ASSERT_TRUE(service.parse_request(line, request, error)) << error;
+
+    EXPECT_EQ(request.id, "\"order-7\"");
+    ASSERT_EQ(request.items.size(), 2);
+    EXPECT_EQ(request.items[0].get_length(), 6200);
+    EXPECT_DOUBLE_EQ(request.items[0].get_weight(), 9.653);
+    EXPECT_EQ(request.items[1].get_quantity(), 5);
+    EXPECT_EQ(request.config.order, sort_order::SHORT_TO_LONG);
+    EXPECT_EQ(request.config.max_items_per_pack, 40);
+    EXPECT_DOUBLE_EQ(request.config.max_weight_per_pack, 500.0);
+    EXPECT_EQ(request.config.type, strategy_type::BLOCKING_NEXT_FIT);
+    EXPECT_EQ(request.config.thread_count, 2);
+}
+
+TEST_F(NdjsonServiceTest, ParseRequestRejectsMalformedInput) {
+    ndjson_service service;
+    ndjson_request request;
+    std::string error;
+
+    for (const std::string line : {R"([1,2])", R"({"items": [{"id": 1, "length": 2}]})",
+                                   R"({"items": [{"id": 1.5, "length": 2, "quantity": 3, "weight": 1}]})",
+                                   R"({"items": []} x)", R"({"id": true, "items": []})", R"({"items": [)"}) {
+        EXPECT_FALSE(service.parse_request(line, request, error)) << line;
+        EXPECT_FALSE(error.empty());
+    }
+}
+
+TEST_F(NdjsonServiceTest, ResponseMatchesPlanner) {
+    pack_planner_config defaults;
+    ndjson_service service(defaults, 1);
+    pack_planner planner;
+
+    std::string response;
+    ASSERT_TRUE(service.process(make_request(3, 50), 1, planner, response));
+    EXPECT_EQ(response.rfind("{\"id\":3,\"success\":true,\"packs\":[{\"packNumber\":1,", 0), 0) << response;
+
+    ndjson_request request;
+    std::string error;
+    ASSERT_TRUE(service.parse_request(make_request(3, 50), request, error));
+    const auto result = planner.plan_packs(request.config, request.items);
+    size_t packs = 0;
+    for (const auto& p : result.packs) {
+        if (!p.is_empty()) ++packs;
+    }
+    EXPECT_NE(response.find("\"packCount\":" + std::to_string(packs) + "}"), std::string::npos);
+    EXPECT_NE(response.find("\"sortOrder\":\"LTS\""), std::string::npos);
+    EXPECT_NE(response.find("\"strategyUsed\":"), std::string::npos);
+}
+
+TEST_F(NdjsonServiceTest, ErrorsUseLineNumberWhenIdIsMissing) {
+    ndjson_service service;
+    pack_planner planner;
+    std::string response;
+
+    EXPECT_FALSE(service.process(R"({"items": []})", 12, planner, response));
+    EXPECT_EQ(response.rfind("{\"id\":12,\"success\":false,\"error\":", 0), 0) << response;
+
+    EXPECT_FALSE(service.process("not json", 4, planner, response));
+    EXPECT_NE(response.find("\"error\":\"Invalid request\""), std::string::npos);
+}
+
+TEST_F(NdjsonServiceTest, RunKeepsRequestOrder) {
+    std::string input;
+    for (int i = 0; i < 64; ++i) {
+        // Alternate big and small requests so completion order differs from input order
+        input += make_request(i, i % 2 == 0 ? 2000 : 3) + "\n";
+        if (i == 10) input += "\n";
+        if (i == 20) input += "{broken\n";
+    }
+
+    std::istringstream in(input);
+    std::ostringstream out;
+    ndjson_service service({}, 4);
+    service.run(in, out);
+
+    const auto lines = split_lines(out.str());
+    ASSERT_EQ(lines.size(), 65);
+    EXPECT_EQ(service.get_requests(), 65);
+    EXPECT_EQ(service.get_failed(), 1);
+    for (int i = 0, line = 0; i < 64; ++i, ++line) {
+        if (i == 21) {
+            EXPECT_NE(lines[line].find("\"success\":false"), std::string::npos);
+            ++line;
+        }
+        EXPECT_EQ(lines[line].rfind("{\"id\":" + std::to_string(i) + ",", 0), 0) << line;
+    }
+}
+
+TEST_F(NdjsonServiceTest, UnorderedRunAnswersEveryRequest) {
+    std::string input;
+    for (int i = 0; i < 40; ++i) {
+        input += make_request(i, i % 3 == 0 ? 1500 : 5) + "\n";
+    }
+
+    std::istringstream in(input);
+    std::ostringstream out;
+    ndjson_service service({}, 3, false);
+    service.run(in, out);
+
+    std::set<std::string> ids;
+    for (const auto& line : split_lines(out.str())) {
+        ids.insert(line.substr(6, line.find(',') - 6));
+    }
+    EXPECT_EQ(ids.size(), 40);
+}
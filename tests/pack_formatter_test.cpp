@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <vector>
+
+#include "pack_formatter.h"
+#include "pack_planner.h"
+
+// Pack Formatter Tests
+class PackFormatterTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        pack first(1);
+        (void)first.add_partial_item(1001, 6200, 30, 9.653, 40, 500.0);
+        (void)first.add_partial_item(2001, 7200, 10, 11.21, 40, 500.0);
+        packs.push_back(first);
+
+        pack second(2);
+        (void)second.add_partial_item(2001, 7200, 40, 11.21, 40, 500.0);
+        packs.push_back(second);
+
+        // Rounding edge cases for the fixed 3/2-decimal fields
+        pack third(3);
+        (void)third.add_partial_item(-7, 0, 3, 2.0005, 1000, 1e9);
+        (void)third.add_partial_item(8, 12, 1, 0.0, 1000, 1e9);
+        (void)third.add_partial_item(9, 12, 1, 123456789.9999, 1000, 1e9);
+        (void)third.add_partial_item(10, 99, 7, 0.3349999, 1000, 1e9);
+        packs.push_back(third);
+    }
+
+    std::string reference_output() const {
+        std::ostringstream expected;
+        for (const auto& p : packs) {
+            expected << p.to_string() << "\n";
+        }
+        return expected.str();
+    }
+
+    std::vector<pack> packs;
+};
+
+TEST_F(PackFormatterTest, MatchesToString) {
+    std::ostringstream output;
+    {
+        pack_formatter formatter(output);
+        for (const auto& p : packs) {
+            formatter.write_pack(p);
+        }
+    }
+    EXPECT_EQ(output.str(), reference_output());
+}
+
+TEST_F(PackFormatterTest, SmallBlocksFlushWithoutSplittingBytes) {
+    std::ostringstream output;
+    pack_formatter formatter(output, 1);  // clamped to the minimum block size
+    for (int repeat = 0; repeat < 50; ++repeat) {
+        for (const auto& p : packs) {
+            formatter.write_pack(p);
+        }
+    }
+    formatter.flush();
+
+    std::string expected;
+    for (int repeat = 0; repeat < 50; ++repeat) {
+        expected += reference_output();
+    }
+    EXPECT_EQ(output.str(), expected);
+}
+
+TEST_F(PackFormatterTest, SpecExample) {
+    pack_planner planner;
+    std::ostringstream output;
+    planner.output_results(packs, output);
+
+    const std::string text = output.str();
+    EXPECT_EQ(text.substr(0, text.find("Pack Number: 3")),
+              "Pack Number: 1\n"
+              "1001,6200,30,9.653\n"
+              "2001,7200,10,11.210\n"
+              "Pack Length: 7200, Pack Weight: 401.69\n"
+              "Pack Number: 2\n"
+              "2001,7200,40,11.210\n"
+              "Pack Length: 7200, Pack Weight: 448.40\n");
+}
+
+TEST_F(PackFormatterTest, MeasureAndRenderMatchToString) {
+    for (const auto& p : packs) {
+        const std::string expected = p.to_string() + "\n";
+        ASSERT_EQ(pack_formatter::measure_pack(p), expected.size());
+
+        // Exactly sized destination exercises the staged tail lines
+        std::vector<char> buffer(expected.size());
+        char* end = pack_formatter::render_pack(buffer.data(), buffer.data() + buffer.size(), p);
+        EXPECT_EQ(end, buffer.data() + buffer.size());
+        EXPECT_EQ(std::string(buffer.data(), buffer.size()), expected);
+    }
+}
+
+TEST_F(PackFormatterTest, RenderIntoUndersizedRangeIsTruncated) {
+    const std::string expected = packs[0].to_string() + "\n";
+    std::vector<char> buffer(expected.size(), '#');
+    const size_t limit = expected.size() / 2;
+
+    char* end = pack_formatter::render_pack(buffer.data(), buffer.data() + limit, packs[0]);
+    EXPECT_GT(end, buffer.data() + limit);
+    EXPECT_EQ(std::string(buffer.data(), limit), expected.substr(0, limit));
+    EXPECT_EQ(buffer[limit], '#');
+}
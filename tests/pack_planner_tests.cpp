@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <random>
 #include <chrono>
+#include <memory_resource>
 
 #include "item.h"
 #include "pack.h"
@@ -1061,6 +1062,119 @@ TEST_F(SortingAlgorithmTest, IdenticalLengths) {
     }
 }
 
+TEST_P(PackPlannerTestBase, FixedPointWeightsFillPacksExactly) {
+    std::vector<item> tenths;
+    for (int id = 1; id <= 9; ++id) {
+        tenths.emplace_back(id, 10, 1, 0.1);
+    }
+    config.max_items_per_pack = 100;
+    config.max_weight_per_pack = 0.3;
+
+    // Floating-point remainders round 0.3 - 0.2 below 0.1, leaving packs short
+    auto floating = planner.plan_packs(config, tenths);
+
+    config.weights = weight_mode::FIXED_POINT;
+    auto fixed = planner.plan_packs(config, tenths);
+    ASSERT_EQ(fixed.packs.size(), 3u);
+    for (const auto& p : fixed.packs) {
+        EXPECT_EQ(p.get_total_items(), 3);
+        EXPECT_EQ(p.get_total_weight_fixed(), 300);
+    }
+    EXPECT_GT(floating.packs.size(), fixed.packs.size());
+
+    plan_arena arena;
+    (void)planner.plan_packs(config, item_columns(tenths), arena);
+    ASSERT_EQ(arena.size(), 3u);
+    EXPECT_EQ(arena.packs()[2].total_weight_fixed, 300);
+    EXPECT_EQ(arena[2].to_pack().get_total_weight_fixed(), 300);
+}
+
+TEST_P(PackPlannerTestBase, MemoryResourceHoldsEveryPack) {
+    // Enough rows for the multi-threaded strategies to use their workers
+    std::vector<item> many;
+    for (int id = 0; id < 6000; ++id) {
+        many.emplace_back(id, 100 + id % 50, 1 + id % 3, 1.5);
+    }
+
+    const auto reference = planner.plan_packs(config, many);
+
+    std::pmr::monotonic_buffer_resource arena;
+    const auto result = planner.plan_packs(config, item_columns(many), &arena);
+    // Worker merge order may vary between runs, so compare totals only
+    ASSERT_EQ(result.packs.size(), reference.packs.size());
+    std::int64_t pieces = 0;
+    for (const auto& p : result.packs) {
+        EXPECT_EQ(p.get_allocator().resource(), &arena);
+        pieces += p.get_total_items();
+    }
+    std::int64_t reference_pieces = 0;
+    for (const auto& p : reference.packs) {
+        reference_pieces += p.get_total_items();
+    }
+    EXPECT_EQ(pieces, reference_pieces);
+}
+
+TEST_P(PackPlannerTestBase, PacksPastFormerPackAndIterationLimits) {
+    // 400000 packs and 1.2M partial adds: well past the old 100000-pack and
+    // 1M-iteration caps, which used to drop pieces silently
+    std::vector<item> many;
+    many.reserve(600000);
+    for (int id = 0; id < 600000; ++id) {
+        many.emplace_back(id, 100, 2, 1.0);
+    }
+    config.max_items_per_pack = 3;
+
+    const auto result = planner.plan_packs(config, many);
+    EXPECT_EQ(result.unplaced_items, 0);
+    EXPECT_TRUE(result.error.empty());
+
+    long long pieces = 0;
+    size_t packs = 0;
+    for (const auto& p : result.packs) {
+        pieces += p.get_total_items();
+        packs += p.is_empty() ? 0 : 1;
+    }
+    EXPECT_EQ(pieces, 1200000);
+    EXPECT_EQ(packs, 400000);
+    if (pack_strategy_factory::is_streaming_strategy(GetParam()) ||
+        GetParam() == strategy_type::PARALLEL_FIRST_FIT) {
+        // pieces / max_items is exact here, so the O(n) estimate reserved the
+        // plan once with its 1/8 headroom (lock-free drops empty packs; the
+        // fit strategies reserve nothing)
+        EXPECT_LE(result.packs.capacity(), result.packs.size() + result.packs.size() / 8 + 1);
+    }
+}
+
+TEST_P(PackPlannerTestBase, ReportsPiecesHeavierThanAPack) {
+    items.emplace_back(9, 100, 3, 30.0);  // heavier than the 25.0 limit
+
+    const auto result = planner.plan_packs(config, items);
+    EXPECT_EQ(result.unplaced_items, 3);
+    EXPECT_EQ(result.error, "3 pieces were not packed: 3 weigh more than a pack's weight limit");
+
+    const auto clean = planner.plan_packs(config, std::vector<item>{item(1, 100, 5, 2.0)});
+    EXPECT_EQ(clean.unplaced_items, 0);
+    EXPECT_TRUE(clean.error.empty());
+}
+
+TEST_P(PackPlannerTestBase, CountsPiecesPastInt) {
+    // 8 billion pieces: item, pack and result totals all pass 2^31
+    const std::vector<item> bulk = {item(1, 500, 3'000'000'000, 1.0), item(2, 400, 5'000'000'000, 0.5)};
+    config.max_items_per_pack = 1'000'000;
+    config.max_weight_per_pack = 1e9;
+
+    const auto result = planner.plan_packs(config, bulk);
+    EXPECT_EQ(result.total_items, 8'000'000'000);
+    EXPECT_EQ(result.unplaced_items, 0);
+
+    std::int64_t pieces = 0;
+    for (const auto& p : result.packs) {
+        pieces += p.get_total_items();
+    }
+    EXPECT_EQ(pieces, 8'000'000'000);
+    EXPECT_EQ(result.packs.back().get_pack_number(), 8000);
+}
+
 // Instantiate parameterized tests for both strategies
 INSTANTIATE_TEST_SUITE_P(
     AllStrategies,
@@ -1068,7 +1182,10 @@ INSTANTIATE_TEST_SUITE_P(
     ::testing::Values(
         strategy_type::BLOCKING_FIRST_FIT,
         strategy_type::PARALLEL_FIRST_FIT,
-        strategy_type::LOCKFREE_FIRST_FIT
+        strategy_type::LOCKFREE_FIRST_FIT,
+        strategy_type::FIRST_FIT,
+        strategy_type::BEST_FIT,
+        strategy_type::BOUNDED_BEST_FIT
         ),
     [](const ::testing::TestParamInfo<strategy_type>& info) {
         switch (info.param) {
@@ -1078,6 +1195,12 @@ INSTANTIATE_TEST_SUITE_P(
             return "Parallel";
         case strategy_type::LOCKFREE_FIRST_FIT:
             return "LockFree";
+        case strategy_type::FIRST_FIT:
+            return "FirstFit";
+        case strategy_type::BEST_FIT:
+            return "BestFit";
+        case strategy_type::BOUNDED_BEST_FIT:
+            return "BoundedBestFit";
         default:
             return "Unknown";
         }
@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 #include "pack.h"
+#include <array>
+#include <cstddef>
+#include <memory_resource>
 
 // Pack Class Tests
 class PackTest : public ::testing::Test {
@@ -164,6 +167,49 @@ TEST_F(PackTest, IsFull) {
     EXPECT_FALSE(pack3.is_full(default_max_items, default_max_weight)); // Should be considered full due to epsilon
 }
 
+TEST_F(PackTest, AddPartialItemFixedIsExact) {
+    // 0.3 / 0.1 is 2.999... in doubles, so the floating path only fits two
+    pack floating(1);
+    EXPECT_EQ(floating.add_partial_item(1, 10, 3, 0.1, default_max_items, 0.3), 2);
+
+    pack fixed(2);
+    const std::int64_t piece = fixed_weight::from_double(0.1);
+    const std::int64_t capacity = fixed_weight::from_double(0.3);
+    EXPECT_EQ(piece, 100);
+    EXPECT_EQ(fixed.add_partial_item_fixed(1, 10, 3, piece, default_max_items, capacity), 3);
+    EXPECT_EQ(fixed.get_total_weight_fixed(), 300);
+    EXPECT_DOUBLE_EQ(fixed.get_total_weight(), 0.3);
+    EXPECT_TRUE(fixed.is_full_fixed(default_max_items, capacity));
+    EXPECT_EQ(fixed.add_partial_item_fixed(2, 10, 1, piece, default_max_items, capacity), 0);
+
+    // Items keep the rounded weight, so the output matches the capacity check
+    EXPECT_DOUBLE_EQ(fixed.get_items()[0].get_weight(), 0.1);
+    EXPECT_EQ(item(3, 10, 1, 1.2345).get_fixed_weight(), 1235);
+    EXPECT_EQ(item(4, 10, 1, -2.0).get_fixed_weight(), 0);
+}
+
+TEST_F(PackTest, AllocatesItemsFromMemoryResource) {
+    // A fixed buffer with no upstream: any allocation outside it would throw
+    std::array<std::byte, 4096> buffer;
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(),
+                                              std::pmr::null_memory_resource());
+
+    pack p(1, &arena);
+    EXPECT_EQ(p.get_allocator().resource(), &arena);
+    for (int id = 0; id < 20; ++id) {
+        EXPECT_EQ(p.add_partial_item(id, 10, 1, 1.0, default_max_items, default_max_weight), 1);
+    }
+    EXPECT_EQ(p.get_items().size(), 20u);
+
+    // Plain copies leave the arena; allocator-extended copies stay in it
+    const pack copy = p;
+    EXPECT_EQ(copy.get_allocator().resource(), std::pmr::get_default_resource());
+    EXPECT_EQ(copy.get_items().size(), 20u);
+    const pack rehomed(copy, &arena);
+    EXPECT_EQ(rehomed.get_allocator().resource(), &arena);
+    EXPECT_DOUBLE_EQ(rehomed.get_total_weight(), 20.0);
+}
+
 TEST_F(PackTest, GetItems) {
     EXPECT_TRUE(pack1.add_item(item1, default_max_items, default_max_weight));
     EXPECT_TRUE(pack1.add_item(item2, default_max_items, default_max_weight));
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "pack_planner.h"
+#include "parallel_output.h"
+
+// Parallel Output Tests
+class ParallelOutputTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        std::remove(path.c_str());
+    }
+
+    std::vector<pack> generate_packs(int count) {
+        std::vector<pack> packs;
+        packs.reserve(count);
+        for (int n = 0; n < count; ++n) {
+            pack p(n + 1);
+            for (int i = 0; i < 1 + n % 7; ++i) {
+                (void)p.add_partial_item(n * 10 + i, 100 + (n * 37 + i) % 9000, 1 + i,
+                                         0.001 + ((n + i) % 997) / 7.0, 1000, 1e9);
+            }
+            packs.push_back(p);
+            if (n % 50 == 0) {
+                packs.emplace_back(-1);  // empty packs are skipped
+            }
+        }
+        return packs;
+    }
+
+    std::string read_file() const {
+        std::ifstream in(path, std::ios::binary);
+        return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    }
+
+    std::string reference_output(const std::vector<pack>& packs) const {
+        pack_planner planner;
+        std::ostringstream output;
+        planner.output_results(packs, output);
+        return output.str();
+    }
+
+    std::string path = ::testing::TempDir() + "parallel_output_test.txt";
+};
+
+TEST_F(ParallelOutputTest, SmallResultMatchesStreamOutput) {
+    const auto packs = generate_packs(20);
+    parallel_output writer(4);
+
+    ASSERT_TRUE(writer.write_file(packs, path));
+    EXPECT_EQ(writer.get_threads_used(), 1);
+    const std::string expected = reference_output(packs);
+    EXPECT_EQ(writer.get_bytes_written(), expected.size());
+    EXPECT_EQ(read_file(), expected);
+}
+
+TEST_F(ParallelOutputTest, LargeResultMatchesStreamOutput) {
+    const auto packs = generate_packs(40000);  // ~160k item lines
+    parallel_output writer(4);
+
+    ASSERT_TRUE(writer.write_file(packs, path));
+    EXPECT_EQ(writer.get_threads_used(), 4);
+    EXPECT_EQ(read_file(), reference_output(packs));
+}
+
+TEST_F(ParallelOutputTest, EmptyResultCreatesEmptyFile) {
+    parallel_output writer(4);
+    ASSERT_TRUE(writer.write_file({}, path));
+    EXPECT_EQ(writer.get_bytes_written(), 0);
+    EXPECT_TRUE(read_file().empty());
+}
+
+TEST_F(ParallelOutputTest, SplitRangesCoversAllPacks) {
+    const auto packs = generate_packs(1000);
+    const auto bounds = parallel_output::split_ranges(packs, 7);
+
+    ASSERT_EQ(bounds.size(), 8);
+    EXPECT_EQ(bounds.front(), 0);
+    EXPECT_EQ(bounds.back(), packs.size());
+    for (size_t i = 1; i < bounds.size(); ++i) {
+        EXPECT_LT(bounds[i - 1], bounds[i]);
+    }
+}
+
+TEST_F(ParallelOutputTest, UnwritablePathFails) {
+    parallel_output writer;
+    EXPECT_FALSE(writer.write_file(generate_packs(3), "/nonexistent/dir/out.txt"));
+}
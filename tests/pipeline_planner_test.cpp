@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "csv_ingest.h"
+#include "pack_formatter.h"
+#include "pipeline_planner.h"
+#include "spsc_ring.h"
+#include "streaming_packer.h"
+
+// Pipeline Planner Tests
+class PipelinePlannerTest : public ::testing::Test {
+protected:
+    std::string generate_lines(int count) {
+        std::string text = "NATURAL,40,500.0\n";
+        for (int i = 0; i < count; ++i) {
+            text += std::to_string(1000 + i) + "," + std::to_string(500 + i % 9500) + "," +
+                    std::to_string(1 + i % 70) + "," + std::to_string(0.5 + (i % 300) / 10.0) + "\n";
+        }
+        return text;
+    }
+
+    std::string reference_output(const std::string& text, const pack_planner_config& config) {
+        std::vector<item> items;
+        csv_ingest::parse_range(text.data(), text.data() + text.size(), items);
+
+        std::ostringstream output;
+        pack_formatter formatter(output);
+        streaming_packer packer(config.max_items_per_pack, config.max_weight_per_pack,
+                                [&formatter](const pack& p) { formatter.write_pack(p); });
+        for (const auto& i : items) {
+            packer.add_item(i);
+        }
+        packer.finish();
+        formatter.flush();
+        return output.str();
+    }
+};
+
+TEST_F(PipelinePlannerTest, RingPreservesOrderAcrossThreads) {
+    spsc_ring<int> ring(8);
+    EXPECT_EQ(ring.capacity(), 8);
+
+    const int count = 100000;
+    std::thread producer([&]() {
+        for (int i = 0; i < count; ++i) {
+            ring.push(i);
+        }
+        ring.close();
+    });
+
+    int expected = 0;
+    int value = -1;
+    while (ring.pop(value)) {
+        ASSERT_EQ(value, expected++);
+    }
+    producer.join();
+    EXPECT_EQ(expected, count);
+}
+
+TEST_F(PipelinePlannerTest, RingTryPushFailsWhenFull) {
+    spsc_ring<int> ring(2);
+    int value = 1;
+    EXPECT_TRUE(ring.try_push(value));
+    EXPECT_TRUE(ring.try_push(value));
+    EXPECT_FALSE(ring.try_push(value));
+
+    ring.close();
+    int out = 0;
+    EXPECT_TRUE(ring.pop(out));
+    EXPECT_TRUE(ring.pop(out));
+    EXPECT_FALSE(ring.pop(out));
+}
+
+TEST_F(PipelinePlannerTest, MatchesStreamingPacker) {
+    const std::string text = generate_lines(50000);
+    pack_planner_config config;
+    config.max_items_per_pack = 40;
+    config.max_weight_per_pack = 500.0;
+
+    // Small slices, batches and rings force many hand-offs
+    pipeline_planner pipeline(4096, 7, 2);
+    std::ostringstream output;
+    const pipeline_stats stats = pipeline.run(text.data(), text.size(), config, output);
+
+    EXPECT_EQ(stats.items, 50000);
+    EXPECT_GT(stats.packs, 1);
+    EXPECT_EQ(stats.unplaced_pieces, 0);
+    EXPECT_EQ(output.str(), reference_output(text, config));
+}
+
+TEST_F(PipelinePlannerTest, CountsUnplacedPieces) {
+    const std::string text = "NATURAL,40,20.0\n1,100,3,5.0\n2,100,4,50.0\n3,100,2,1.0\n";
+    pack_planner_config config;
+    config.max_items_per_pack = 40;
+    config.max_weight_per_pack = 20.0;
+
+    pipeline_planner pipeline;
+    std::ostringstream output;
+    const pipeline_stats stats = pipeline.run(text.data(), text.size(), config, output);
+
+    EXPECT_EQ(stats.pieces, 5);
+    EXPECT_EQ(stats.unplaced_pieces, 4);
+}
+
+TEST_F(PipelinePlannerTest, EmptyInput) {
+    pipeline_planner pipeline;
+    std::ostringstream output;
+    const pipeline_stats stats = pipeline.run(nullptr, 0, pack_planner_config{}, output);
+
+    EXPECT_EQ(stats.items, 0);
+    EXPECT_EQ(stats.packs, 0);
+    EXPECT_TRUE(output.str().empty());
+}
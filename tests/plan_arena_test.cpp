@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "binary_plan_file.h"
+#include "pack_planner.h"
+#include "parallel_output.h"
+#include "plan_arena.h"
+#include "test_support.h"
+
+// Plan Arena Tests
+class PlanArenaTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // Packs close on either limit, and there are enough of them for the
+        // parallel strategies to split the rows into several chunks
+        items = generate_test_items(6000, 10, 30.0);
+        config.max_items_per_pack = 40;
+        config.max_weight_per_pack = 500.0;
+        config.order = sort_order::LONG_TO_SHORT;
+    }
+
+    static std::string render(const pack_planner& planner, const auto& packs) {
+        std::ostringstream output;
+        planner.output_results(packs, output);
+        return output.str();
+    }
+
+    std::string read_file() const {
+        std::ifstream in(path, std::ios::binary);
+        return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    }
+
+    std::vector<item> items;
+    pack_planner_config config;
+    temp_file output{"plan_arena_test.out"};
+    const std::string& path = output.path();
+};
+
+TEST_F(PlanArenaTest, OpenPackFollowsPackRules) {
+    plan_arena arena;
+    pack reference(1);
+    arena.emplace_back(1);
+
+    EXPECT_TRUE(arena.back().is_empty());
+    EXPECT_EQ(arena.back().add_partial_item(7, 0, 30, 2.5, 20, 40.0),
+              reference.add_partial_item(7, 0, 30, 2.5, 20, 40.0));
+    EXPECT_EQ(arena.back().add_partial_item(8, 900, 5, 0.0, 20, 40.0),
+              reference.add_partial_item(8, 900, 5, 0.0, 20, 40.0));
+    EXPECT_EQ(arena.back().add_partial_item(9, 100, 5, 1.0, 20, 40.0), 0);
+
+    ASSERT_EQ(arena.size(), 1);
+    EXPECT_EQ(arena[0].get_total_items(), reference.get_total_items());
+    EXPECT_EQ(arena[0].get_pack_length(), 900);
+    EXPECT_EQ(arena[0].to_string(), reference.to_string());
+    EXPECT_EQ(arena.placements().size(), 2);
+}
+
+TEST_F(PlanArenaTest, AppendKeepsPlacementsContiguous) {
+    plan_arena first;
+    plan_arena second;
+    for (int n = 1; n <= 3; ++n) {
+        second.emplace_back(n);
+        for (int i = 0; i < n; ++i) {
+            (void)second.back().add_partial_item(n * 10 + i, 100 * n, 1, 1.0, 100, 100.0);
+        }
+    }
+    first.append(pack(9));
+    first.append(second, 1, 3);
+
+    ASSERT_EQ(first.size(), 3);
+    EXPECT_TRUE(first[0].is_empty());
+    EXPECT_EQ(first[1].to_string(), second[1].to_string());
+    EXPECT_EQ(first[2].to_string(), second[2].to_string());
+    EXPECT_EQ(first.packs()[2].first, 2);
+    EXPECT_EQ(first.placements().size(), 5);
+
+    size_t visited = 0;
+    for (const auto p : first) {
+        visited += p.get_items().size();
+    }
+    EXPECT_EQ(visited, first.placements().size());
+}
+
+TEST_F(PlanArenaTest, StrategiesFillArenaLikeVector) {
+    for (const auto type : {strategy_type::BLOCKING_FIRST_FIT, strategy_type::BLOCKING_NEXT_FIT,
+                            strategy_type::PARALLEL_FIRST_FIT, strategy_type::LOCKFREE_FIRST_FIT}) {
+        // One thread keeps the parallel strategies' pack order deterministic
+        config.type = type;
+        config.thread_count = 1;
+
+        pack_planner planner;
+        const auto result = planner.plan_packs(config, items);
+        plan_arena arena;
+        const auto arena_result = planner.plan_packs(config, item_columns(items), arena);
+
+        EXPECT_TRUE(arena_result.packs.empty());
+        EXPECT_EQ(arena_result.total_items, result.total_items);
+        EXPECT_DOUBLE_EQ(arena_result.utilization_percent, result.utilization_percent);
+        EXPECT_EQ(render(planner, arena), render(planner, result.packs));
+    }
+}
+
+TEST_F(PlanArenaTest, MultiThreadedStrategiesKeepEveryPack) {
+    for (const auto type : {strategy_type::PARALLEL_FIRST_FIT, strategy_type::LOCKFREE_FIRST_FIT}) {
+        config.type = type;
+        config.thread_count = 3;
+
+        pack_planner planner;
+        const auto result = planner.plan_packs(config, items);
+        plan_arena arena;
+        (void)planner.plan_packs(config, item_columns(items), arena);
+
+        size_t vector_packs = 0;
+        for (const auto& p : result.packs) vector_packs += p.is_empty() ? 0 : 1;
+        size_t arena_packs = 0;
+        for (const auto p : arena) arena_packs += p.is_empty() ? 0 : 1;
+        EXPECT_EQ(arena_packs, vector_packs);
+    }
+}
+
+TEST_F(PlanArenaTest, WritersAcceptArena) {
+    pack_planner planner;
+    plan_arena arena;
+    (void)planner.plan_packs(config, item_columns(items), arena);
+    const std::vector<pack> packs = arena.to_packs();
+
+    parallel_output writer(2);
+    ASSERT_TRUE(writer.write_arena_file(arena, path));
+    EXPECT_EQ(read_file(), render(planner, packs));
+
+    ASSERT_TRUE(binary_plan_file::write(path, arena));
+    binary_plan_file plan;
+    ASSERT_TRUE(plan.open(path));
+    size_t non_empty = 0;
+    for (const auto& p : packs) non_empty += p.is_empty() ? 0 : 1;
+    EXPECT_EQ(plan.packs().size(), non_empty);
+    EXPECT_EQ(plan.placements().size(), arena.placements().size());
+}
@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "binary_plan_file.h"
+#include "pack_planner.h"
+#include "plan_validator.h"
+
+// Plan Validator Tests
+class PlanValidatorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        for (int i = 0; i < 3000; ++i) {
+            items.emplace_back(1000 + i, 500 + i % 9500, 1 + i % 10, 0.5 + (i % 300) / 10.0);
+        }
+        config.max_items_per_pack = 40;
+        config.max_weight_per_pack = 500.0;
+        config.order = sort_order::SHORT_TO_LONG;
+    }
+
+    void TearDown() override {
+        std::remove(plan_path.c_str());
+    }
+
+    std::string render_plan() {
+        pack_planner planner;
+        result = planner.plan_packs(config, items);
+        std::ostringstream output;
+        planner.output_results(result.packs, output);
+        return output.str();
+    }
+
+    plan_validator make_validator(unsigned int threads = 4) {
+        plan_validator validator(config.max_items_per_pack, config.max_weight_per_pack, threads);
+        validator.set_items(items);
+        return validator;
+    }
+
+    static bool has_kind(const validation_report& report, violation_kind kind) {
+        for (const auto& v : report.violations) {
+            if (v.kind == kind) return true;
+        }
+        return false;
+    }
+
+    std::vector<item> items;
+    pack_planner_config config;
+    pack_planner_result result;
+    std::string plan_path = ::testing::TempDir() + "plan_validator_test.bin";
+};
+
+TEST_F(PlanValidatorTest, PlannerOutputIsValid) {
+    // An item heavier than a whole pack is dropped by the planner, and expected to be
+    items.emplace_back(99999, 100, 3, 600.0);
+    const std::string plan = render_plan();
+
+    plan_validator validator = make_validator();
+    const validation_report report = validator.validate_text(plan.data(), plan.size());
+
+    EXPECT_TRUE(report.ok()) << (report.violations.empty() ? "" : report.violations[0].to_string());
+    EXPECT_GT(report.packs, 1);
+    long long pieces = 0;
+    for (size_t i = 0; i + 1 < items.size(); ++i) pieces += items[i].get_quantity();
+    EXPECT_EQ(report.pieces, pieces);
+}
+
+TEST_F(PlanValidatorTest, SplitPacksStartsRangesAtHeaders) {
+    const std::string plan = render_plan();
+    const auto bounds = plan_validator::split_packs(plan.data(), plan.size(), 7);
+
+    ASSERT_GE(bounds.size(), 3);
+    EXPECT_EQ(bounds.front(), 0);
+    EXPECT_EQ(bounds.back(), plan.size());
+    for (size_t i = 1; i + 1 < bounds.size(); ++i) {
+        EXPECT_EQ(plan.compare(bounds[i], 13, "Pack Number: "), 0);
+    }
+}
+
+TEST_F(PlanValidatorTest, DetectsLimitAndTotalViolations) {
+    const std::string plan =
+        "Pack Number: 1\n1000,500,1,0.500\n1001,501,2,0.600\nPack Length: 400, Pack Weight: 9.99\n";
+    items.erase(items.begin() + 2, items.end());
+    config.max_items_per_pack = 2;
+    config.max_weight_per_pack = 1.0;
+
+    plan_validator validator = make_validator(1);
+    const validation_report report = validator.validate_text(plan.data(), plan.size());
+
+    EXPECT_FALSE(report.ok());
+    EXPECT_TRUE(has_kind(report, violation_kind::TOO_MANY_ITEMS));
+    EXPECT_TRUE(has_kind(report, violation_kind::TOO_HEAVY));
+    EXPECT_TRUE(has_kind(report, violation_kind::LENGTH_MISMATCH));
+    EXPECT_TRUE(has_kind(report, violation_kind::WEIGHT_MISMATCH));
+    EXPECT_EQ(report.violations.front().pack_number, 1);
+}
+
+TEST_F(PlanValidatorTest, DetectsMissingDuplicateAndUnknownPieces) {
+    std::string plan = render_plan();
+
+    // Place the first item line a second time and add an id the input does not have
+    const size_t first_line = plan.find('\n') + 1;
+    const std::string line = plan.substr(first_line, plan.find('\n', first_line) - first_line + 1);
+    const size_t footer = plan.find("Pack Length: ");
+    plan.insert(footer, line + "424242,1,1,1.000\n");
+    // Drop the last pack entirely
+    plan.erase(plan.rfind("Pack Number: "));
+
+    plan_validator validator = make_validator();
+    const validation_report report = validator.validate_text(plan.data(), plan.size());
+
+    EXPECT_TRUE(has_kind(report, violation_kind::EXTRA_PIECES));
+    EXPECT_TRUE(has_kind(report, violation_kind::MISSING_PIECES));
+    EXPECT_TRUE(has_kind(report, violation_kind::UNKNOWN_ITEM));
+    EXPECT_TRUE(has_kind(report, violation_kind::WEIGHT_MISMATCH));
+    // Item-level findings come after the pack-level ones
+    EXPECT_GE(report.violations.front().pack_number, 1);
+    EXPECT_EQ(report.violations.back().pack_number, -1);
+}
+
+TEST_F(PlanValidatorTest, ReportsMalformedLinesAndCapsList) {
+    const std::string plan = "garbage\nPack Number: 1\n1000,500,1\n";
+    items.erase(items.begin() + 1, items.end());
+
+    plan_validator validator(40, 500.0, 1, 2);
+    validator.set_items(items);
+    const validation_report report = validator.validate_text(plan.data(), plan.size());
+
+    EXPECT_GE(report.violation_count, 3);  // stray line, bad item line, missing footer, missing piece
+    EXPECT_EQ(report.violations.size(), 2);
+    EXPECT_EQ(report.violations[0].kind, violation_kind::MALFORMED);
+}
+
+TEST_F(PlanValidatorTest, ValidatesBinaryPlans) {
+    render_plan();
+    ASSERT_TRUE(binary_plan_file::write(plan_path, result));
+
+    plan_validator validator = make_validator();
+    validation_report report;
+    ASSERT_TRUE(validator.validate_file(plan_path, report));
+    EXPECT_TRUE(report.ok()) << (report.violations.empty() ? "" : report.violations[0].to_string());
+
+    // Validating against a tighter limit flags the packs
+    plan_validator strict(config.max_items_per_pack / 2, config.max_weight_per_pack, 2);
+    strict.set_items(items);
+    ASSERT_TRUE(strict.validate_file(plan_path, report));
+    EXPECT_TRUE(has_kind(report, violation_kind::TOO_MANY_ITEMS));
+}
+
+TEST_F(PlanValidatorTest, SparseIdsUseSortedIndex) {
+    for (auto& i : items) {
+        i = item(i.get_id() * 100003, i.get_length(), i.get_quantity(), i.get_weight());
+    }
+    const std::string plan = render_plan();
+
+    plan_validator validator = make_validator();
+    const validation_report report = validator.validate_text(plan.data(), plan.size());
+    EXPECT_TRUE(report.ok());
+}
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "pack_planner.h"
+#include "range_plan.h"
+#include "test_support.h"
+
+// Range Plan Tests
+class RangePlanTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // Up to 60 pieces against 40 per pack: many rows span two packs, so
+        // ranges often start part-way into a row
+        items = generate_test_items(3000, 60, 12.0);
+        // A run filling several packs in one step
+        items.emplace_back(4, 650, 500, 0.75);
+        // Rows the packing loops skip: no quantity, or heavier than a pack
+        items.emplace_back(1, 700, 0, 1.0);
+        items.emplace_back(2, 800, -3, 1.0);
+        items.emplace_back(3, 900, 4, 900.0);
+        config.max_items_per_pack = 40;
+        config.max_weight_per_pack = 500.0;
+        config.order = sort_order::LONG_TO_SHORT;
+    }
+
+    static std::string render(const pack_planner& planner, const auto& packs) {
+        std::ostringstream output;
+        planner.output_results(packs, output);
+        return output.str();
+    }
+
+    std::vector<item> items;
+    pack_planner_config config;
+};
+
+TEST_F(RangePlanTest, OpenRangeRecordsWhereThePackStarts) {
+    range_plan plan;
+    plan.set_weight_limit(10.0, weight_mode::FLOATING);
+    plan.emplace_back(1);
+
+    plan.visit_row(4, 12);
+    EXPECT_EQ(plan.back().add_partial_item(7, 300, 12, 1.0, 5, 10.0), 5);
+    plan.emplace_back(2);
+    EXPECT_TRUE(plan.back().is_empty());
+    EXPECT_EQ(plan.back().add_partial_item(7, 300, 7, 1.0, 5, 10.0), 5);
+
+    ASSERT_EQ(plan.size(), 2);
+    EXPECT_EQ(plan.ranges()[0].first_row, 4);
+    EXPECT_EQ(plan.ranges()[0].first_offset, 0);
+    EXPECT_EQ(plan.ranges()[1].first_row, 4);
+    EXPECT_EQ(plan.ranges()[1].first_offset, 5);
+    EXPECT_EQ(plan.ranges()[1].total_items, 5);
+    EXPECT_DOUBLE_EQ(plan.ranges()[1].total_weight, 5.0);
+    EXPECT_EQ(plan.ranges()[1].max_length, 300);
+}
+
+TEST_F(RangePlanTest, ExpandsToTheSameOutputAsVectorPlans) {
+    for (const auto type : {strategy_type::BLOCKING_FIRST_FIT, strategy_type::BLOCKING_NEXT_FIT}) {
+        for (const auto weights : {weight_mode::FLOATING, weight_mode::FIXED_POINT}) {
+            config.type = type;
+            config.weights = weights;
+            pack_planner planner;
+            const auto expected = planner.plan_packs(config, items);
+
+            item_columns columns(items);
+            range_plan plan;
+            const auto result = planner.plan_packs(config, columns, plan);
+            ASSERT_TRUE(result.has_value());
+            EXPECT_EQ(plan.size(), expected.packs.size());
+
+            const range_plan_view view(plan, columns.view());
+            EXPECT_EQ(render(planner, view), render(planner, expected.packs));
+            EXPECT_EQ(view[3].to_string(), expected.packs[3].to_string());
+            EXPECT_DOUBLE_EQ(result->utilization_percent, expected.utilization_percent);
+        }
+    }
+}
+
+TEST_F(RangePlanTest, ParallelRangesCoverEveryPlacedPiece) {
+    for (int i = 0; i < 20000; ++i) {
+        items.emplace_back(20000 + i, 100 + i % 900, 1 + i % 7, 1.0 + (i % 50) / 10.0);
+    }
+    config.thread_count = 4;
+    for (const auto type : {strategy_type::PARALLEL_FIRST_FIT, strategy_type::LOCKFREE_FIRST_FIT}) {
+        config.type = type;
+        pack_planner planner;
+        const auto expected = planner.plan_packs(config, items);
+        long long expected_pieces = 0;
+        for (const auto& p : expected.packs) {
+            expected_pieces += p.get_total_items();
+        }
+
+        item_columns columns(items);
+        range_plan plan;
+        ASSERT_TRUE(planner.plan_packs(config, columns, plan).has_value());
+
+        long long pieces = 0;
+        for (const auto p : range_plan_view(plan, columns.view())) {
+            std::int64_t expanded = 0;
+            for (const auto& i : p.get_items()) {
+                expanded += i.get_quantity();
+            }
+            EXPECT_EQ(expanded, p.get_total_items());
+            pieces += expanded;
+        }
+        EXPECT_EQ(pieces, expected_pieces);
+    }
+}
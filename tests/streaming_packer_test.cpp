@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "streaming_packer.h"
+#include "pack_planner.h"
+
+// Streaming Packer Tests
+class StreamingPackerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        items = {
+            item(1001, 6200, 30, 9.653),
+            item(2001, 7200, 50, 11.21),
+            item(3001, 100, 0, 1.0),      // skipped: no pieces
+            item(4001, 300, 5, 1000.0),   // skipped: heavier than any pack
+            item(5001, 800, 120, 0.5)
+        };
+    }
+
+    std::vector<item> items;
+};
+
+TEST_F(StreamingPackerTest, MatchesBlockingStrategy) {
+    pack_planner_config config;
+    config.order = sort_order::NATURAL;
+    config.max_items_per_pack = 40;
+    config.max_weight_per_pack = 500.0;
+    config.type = strategy_type::BLOCKING_FIRST_FIT;
+
+    pack_planner planner;
+    auto expected = planner.plan_packs(config, items);
+
+    std::vector<pack> streamed;
+    streaming_packer packer(config.max_items_per_pack, config.max_weight_per_pack,
+                            [&streamed](const pack& p) { streamed.push_back(p); });
+    for (const auto& i : items) {
+        packer.add_item(i);
+    }
+    packer.finish();
+
+    ASSERT_EQ(streamed.size(), expected.packs.size());
+    EXPECT_EQ(packer.get_emitted_packs(), streamed.size());
+    EXPECT_EQ(packer.get_total_items(), 200);
+    EXPECT_EQ(packer.get_unplaced_items(), 5);
+    EXPECT_EQ(packer.get_unplaced_items(), expected.unplaced_items);
+    for (size_t i = 0; i < streamed.size(); ++i) {
+        EXPECT_EQ(streamed[i].to_string(), expected.packs[i].to_string());
+    }
+}
+
+TEST_F(StreamingPackerTest, EmitsSealedPacksBeforeFinish) {
+    int emitted = 0;
+    streaming_packer packer(40, 500.0, [&emitted](const pack&) { ++emitted; });
+
+    packer.add_item(item(1001, 6200, 30, 9.653));
+    EXPECT_EQ(emitted, 0);  // first pack still open
+
+    packer.add_item(item(2001, 7200, 50, 11.21));
+    EXPECT_EQ(emitted, 1);  // pack 1 sealed when pack 2 opened
+
+    packer.finish();
+    EXPECT_EQ(emitted, 2);
+}
+
+TEST_F(StreamingPackerTest, ParseConfigHeader) {
+    pack_planner_config config;
+    config.type = strategy_type::BLOCKING_NEXT_FIT;
+
+    ASSERT_TRUE(parse_config_header("LONG_TO_SHORT,40,500.0\r", config));
+    EXPECT_EQ(config.order, sort_order::LONG_TO_SHORT);
+    EXPECT_EQ(config.max_items_per_pack, 40);
+    EXPECT_DOUBLE_EQ(config.max_weight_per_pack, 500.0);
+    EXPECT_EQ(config.type, strategy_type::BLOCKING_NEXT_FIT);
+
+    EXPECT_FALSE(parse_config_header("1001,6200,30,9.653", config));
+    EXPECT_FALSE(parse_config_header("SIDEWAYS,40,500.0", config));
+    EXPECT_FALSE(parse_config_header("NATURAL,40", config));
+    EXPECT_FALSE(parse_config_header("NATURAL,forty,500.0", config));
+}
+
+TEST_F(StreamingPackerTest, LongRunsMatchPerPackLoop) {
+    const std::vector<item> runs = {
+        item(1, 100, 1200, 0.3),   // weight-bound: 6 per pack
+        item(2, 50, 1, 1.5),       // joins the last, partly filled pack
+        item(3, 10, 2100, 0.0),    // item-bound: 7 per pack
+        item(4, 20, 99, 1.1)
+    };
+    const int max_items = 7;
+    const double max_weight = 2.0;
+
+    // Reference: one capacity check per pack
+    std::vector<pack> reference;
+    reference.emplace_back(1);
+    for (const auto& i : runs) {
+        std::int64_t remaining = i.get_quantity();
+        while (remaining > 0) {
+            const int added = reference.back().add_partial_item(
+                i.get_id(), i.get_length(), remaining, i.get_weight(), max_items, max_weight);
+            if (added > 0) {
+                remaining -= added;
+            } else {
+                reference.emplace_back(static_cast<int>(reference.size()) + 1);
+            }
+        }
+    }
+
+    std::vector<pack> streamed;
+    streaming_packer packer(max_items, max_weight,
+                            [&streamed](const pack& p) { streamed.push_back(p); });
+    for (const auto& i : runs) {
+        packer.add_item(i);
+    }
+    packer.finish();
+
+    ASSERT_EQ(streamed.size(), reference.size());
+    for (size_t i = 0; i < streamed.size(); ++i) {
+        EXPECT_EQ(streamed[i].to_string(), reference[i].to_string());
+    }
+
+    for (const auto type : {strategy_type::BLOCKING_FIRST_FIT, strategy_type::BLOCKING_NEXT_FIT}) {
+        pack_planner_config config;
+        config.order = sort_order::NATURAL;
+        config.max_items_per_pack = max_items;
+        config.max_weight_per_pack = max_weight;
+        config.type = type;
+
+        pack_planner planner;
+        const auto planned = planner.plan_packs(config, runs);
+        ASSERT_EQ(planned.packs.size(), reference.size());
+        for (size_t i = 0; i < reference.size(); ++i) {
+            EXPECT_EQ(planned.packs[i].to_string(), reference[i].to_string());
+        }
+
+        item_columns columns(runs);
+        range_plan ranges;
+        ASSERT_TRUE(planner.plan_packs(config, columns, ranges).has_value());
+        const range_plan_view view(ranges, columns.view());
+        ASSERT_EQ(view.size(), reference.size());
+        EXPECT_EQ(view[view.size() - 1].to_string(), reference.back().to_string());
+    }
+}
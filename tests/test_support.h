@@ -0,0 +1,57 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "item.h"
+
+/**
+ * @brief Generate reproducible random rows for tests
+ * Ids count up from 1000 in row order. Lengths, quantities and weights are
+ * drawn uniformly from [1, max_length], [1, max_quantity] and
+ * (0, max_weight] (in steps of max_weight / 1000), so the same arguments
+ * always give the same rows.
+ * @param count Number of rows
+ * @param max_quantity Largest quantity of a row
+ * @param max_weight Largest piece weight
+ * @param max_length Largest length
+ * @param seed Generator seed
+ * @return std::vector<item> The rows
+ */
+inline std::vector<item> generate_test_items(int count, std::int64_t max_quantity, double max_weight,
+                                             int max_length = 10000, unsigned seed = 42) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> length_dist(1, max_length);
+    std::uniform_int_distribution<std::int64_t> quantity_dist(1, max_quantity);
+    std::uniform_int_distribution<int> weight_dist(1, 1000);
+
+    std::vector<item> items;
+    items.reserve(static_cast<size_t>(count));
+    for (int i = 0; i < count; ++i) {
+        const int length = length_dist(gen);
+        const std::int64_t quantity = quantity_dist(gen);
+        items.emplace_back(1000 + i, length, quantity, max_weight * weight_dist(gen) / 1000.0);
+    }
+    return items;
+}
+
+/**
+ * @brief A path in the test temp directory, removed when it goes out of scope
+ */
+class temp_file {
+public:
+    explicit temp_file(const std::string& name) : m_path(::testing::TempDir() + name) {}
+    ~temp_file() { std::remove(m_path.c_str()); }
+
+    temp_file(const temp_file&) = delete;
+    temp_file& operator=(const temp_file&) = delete;
+
+    [[nodiscard]] const std::string& path() const noexcept { return m_path; }
+
+private:
+    std::string m_path;
+};